@@ -328,6 +328,7 @@ bool audio_dma_get_paused(audio_dma_t *dma) {
 
 void audio_dma_init(audio_dma_t *dma) {
     dma->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    dma->callback.priority = BACKGROUND_CALLBACK_PRIORITY_AUDIO;
 }
 
 void audio_dma_reset(void) {
@@ -18,6 +18,9 @@ CIRCUITPY_KEYPAD_DEMUX ?= 0
 
 ifeq ($(CHIP_FAMILY),samd21)
 
+# Architecture to compile frozen modules for with CIRCUITPY_FROZEN_NATIVE.
+MPY_CROSS_NATIVE_ARCH = armv6m
+
 # The ?='s allow overriding in mpconfigboard.mk.
 
 # Some of these are on by default with CIRCUITPY_FULL_BUILD, but don't
@@ -95,6 +98,8 @@ endif # samd21
 
 ifeq ($(CHIP_FAMILY),samd51)
 
+MPY_CROSS_NATIVE_ARCH = armv7emsp
+
 # No native touchio on SAMD51.
 CIRCUITPY_TOUCHIO_USE_NATIVE = 0
 
@@ -139,6 +144,8 @@ endif # samd51
 
 ifeq ($(CHIP_FAMILY),same51)
 
+MPY_CROSS_NATIVE_ARCH = armv7emsp
+
 # No native touchio on SAME51.
 CIRCUITPY_TOUCHIO_USE_NATIVE = 0
 
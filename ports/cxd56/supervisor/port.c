@@ -107,7 +107,7 @@ uint32_t port_get_saved_word(void) {
     return _ebss;
 }
 
-static background_callback_t callback;
+static background_callback_t callback = { .priority = BACKGROUND_CALLBACK_PRIORITY_USB };
 static void usb_background_do(void *unused) {
     usb_background();
 }
@@ -136,6 +136,7 @@ void port_i2s_allocate_init(i2s_t *self, bool left_justified) {
         .on_send_q_ovf = NULL,
     };
     i2s_channel_register_event_callback(self->handle, &callbacks, self);
+    self->callback.priority = BACKGROUND_CALLBACK_PRIORITY_AUDIO;
 }
 
 void port_i2s_deinit(i2s_t *self) {
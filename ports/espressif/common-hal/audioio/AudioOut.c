@@ -491,6 +491,7 @@ void common_hal_audioio_audioout_construct(audioio_audioout_obj_t *self,
     self->playing = false;
     self->paused = false;
     self->freq_hz = DEFAULT_SAMPLE_RATE;
+    self->callback.priority = BACKGROUND_CALLBACK_PRIORITY_AUDIO;
 
     /* espressif has two dac channels and it can support true stereo or
      * outputting the same signal to both channels (dual mono).
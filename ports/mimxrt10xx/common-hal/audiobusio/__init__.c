@@ -314,6 +314,7 @@ void port_i2s_initialize(i2s_t *self, int instance, sai_transceiver_t *config) {
     self->peripheral = peripheral;
     SAI_Init(self->peripheral);
     SAI_TransferTxCreateHandle(peripheral, &self->handle, i2s_transfer_callback, (void *)self);
+    self->callback.priority = BACKGROUND_CALLBACK_PRIORITY_AUDIO;
     SAI_TransferTxSetConfig(peripheral, &self->handle, config);
     self->sample_rate = 0;
     i2s_in_use |= (1 << instance);
@@ -12,6 +12,9 @@ USB_NUM_ENDPOINT_PAIRS = 8
 # All nRF ports have longints.
 LONGINT_IMPL = MPZ
 
+# Architecture to compile frozen modules for with CIRCUITPY_FROZEN_NATIVE.
+MPY_CROSS_NATIVE_ARCH = armv7emsp
+
 # The ?='s allow overriding in mpconfigboard.mk.
 
 # Audio via PWM
@@ -436,6 +436,8 @@ void audio_dma_init(audio_dma_t *dma) {
 
     dma->channel[0] = NUM_DMA_CHANNELS;
     dma->channel[1] = NUM_DMA_CHANNELS;
+
+    dma->callback.priority = BACKGROUND_CALLBACK_PRIORITY_AUDIO;
 }
 
 void audio_dma_deinit(audio_dma_t *dma) {
@@ -47,6 +47,9 @@ CIRCUITPY_AUDIOPWMIO ?= 1
 CIRCUITPY_AUDIOMIXER ?= 1
 
 ifeq ($(CHIP_VARIANT),RP2040)
+# Architecture to compile frozen modules for with CIRCUITPY_FROZEN_NATIVE.
+MPY_CROSS_NATIVE_ARCH = armv6m
+
 CIRCUITPY_ALARM ?= 1
 
 # Default PICODVI off because it uses RAM to store code run on the second CPU for RP2040.
@@ -59,6 +62,8 @@ CIRCUITPY_CYW43_INIT_DELAY ?= 1000
 endif
 
 ifeq ($(CHIP_VARIANT),RP2350)
+MPY_CROSS_NATIVE_ARCH = armv7emsp
+
 # This needs to be implemented.
 CIRCUITPY_ALARM = 0
 # Default PICODVI on because it doesn't require much code in RAM to talk to HSTX.
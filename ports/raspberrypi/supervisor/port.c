@@ -33,6 +33,10 @@
 #include "common-hal/rtc/RTC.h"
 #include "common-hal/busio/UART.h"
 
+#if CIRCUITPY_KEYPAD
+#include "shared-module/keypad/__init__.h"
+#endif
+
 #include "supervisor/shared/safe_mode.h"
 #include "supervisor/shared/stack.h"
 #include "supervisor/shared/tick.h"
@@ -497,6 +501,47 @@ void port_disable_tick(void) {
     ticks_enabled = false;
 }
 
+#if CIRCUITPY_KEYPAD
+static int keypad_alarm = -1;
+static uint32_t keypad_interval_us;
+static absolute_time_t keypad_next_scan;
+
+static void _keypad_timer_callback(uint alarm_num) {
+    keypad_tick();
+    keypad_next_scan = delayed_by_us(keypad_next_scan, keypad_interval_us);
+    // Start over from now if scanning fell behind rather than firing back to back.
+    if (hardware_alarm_set_target(alarm_num, keypad_next_scan)) {
+        keypad_next_scan = delayed_by_us(get_absolute_time(), keypad_interval_us);
+        hardware_alarm_set_target(alarm_num, keypad_next_scan);
+    }
+}
+
+// Scan keypads from a spare hardware alarm when they need it more often than the tick.
+bool port_keypad_timer_start(uint32_t interval_us) {
+    if (keypad_alarm < 0) {
+        keypad_alarm = hardware_alarm_claim_unused(false);
+        if (keypad_alarm < 0) {
+            return false;
+        }
+        hardware_alarm_set_callback(keypad_alarm, _keypad_timer_callback);
+    }
+    keypad_interval_us = interval_us;
+    keypad_next_scan = delayed_by_us(get_absolute_time(), interval_us);
+    hardware_alarm_set_target(keypad_alarm, keypad_next_scan);
+    return true;
+}
+
+void port_keypad_timer_stop(void) {
+    if (keypad_alarm < 0) {
+        return;
+    }
+    hardware_alarm_cancel(keypad_alarm);
+    hardware_alarm_set_callback(keypad_alarm, NULL);
+    hardware_alarm_unclaim(keypad_alarm);
+    keypad_alarm = -1;
+}
+#endif
+
 // This is called by sleep, we ignore it when our ticks are enabled because
 // they'll wake us up earlier. If we don't, we'll mess up ticks by overwriting
 // the next RTC wake up time.
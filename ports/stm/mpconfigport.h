@@ -34,6 +34,12 @@ extern uint8_t _ld_default_stack_size;
 #define BOARD_NO_USB_OTG_ID_SENSE (0)
 #endif
 
+// audiopwmio.PWMAudioOut takes samples from a timer interrupt, which can't
+// wait for a background read of the same file, so samples don't read ahead.
+#if CIRCUITPY_AUDIOPWMIO
+#define CIRCUITPY_AUDIOCORE_READ_AHEAD_MAX (0)
+#endif
+
 // Peripheral implementation counts
 #define MAX_UART 10
 #define MAX_I2C 4
@@ -1,6 +1,9 @@
+#include <pthread.h>
+#include <sched.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include "py/obj.h"
 #include "py/objfun.h"
@@ -17,6 +20,17 @@
 #include "py/stream.h"
 #include "py/binary.h"
 #include "py/bc.h"
+// CIRCUITPY-CHANGE: test the keypad event queue
+#include "py/mphal.h"
+#include "shared-bindings/keypad/EventQueue.h"
+#include "shared-module/keypad/__init__.h"
+#include "shared-bindings/supervisor/__init__.h"
+#include "supervisor/background_callback.h"
+#include "supervisor/port.h"
+#include "supervisor/port_heap.h"
+#include "supervisor/shared/external_flash/sector_cache.h"
+#include "supervisor/shared/spsc_ring.h"
+#include "supervisor/shared/tick.h"
 
 // expected output of this file is found in extra_coverage.py.exp
 
@@ -182,6 +196,270 @@ static void pairheap_test(size_t nops, int *ops) {
     mp_printf(&mp_plat_print, "\n");
 }
 
+// CIRCUITPY-CHANGE: keypad.Event() uses supervisor.ticks_ms() for its default timestamp.
+mp_obj_t supervisor_ticks_ms(void) {
+    return mp_obj_new_int((mp_hal_ticks_ms() + 0x1fff0000) % (1 << 29));
+}
+
+// CIRCUITPY-CHANGE: the flash sector cache allocates from the port heap.
+static int port_heap_test_allocations;
+
+void *port_malloc(size_t size, bool dma_capable) {
+    (void)dma_capable;
+    port_heap_test_allocations++;
+    return malloc(size);
+}
+
+void port_free(void *ptr) {
+    port_heap_test_allocations--;
+    free(ptr);
+}
+
+// CIRCUITPY-CHANGE: a simulated NOR flash that counts erases and page programs,
+// and catches programming bits back to 1 without an erase.
+#define FLASH_TEST_SECTORS (16)
+static uint8_t flash_test_data[FLASH_TEST_SECTORS * SPI_FLASH_ERASE_SIZE];
+static int flash_test_erases;
+static int flash_test_programs;
+static int flash_test_errors;
+static bool flash_test_program_fails;
+
+static bool flash_test_read(uint32_t address, uint8_t *data, uint32_t data_length) {
+    memcpy(data, flash_test_data + address, data_length);
+    return true;
+}
+
+static bool flash_test_program(uint32_t address, const uint8_t *data, uint32_t data_length) {
+    if (flash_test_program_fails) {
+        return false;
+    }
+    for (uint32_t i = 0; i < data_length; i++) {
+        if ((flash_test_data[address + i] & data[i]) != data[i]) {
+            flash_test_errors++;
+        }
+        flash_test_data[address + i] &= data[i];
+    }
+    flash_test_programs += (data_length + SPI_FLASH_PAGE_SIZE - 1) / SPI_FLASH_PAGE_SIZE;
+    return true;
+}
+
+static bool flash_test_erase_sector(uint32_t sector_address) {
+    memset(flash_test_data + sector_address, 0xff, SPI_FLASH_ERASE_SIZE);
+    flash_test_erases++;
+    return true;
+}
+
+static bool flash_test_block_erased(uint32_t address) {
+    for (uint32_t i = 0; i < FILESYSTEM_BLOCK_SIZE; i++) {
+        if (flash_test_data[address + i] != 0xff) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static const flash_sector_cache_ops_t flash_test_ops = {
+    .read = flash_test_read,
+    .program = flash_test_program,
+    .erase_sector = flash_test_erase_sector,
+    .block_erased = flash_test_block_erased,
+};
+
+// CIRCUITPY-CHANGE: the supervisor hooks that keypad scanning uses. The raw
+// tick count is a fake clock that the keypad test moves forward itself.
+static uint64_t keypad_test_subticks;
+static int keypad_test_ticks_enabled;
+static bool keypad_test_timer_available;
+static uint32_t keypad_test_timer_us;
+
+uint64_t port_get_raw_ticks(uint8_t *subticks) {
+    if (subticks != NULL) {
+        *subticks = keypad_test_subticks % 32;
+    }
+    return keypad_test_subticks / 32;
+}
+
+void supervisor_enable_tick(void) {
+    keypad_test_ticks_enabled++;
+}
+
+void supervisor_disable_tick(void) {
+    keypad_test_ticks_enabled--;
+}
+
+bool port_keypad_timer_start(uint32_t interval_us) {
+    if (!keypad_test_timer_available) {
+        return false;
+    }
+    keypad_test_timer_us = interval_us;
+    return true;
+}
+
+void port_keypad_timer_stop(void) {
+    keypad_test_timer_us = 0;
+}
+
+// Only the thread calling keypad_tick() takes the lock while another thread
+// could, so it doesn't need to be atomic.
+void supervisor_acquire_lock(supervisor_lock_t *lock) {
+    *lock = true;
+}
+
+bool supervisor_try_lock(supervisor_lock_t *lock) {
+    if (*lock) {
+        return false;
+    }
+    *lock = true;
+    return true;
+}
+
+void supervisor_release_lock(supervisor_lock_t *lock) {
+    *lock = false;
+}
+
+// A scanner whose keys are whatever `pressed` holds when it is scanned.
+typedef struct {
+    KEYPAD_SCANNER_COMMON_FIELDS;
+    bool *pressed;
+    size_t key_count;
+    int scans;
+} keypad_test_scanner_obj_t;
+
+static void keypad_test_scan_now(void *self_in, mp_obj_t timestamp) {
+    keypad_test_scanner_obj_t *self = self_in;
+    self->scans++;
+    for (size_t key = 0; key < self->key_count; key++) {
+        if (keypad_debounce((keypad_scanner_obj_t *)self, key, self->pressed[key])) {
+            keypad_eventqueue_record(self->events, key, self->pressed[key], timestamp);
+        }
+    }
+}
+
+static size_t keypad_test_get_key_count(void *self_in) {
+    keypad_test_scanner_obj_t *self = self_in;
+    return self->key_count;
+}
+
+static keypad_scanner_funcs_t keypad_test_funcs = {
+    .scan_now = keypad_test_scan_now,
+    .get_key_count = keypad_test_get_key_count,
+};
+
+static keypad_test_scanner_obj_t *keypad_test_scanner_new(bool *pressed, size_t key_count, mp_float_t interval, size_t max_events, uint8_t debounce_threshold) {
+    keypad_test_scanner_obj_t *self = mp_obj_malloc(keypad_test_scanner_obj_t, &mp_type_object);
+    self->funcs = &keypad_test_funcs;
+    self->pressed = pressed;
+    self->key_count = key_count;
+    self->scans = 0;
+    keypad_construct_common((keypad_scanner_obj_t *)self, interval, max_events, debounce_threshold);
+    return self;
+}
+
+// Moves the fake clock on and runs the tick, as the tick or scan timer interrupt would.
+static void keypad_test_advance(uint32_t subticks) {
+    keypad_test_subticks += subticks;
+    keypad_tick();
+}
+
+static void keypad_test_print_events(keypad_eventqueue_obj_t *queue) {
+    uint16_t events[8];
+    mp_buffer_info_t events_buf = {.buf = events, .len = sizeof(events), .typecode = 'H'};
+    size_t n = common_hal_keypad_eventqueue_get_into_array(queue, &events_buf, NULL);
+    mp_printf(&mp_plat_print, "events");
+    for (size_t i = 0; i < n; i++) {
+        mp_printf(&mp_plat_print, " %04x", events[i]);
+    }
+    mp_printf(&mp_plat_print, "\n");
+}
+
+// A simulated key matrix whose keys change from scan to scan.
+#define KEYPAD_TEST_KEYS (120)
+#define KEYPAD_TEST_SCANS (2000)
+
+static bool keypad_test_toggles(uint32_t scan, uint32_t key) {
+    return (scan * 7 + key * 13) % 61 == 0;
+}
+
+typedef struct {
+    uint32_t scan;
+    uint32_t key;
+    bool pressed[KEYPAD_TEST_KEYS];
+} keypad_test_matrix_t;
+
+// Steps through the matrix to the next key that changes and returns its
+// encoded event, or -1 once all the scans are done.
+static int keypad_test_next(keypad_test_matrix_t *m) {
+    while (m->scan < KEYPAD_TEST_SCANS) {
+        uint32_t scan = m->scan;
+        uint32_t key = m->key++;
+        if (m->key == KEYPAD_TEST_KEYS) {
+            m->key = 0;
+            m->scan++;
+        }
+        if (keypad_test_toggles(scan, key)) {
+            m->pressed[key] = !m->pressed[key];
+            return key | (m->pressed[key] ? 0x8000 : 0);
+        }
+    }
+    return -1;
+}
+
+// Stands in for a timer interrupt: changes the keys, then ticks once per scan interval.
+static void *keypad_test_timer(void *arg) {
+    keypad_test_scanner_obj_t *scanner = arg;
+    for (uint32_t scan = 0; scan < KEYPAD_TEST_SCANS; scan++) {
+        for (uint32_t key = 0; key < KEYPAD_TEST_KEYS; key++) {
+            if (keypad_test_toggles(scan, key)) {
+                scanner->pressed[key] = !scanner->pressed[key];
+            }
+        }
+        // Wait for the reader rather than dropping events so that every one
+        // can be checked. At most two keys change in a scan.
+        while (common_hal_keypad_eventqueue_get_length(scanner->events) > 30) {
+            sched_yield();
+        }
+        keypad_test_advance(scanner->interval_subticks);
+        if (scan % 16 == 0) {
+            usleep(100);
+        }
+    }
+    return NULL;
+}
+
+// CIRCUITPY-CHANGE: background callbacks that print their name and take `run`
+// ticks of the fake clock. Statistics are kept per function, so each priority
+// gets its own.
+void port_background_task(void) {
+}
+
+typedef struct {
+    background_callback_t cb;
+    char name;
+    uint32_t run;
+    bool again;
+} background_test_callback_t;
+
+static void background_test_run(background_test_callback_t *self, background_callback_fun fun) {
+    mp_printf(&mp_plat_print, "%c", self->name);
+    keypad_test_subticks += self->run;
+    if (self->again) {
+        self->again = false;
+        background_callback_add(&self->cb, fun, self);
+    }
+}
+
+static void background_test_audio(void *data) {
+    background_test_run(data, background_test_audio);
+}
+
+static void background_test_default(void *data) {
+    background_test_run(data, background_test_default);
+}
+
+static void background_test_web(void *data) {
+    background_test_run(data, background_test_web);
+}
+
 // function to run extra tests for things that can't be checked by scripts
 static mp_obj_t extra_coverage(void) {
     // mp_printf (used by ports that don't have a native printf)
@@ -683,6 +961,63 @@ static mp_obj_t extra_coverage(void) {
         mp_printf(&mp_plat_print, "%d\n", ringbuf_get16(&ringbuf));
     }
 
+    // CIRCUITPY-CHANGE: single-producer, single-consumer ring
+    {
+        mp_printf(&mp_plat_print, "# spsc_ring\n");
+        uint8_t buf[8];
+        spsc_ring_t ring;
+        mp_printf(&mp_plat_print, "%d %d\n", spsc_ring_init(&ring, buf, 6), spsc_ring_init(&ring, buf, sizeof(buf)));
+
+        // Empty.
+        uint8_t data[16];
+        const uint8_t *read_span;
+        uint8_t *write_span;
+        mp_printf(&mp_plat_print, "%d %d %d %d\n", (int)spsc_ring_num_filled(&ring), (int)spsc_ring_num_empty(&ring),
+            (int)spsc_ring_read_span(&ring, &read_span), (int)spsc_ring_read(&ring, data, sizeof(data)));
+
+        // Full: only what fits is written.
+        for (int i = 0; i < 16; i++) {
+            data[i] = i;
+        }
+        mp_printf(&mp_plat_print, "%d\n", (int)spsc_ring_write(&ring, data, 5));
+        mp_printf(&mp_plat_print, "%d\n", (int)spsc_ring_write(&ring, data + 5, 5));
+        mp_printf(&mp_plat_print, "%d %d %d\n", (int)spsc_ring_num_filled(&ring), (int)spsc_ring_num_empty(&ring),
+            (int)spsc_ring_write_span(&ring, &write_span));
+
+        // Spans stop at the end of the storage and carry on from the start.
+        uint8_t out[16];
+        size_t n;
+        mp_printf(&mp_plat_print, "%d\n", (int)spsc_ring_read(&ring, out, 6));
+        mp_printf(&mp_plat_print, "%d\n", (int)spsc_ring_write(&ring, data + 8, 5));
+        n = spsc_ring_write_span(&ring, &write_span);
+        mp_printf(&mp_plat_print, "%d %d\n", (int)n, (int)(write_span - buf));
+        n = spsc_ring_read_span(&ring, &read_span);
+        mp_printf(&mp_plat_print, "%d %d\n", (int)n, (int)(read_span - buf));
+        spsc_ring_commit_read(&ring, 2);
+        n = spsc_ring_read_span(&ring, &read_span);
+        mp_printf(&mp_plat_print, "%d %d\n", (int)n, (int)(read_span - buf));
+        n = spsc_ring_read(&ring, out, sizeof(out));
+        for (size_t i = 0; i < n; i++) {
+            mp_printf(&mp_plat_print, "%d ", out[i]);
+        }
+        mp_printf(&mp_plat_print, "\n%d %d\n", (int)spsc_ring_num_filled(&ring), (int)spsc_ring_num_empty(&ring));
+
+        // The indices wrap around 2**32 without losing track of what is filled.
+        ring.write_index = ring.read_index = 0xfffffffd;
+        n = spsc_ring_write(&ring, data, 8);
+        mp_printf(&mp_plat_print, "%d %d\n", (int)n, (int)spsc_ring_num_filled(&ring));
+        n = spsc_ring_read(&ring, out, sizeof(out));
+        for (size_t i = 0; i < n; i++) {
+            mp_printf(&mp_plat_print, "%d ", out[i]);
+        }
+        mp_printf(&mp_plat_print, "\n%d\n", (int)spsc_ring_num_empty(&ring));
+
+        // Clearing drops everything.
+        spsc_ring_write(&ring, data, 3);
+        spsc_ring_clear(&ring);
+        mp_printf(&mp_plat_print, "%d %d\n", (int)spsc_ring_num_filled(&ring), (int)spsc_ring_num_empty(&ring));
+    }
+
     // pairheap
     {
         mp_printf(&mp_plat_print, "# pairheap\n");
@@ -729,6 +1064,214 @@ static mp_obj_t extra_coverage(void) {
         mp_printf(&mp_plat_print, "%d %d\n", mp_obj_is_int(MP_OBJ_NEW_SMALL_INT(1)), mp_obj_is_int(mp_obj_new_int_from_ll(1)));
     }
 
+    // CIRCUITPY-CHANGE: keypad event queue
+    {
+        mp_printf(&mp_plat_print, "# keypad\n");
+
+        keypad_eventqueue_obj_t *queue = mp_obj_malloc(keypad_eventqueue_obj_t, &keypad_eventqueue_type);
+        common_hal_keypad_eventqueue_construct(queue, 3);
+        for (int i = 0; i < 4; i++) {
+            mp_printf(&mp_plat_print, "%d\n", keypad_eventqueue_record(queue, i, i & 1, MP_OBJ_NEW_SMALL_INT(100 + i)));
+        }
+        mp_printf(&mp_plat_print, "%d %d\n", (int)common_hal_keypad_eventqueue_get_length(queue), common_hal_keypad_eventqueue_get_overflowed(queue));
+
+        // The shorter buffer limits how many events are moved.
+        uint16_t events[16];
+        uint32_t timestamps[16];
+        mp_buffer_info_t events_buf = {.buf = events, .len = 2 * sizeof(uint16_t), .typecode = 'H'};
+        mp_buffer_info_t timestamps_buf = {.buf = timestamps, .len = sizeof(timestamps), .typecode = 'I'};
+        size_t n = common_hal_keypad_eventqueue_get_into_array(queue, &events_buf, &timestamps_buf);
+        for (size_t i = 0; i < n; i++) {
+            mp_printf(&mp_plat_print, "%04x %d\n", events[i], (int)timestamps[i]);
+        }
+        mp_printf(&mp_plat_print, "%d\n", (int)common_hal_keypad_eventqueue_get_length(queue));
+        common_hal_keypad_eventqueue_clear(queue);
+        mp_printf(&mp_plat_print, "%d %d\n", (int)common_hal_keypad_eventqueue_get_length(queue), common_hal_keypad_eventqueue_get_overflowed(queue));
+
+        // A scanner is scanned by keypad_tick() once its interval has passed,
+        // and its keys are debounced. An interval of 1/32 s is 1024 subticks.
+        bool pressed[3] = {false};
+        keypad_test_scanner_obj_t *slow = keypad_test_scanner_new(pressed, 3, MICROPY_FLOAT_CONST(1.0) / 32, 8, 2);
+        mp_printf(&mp_plat_print, "%d %d %d\n", slow->scans, keypad_test_ticks_enabled, (int)keypad_test_timer_us);
+        keypad_test_advance(1022);
+        mp_printf(&mp_plat_print, "%d\n", slow->scans);
+        keypad_test_advance(1);
+        mp_printf(&mp_plat_print, "%d\n", slow->scans);
+        pressed[1] = true;
+        for (int i = 0; i < 3; i++) {
+            keypad_test_advance(1024);
+            keypad_test_print_events(slow->events);
+        }
+        // A missed interval isn't made up for with scans back to back.
+        pressed[1] = false;
+        pressed[2] = true;
+        keypad_test_advance(10 * 1024);
+        keypad_test_advance(1);
+        mp_printf(&mp_plat_print, "%d %d\n", slow->scans, (int)(slow->next_scan_subticks - keypad_test_subticks));
+        keypad_test_advance(1023);
+        keypad_test_print_events(slow->events);
+
+        // A scanner with an interval shorter than a tick asks the port for a
+        // scan timer, unless the port has none.
+        bool fast_pressed[1] = {false};
+        keypad_test_scanner_obj_t *fast = keypad_test_scanner_new(fast_pressed, 1, MICROPY_FLOAT_CONST(0.0005), 4, 1);
+        mp_printf(&mp_plat_print, "%d %d\n", keypad_test_ticks_enabled, (int)keypad_test_timer_us);
+        keypad_deregister_scanner((keypad_scanner_obj_t *)fast);
+        keypad_test_timer_available = true;
+        keypad_register_scanner((keypad_scanner_obj_t *)fast);
+        mp_printf(&mp_plat_print, "%d %d\n", keypad_test_ticks_enabled, (int)keypad_test_timer_us);
+        int fast_scans = fast->scans;
+        int slow_scans = slow->scans;
+        for (int i = 0; i < 64; i++) {
+            keypad_test_advance(16);
+        }
+        mp_printf(&mp_plat_print, "%d %d\n", fast->scans - fast_scans, slow->scans - slow_scans);
+        keypad_deregister_scanner((keypad_scanner_obj_t *)fast);
+        keypad_deregister_scanner((keypad_scanner_obj_t *)slow);
+        mp_printf(&mp_plat_print, "%d %d\n", keypad_test_ticks_enabled, (int)keypad_test_timer_us);
+        keypad_test_timer_available = false;
+
+        // A timer thread ticks through the scans of a matrix while this thread
+        // drains the queue in batches.
+        bool matrix_pressed[KEYPAD_TEST_KEYS] = {false};
+        keypad_test_scanner_obj_t *scanner = keypad_test_scanner_new(matrix_pressed, KEYPAD_TEST_KEYS, MICROPY_FLOAT_CONST(0.001), 32, 1);
+        pthread_t timer;
+        pthread_create(&timer, NULL, keypad_test_timer, scanner);
+        keypad_test_matrix_t matrix = {0};
+        events_buf.len = sizeof(events);
+        int expected;
+        int received = 0;
+        int errors = 0;
+        while ((expected = keypad_test_next(&matrix)) >= 0) {
+            while ((n = common_hal_keypad_eventqueue_get_into_array(scanner->events, &events_buf, NULL)) == 0) {
+                sched_yield();
+            }
+            for (size_t i = 0; i < n; i++) {
+                if (i > 0) {
+                    expected = keypad_test_next(&matrix);
+                }
+                if (events[i] != expected) {
+                    errors++;
+                }
+                received++;
+            }
+        }
+        pthread_join(timer, NULL);
+        keypad_deregister_scanner((keypad_scanner_obj_t *)scanner);
+        mp_printf(&mp_plat_print, "%d %d %d %d\n", received, errors, (int)common_hal_keypad_eventqueue_get_length(scanner->events), common_hal_keypad_eventqueue_get_overflowed(scanner->events));
+    }
+
+    // CIRCUITPY-CHANGE: external flash sector cache
+    {
+        mp_printf(&mp_plat_print, "# flash sector cache\n");
+        static uint8_t expected[sizeof(flash_test_data)];
+        memset(flash_test_data, 0x5a, sizeof(flash_test_data));
+        memcpy(expected, flash_test_data, sizeof(expected));
+        flash_sector_cache_t *cache = malloc(sizeof(flash_sector_cache_t));
+        flash_sector_cache_init(cache, &flash_test_ops);
+        mp_printf(&mp_plat_print, "%d\n", flash_sector_cache_allocate(cache));
+
+        // A FAT-like workload: each data block written is followed by an
+        // update to the FAT (sector 0) and the directory entry (sector 1).
+        uint8_t block[FILESYSTEM_BLOCK_SIZE];
+        uint32_t data_start = 2 * SPI_FLASH_ERASE_SIZE;
+        uint32_t data_blocks = 8 * FLASH_SECTOR_CACHE_BLOCKS_PER_SECTOR;
+        for (uint32_t i = 0; i < data_blocks; i++) {
+            uint32_t writes[] = {data_start + i * FILESYSTEM_BLOCK_SIZE, FILESYSTEM_BLOCK_SIZE, SPI_FLASH_ERASE_SIZE};
+            for (size_t w = 0; w < MP_ARRAY_SIZE(writes); w++) {
+                memset(block, i * 3 + w, sizeof(block));
+                flash_sector_cache_write_block(cache, writes[w], block);
+                memcpy(expected + writes[w], block, sizeof(block));
+            }
+        }
+        // Reads see cached blocks before they are written back.
+        uint8_t readback[FILESYSTEM_BLOCK_SIZE];
+        bool cached = flash_sector_cache_read_block(cache, FILESYSTEM_BLOCK_SIZE, readback);
+        mp_printf(&mp_plat_print, "%d %d\n", cached, memcmp(readback, expected + FILESYSTEM_BLOCK_SIZE, sizeof(readback)) == 0);
+        mp_printf(&mp_plat_print, "%d\n", flash_sector_cache_read_block(cache, 0, readback));
+        mp_printf(&mp_plat_print, "%d\n", flash_sector_cache_flush(cache));
+        mp_printf(&mp_plat_print, "%d %d %d\n", flash_test_erases, flash_test_programs, flash_test_errors);
+        mp_printf(&mp_plat_print, "%d\n", memcmp(flash_test_data, expected, sizeof(expected)) == 0);
+
+        // Blocks that are already erased are programmed directly.
+        flash_test_erase_sector(15 * SPI_FLASH_ERASE_SIZE);
+        memset(expected + 15 * SPI_FLASH_ERASE_SIZE, 0xff, SPI_FLASH_ERASE_SIZE);
+        flash_test_erases = flash_test_programs = 0;
+        memset(block, 0x42, sizeof(block));
+        flash_sector_cache_write_block(cache, 15 * SPI_FLASH_ERASE_SIZE, block);
+        memcpy(expected + 15 * SPI_FLASH_ERASE_SIZE, block, sizeof(block));
+        mp_printf(&mp_plat_print, "%d %d\n", flash_sector_cache_read_block(cache, 15 * SPI_FLASH_ERASE_SIZE, readback), flash_test_programs);
+
+        // Releasing writes back and frees everything.
+        flash_sector_cache_write_block(cache, 0, block);
+        memcpy(expected, block, sizeof(block));
+        bool released = flash_sector_cache_release(cache);
+        mp_printf(&mp_plat_print, "%d %d\n", released, port_heap_test_allocations);
+        mp_printf(&mp_plat_print, "%d %d\n", flash_test_erases, memcmp(flash_test_data, expected, sizeof(expected)) == 0);
+
+        // A sector that can't be written back stays cached, with all of its
+        // blocks in RAM, and the write that needed its way fails. Once the
+        // flash works again the whole sector is written.
+        flash_sector_cache_allocate(cache);
+        for (uint32_t sector = 2; sector < 2 + CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; sector++) {
+            memset(block, sector, sizeof(block));
+            flash_sector_cache_write_block(cache, sector * SPI_FLASH_ERASE_SIZE, block);
+            memcpy(expected + sector * SPI_FLASH_ERASE_SIZE, block, sizeof(block));
+        }
+        flash_test_program_fails = true;
+        uint32_t evicted = 2 * SPI_FLASH_ERASE_SIZE;
+        bool written = flash_sector_cache_write_block(cache, 8 * SPI_FLASH_ERASE_SIZE, block);
+        cached = flash_sector_cache_read_block(cache, evicted + FILESYSTEM_BLOCK_SIZE, readback);
+        mp_printf(&mp_plat_print, "%d %d %d %d\n", written, flash_test_data[evicted] == 0xff, cached,
+            memcmp(readback, expected + evicted + FILESYSTEM_BLOCK_SIZE, sizeof(readback)) == 0);
+        mp_printf(&mp_plat_print, "%d\n", flash_sector_cache_flush(cache));
+        flash_test_program_fails = false;
+        mp_printf(&mp_plat_print, "%d\n", flash_sector_cache_release(cache));
+        mp_printf(&mp_plat_print, "%d %d\n", port_heap_test_allocations, memcmp(flash_test_data, expected, sizeof(expected)) == 0);
+        free(cache);
+    }
+
+    // CIRCUITPY-CHANGE: background callback priorities and statistics
+    {
+        mp_printf(&mp_plat_print, "# background callbacks\n");
+        static background_test_callback_t audio = {.cb.priority = BACKGROUND_CALLBACK_PRIORITY_AUDIO, .name = 'a'};
+        static background_test_callback_t other = {.name = 'd'};
+        static background_test_callback_t web = {.cb.priority = BACKGROUND_CALLBACK_PRIORITY_WEB, .name = 'w'};
+        background_callback_reset_stats();
+
+        // Callbacks run highest priority first, whatever order they were
+        // added in. One that adds itself again waits for the next run.
+        audio.run = 20;
+        audio.again = true;
+        other.run = 100;
+        web.run = 700;
+        background_callback_add(&web.cb, background_test_web, &web);
+        background_callback_add(&other.cb, background_test_default, &other);
+        keypad_test_subticks += 10;
+        background_callback_add(&audio.cb, background_test_audio, &audio);
+        background_callback_add(&audio.cb, background_test_audio, &audio);
+        keypad_test_subticks += 5;
+        background_callback_run_all();
+        mp_printf(&mp_plat_print, " %d\n", background_callback_pending());
+        audio.run = 40;
+        background_callback_run_all();
+        mp_printf(&mp_plat_print, " %d\n", background_callback_pending());
+
+        // Run times and queue latencies are in ticks. The second audio run
+        // and the web run take longer than their budgets.
+        background_callback_stats_t stats[BACKGROUND_CALLBACK_STATS_COUNT];
+        size_t count = background_callback_get_stats(stats, MP_ARRAY_SIZE(stats));
+        for (size_t i = 0; i < count; i++) {
+            background_callback_stats_t *entry = &stats[i];
+            char name = entry->fun == background_test_audio ? 'a' : entry->fun == background_test_default ? 'd' : 'w';
+            mp_printf(&mp_plat_print, "%c %d %u %u %u %u %u %u\n", name, entry->priority, (unsigned)entry->count,
+                (unsigned)entry->max_run, (unsigned)(entry->total_run / entry->count),
+                (unsigned)entry->max_latency, (unsigned)(entry->total_latency / entry->count), (unsigned)entry->overruns);
+        }
+        background_callback_reset_stats();
+        mp_printf(&mp_plat_print, "%d\n", (int)background_callback_get_stats(stats, MP_ARRAY_SIZE(stats)));
+    }
+
     mp_printf(&mp_plat_print, "# end coverage.c\n");
 
     mp_obj_streamtest_t *s = mp_obj_malloc(mp_obj_streamtest_t, &mp_type_stest_fileio);
@@ -4,6 +4,8 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include <string.h>
+
 #include "py/enum.h"
 #include "py/obj.h"
 #include "py/runtime.h"
@@ -11,7 +13,11 @@
 #include "shared-bindings/displayio/__init__.h"
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/ColorConverter.h"
+#include "shared-bindings/displayio/Group.h"
+#include "shared-bindings/displayio/OnDiskBitmap.h"
 #include "shared-bindings/displayio/Palette.h"
+#include "shared-bindings/displayio/TileGrid.h"
+#include "shared-module/displayio/area.h"
 
 MAKE_ENUM_VALUE(displayio_colorspace_type, displayio_colorspace, RGB888, DISPLAYIO_COLORSPACE_RGB888);
 MAKE_ENUM_VALUE(displayio_colorspace_type, displayio_colorspace, RGB565, DISPLAYIO_COLORSPACE_RGB565);
@@ -59,12 +65,101 @@ static MP_DEFINE_CONST_DICT(displayio_colorspace_locals_dict, displayio_colorspa
 MAKE_PRINTER(displayio, displayio_colorspace);
 MAKE_ENUM_TYPE(displayio, ColorSpace, displayio_colorspace);
 
+// Test helper that refreshes group into framebuffer the way a display with the given native width,
+// height, rotation and color depth would. The first refresh of a group draws everything and later
+// ones only the areas that changed. Returns the refreshed areas as (x1, y1, x2, y2) tuples.
+static mp_obj_t displayio__refresh(size_t n_args, const mp_obj_t *args) {
+    displayio_group_t *group = mp_arg_validate_type(args[0], &displayio_group_type, MP_QSTR_group);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
+    mp_int_t width = mp_obj_get_int(args[2]);
+    mp_int_t height = mp_obj_get_int(args[3]);
+    mp_int_t rotation = mp_obj_get_int(args[4]);
+    mp_int_t depth = mp_obj_get_int(args[5]);
+    if (width * height * depth / 8 > (mp_int_t)bufinfo.len || width * depth % 8 != 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Buffer too small"));
+    }
+
+    _displayio_colorspace_t colorspace = {
+        .depth = depth,
+        .bytes_per_cell = 1,
+        .grayscale = depth < 16,
+        .grayscale_bit = depth < 8 ? 8 - depth : 0,
+        .pixels_in_byte_share_row = true,
+    };
+
+    displayio_area_t full_area = { .x1 = 0, .y1 = 0, .x2 = width, .y2 = height, .next = NULL };
+    const displayio_area_t *area;
+    if (!group->in_group) {
+        // Matches displayio_display_core_set_rotation() with the width and height already swapped
+        // for transposed rotations.
+        displayio_buffer_transform_t transform = { .dx = 1, .dy = 1, .scale = 1 };
+        transform.transpose_xy = rotation == 90 || rotation == 270;
+        transform.mirror_x = rotation == 90 || rotation == 180;
+        transform.mirror_y = rotation == 180 || rotation == 270;
+        if (transform.mirror_x) {
+            transform.x = width;
+            transform.dx = -1;
+        }
+        if (transform.mirror_y) {
+            transform.y = height;
+            transform.dy = -1;
+        }
+        displayio_group_update_transform(group, &transform);
+        area = &full_area;
+    } else {
+        area = displayio_group_get_refresh_areas(group, NULL);
+    }
+
+    displayio_occluders_t occluders = { .count = 0 };
+    displayio_group_update_occlusion(group, &occluders);
+
+    mp_obj_t areas = mp_obj_new_list(0, NULL);
+    uint8_t pixels_per_byte = depth < 8 ? 8 / depth : 1;
+    uint8_t bytes_per_pixel = depth < 8 ? 1 : depth / 8;
+    for (; area != NULL; area = area->next) {
+        displayio_area_t clipped;
+        if (!displayio_area_compute_overlap(&full_area, area, &clipped)) {
+            continue;
+        }
+        if (depth < 8) {
+            clipped.x1 -= clipped.x1 % pixels_per_byte;
+            clipped.x2 += (pixels_per_byte - clipped.x2 % pixels_per_byte) % pixels_per_byte;
+        }
+        uint32_t pixels = displayio_area_size(&clipped);
+        uint32_t *buffer = m_new0(uint32_t, pixels * bytes_per_pixel / pixels_per_byte / sizeof(uint32_t) + 1);
+        uint32_t *mask = m_new0(uint32_t, DISPLAYIO_MASK_LENGTH(pixels));
+        displayio_group_fill_area(group, &colorspace, &clipped, mask, buffer);
+
+        uint32_t row_bytes = displayio_area_width(&clipped) * bytes_per_pixel / pixels_per_byte;
+        for (int16_t y = clipped.y1; y < clipped.y2; y++) {
+            memcpy((uint8_t *)bufinfo.buf + (y * width + clipped.x1) * bytes_per_pixel / pixels_per_byte,
+                (uint8_t *)buffer + (y - clipped.y1) * row_bytes, row_bytes);
+        }
+        m_del(uint32_t, buffer, pixels * bytes_per_pixel / pixels_per_byte / sizeof(uint32_t) + 1);
+        m_del(uint32_t, mask, DISPLAYIO_MASK_LENGTH(pixels));
+
+        mp_obj_t coords[] = {
+            MP_OBJ_NEW_SMALL_INT(clipped.x1), MP_OBJ_NEW_SMALL_INT(clipped.y1),
+            MP_OBJ_NEW_SMALL_INT(clipped.x2), MP_OBJ_NEW_SMALL_INT(clipped.y2),
+        };
+        mp_obj_list_append(areas, mp_obj_new_tuple(4, coords));
+    }
+    displayio_group_finish_refresh(group);
+    return areas;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(displayio__refresh_obj, 6, 6, displayio__refresh);
+
 static const mp_rom_map_elem_t displayio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_displayio) },
     { MP_ROM_QSTR(MP_QSTR_Bitmap), MP_ROM_PTR(&displayio_bitmap_type) },
     { MP_ROM_QSTR(MP_QSTR_Colorspace), MP_ROM_PTR(&displayio_colorspace_type) },
     { MP_ROM_QSTR(MP_QSTR_ColorConverter), MP_ROM_PTR(&displayio_colorconverter_type) },
+    { MP_ROM_QSTR(MP_QSTR_Group), MP_ROM_PTR(&displayio_group_type) },
+    { MP_ROM_QSTR(MP_QSTR_OnDiskBitmap), MP_ROM_PTR(&displayio_ondiskbitmap_type) },
     { MP_ROM_QSTR(MP_QSTR_Palette), MP_ROM_PTR(&displayio_palette_type) },
+    { MP_ROM_QSTR(MP_QSTR_TileGrid), MP_ROM_PTR(&displayio_tilegrid_type) },
+    { MP_ROM_QSTR(MP_QSTR__refresh), MP_ROM_PTR(&displayio__refresh_obj) },
 };
 static MP_DEFINE_CONST_DICT(displayio_module_globals, displayio_module_globals_table);
 
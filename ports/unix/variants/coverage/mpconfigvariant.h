@@ -37,6 +37,16 @@
 #define MICROPY_GC_SPLIT_HEAP          (1)
 #define MICROPY_GC_SPLIT_HEAP_N_HEAPS  (4)
 
+// CIRCUITPY-CHANGE: Enable testing of the GC nursery and incremental sweep.
+#define MICROPY_GC_NURSERY             (1)
+#define MICROPY_GC_INCREMENTAL_SWEEP   (1)
+#define MICROPY_PY_GC_STATS            (1)
+
+// CIRCUITPY-CHANGE: Background callbacks are run and timed by the coverage
+// tests on one thread, with no interrupts to keep out.
+#define CALLBACK_CRITICAL_BEGIN        ((void)0)
+#define CALLBACK_CRITICAL_END          ((void)0)
+
 // Enable additional features.
 #define MICROPY_DEBUG_PARSE_RULE_NAME  (1)
 #define MICROPY_TRACKED_ALLOC          (1)
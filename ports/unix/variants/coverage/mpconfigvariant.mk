@@ -32,6 +32,7 @@ SRC_BITMAP := \
 	shared-bindings/aesio/__init__.c \
 	shared-bindings/audiocore/__init__.c \
 	shared-bindings/audiocore/RawSample.c \
+	shared-bindings/audiocore/Resampler.c \
 	shared-bindings/audiocore/WaveFile.c \
 	shared-bindings/audiodelays/Echo.c \
 	shared-bindings/audiodelays/PitchShift.c \
@@ -49,11 +50,22 @@ SRC_BITMAP := \
 	shared-bindings/codeop/__init__.c \
 	shared-bindings/displayio/Bitmap.c \
 	shared-bindings/displayio/ColorConverter.c \
+	shared-bindings/displayio/Group.c \
+	shared-bindings/displayio/OnDiskBitmap.c \
 	shared-bindings/displayio/Palette.c \
+	shared-bindings/displayio/TileGrid.c \
 	shared-bindings/floppyio/__init__.c \
+	shared-bindings/gifio/__init__.c \
+	shared-bindings/gifio/GifWriter.c \
+	shared-bindings/gifio/OnDiskGif.c \
 	shared-bindings/jpegio/__init__.c \
 	shared-bindings/jpegio/JpegDecoder.c \
+	shared-bindings/keypad/Event.c \
+	shared-bindings/keypad/EventQueue.c \
 	shared-bindings/locale/__init__.c \
+	shared-bindings/msgpack/__init__.c \
+	shared-bindings/msgpack/ExtType.c \
+	shared-bindings/msgpack/Unpacker.c \
 	shared-bindings/rainbowio/__init__.c \
 	shared-bindings/struct/__init__.c \
 	shared-bindings/synthio/__init__.c \
@@ -72,11 +84,14 @@ SRC_BITMAP := \
 	shared-bindings/vectorio/Rectangle.c \
 	shared-bindings/vectorio/VectorShape.c \
 	shared-bindings/zlib/__init__.c \
+	shared-bindings/zlib/Decompress.c \
 	shared-module/aesio/aes.c \
 	shared-module/aesio/__init__.c \
 	shared-module/audiocore/__init__.c \
 	shared-module/audiocore/RawSample.c \
+	shared-module/audiocore/Resampler.c \
 	shared-module/audiocore/WaveFile.c \
+	shared-module/audiocore/read_ahead.c \
 	shared-module/audiodelays/Echo.c \
 	shared-module/audiodelays/PitchShift.c \
 	shared-module/audiodelays/__init__.c \
@@ -92,10 +107,21 @@ SRC_BITMAP := \
 	shared-module/displayio/area.c \
 	shared-module/displayio/Bitmap.c \
 	shared-module/displayio/ColorConverter.c \
+	shared-module/displayio/Group.c \
+	shared-module/displayio/OnDiskBitmap.c \
 	shared-module/displayio/Palette.c \
+	shared-module/displayio/TileGrid.c \
 	shared-module/floppyio/__init__.c \
+	shared-module/gifio/__init__.c \
+	shared-module/gifio/GifWriter.c \
+	shared-module/gifio/OnDiskGif.c \
 	shared-module/jpegio/__init__.c \
 	shared-module/jpegio/JpegDecoder.c \
+	shared-module/keypad/Event.c \
+	shared-module/keypad/EventQueue.c \
+	shared-module/keypad/__init__.c \
+	shared-module/msgpack/__init__.c \
+	shared-module/msgpack/Unpacker.c \
 	shared-module/os/getenv.c \
 	shared-module/rainbowio/__init__.c \
 	shared-module/struct/__init__.c \
@@ -115,8 +141,15 @@ SRC_BITMAP := \
 	shared-module/vectorio/VectorShape.c \
 	shared-module/traceback/__init__.c \
 	shared-module/zlib/__init__.c \
+	shared-module/zlib/Decompress.c \
+	supervisor/shared/background_callback.c \
+	supervisor/shared/spsc_ring.c \
+	supervisor/shared/external_flash/sector_cache.c \
 
 SRC_C += $(SRC_BITMAP)
+SRC_C += lib/AnimatedGIF/gif.c
+$(BUILD)/lib/AnimatedGIF/gif.o: CFLAGS += -DCIRCUITPY
+$(BUILD)/supervisor/shared/external_flash/sector_cache.o $(BUILD)/coverage.o: CFLAGS += -DFILESYSTEM_BLOCK_SIZE=512 -DCIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS=4
 
 SRC_C += $(addprefix lib/mp3/src/, \
         bitstream.c \
@@ -147,6 +180,7 @@ CFLAGS += \
 	-DCIRCUITPY_AUDIOMIXER=1 \
 	-DCIRCUITPY_AUDIOMP3=1 \
 	-DCIRCUITPY_AUDIOCORE_DEBUG=1 \
+	-DCIRCUITPY_BACKGROUND_CALLBACK_STATS=1 \
 	-DCIRCUITPY_BITMAPTOOLS=1 \
 	-DCIRCUITPY_CODEOP=1 \
 	-DCIRCUITPY_DISPLAYIO_UNIX=1 \
@@ -155,6 +189,7 @@ CFLAGS += \
 	-DCIRCUITPY_GIFIO=1 \
 	-DCIRCUITPY_JPEGIO=1 \
 	-DCIRCUITPY_LOCALE=1 \
+	-DCIRCUITPY_MSGPACK=1 \
 	-DCIRCUITPY_OS_GETENV=1 \
 	-DCIRCUITPY_RAINBOWIO=1 \
 	-DCIRCUITPY_STRUCT=1 \
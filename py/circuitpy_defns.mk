@@ -626,6 +626,7 @@ SRC_SHARED_MODULE_ALL = \
 	aesio/aes.c \
 	atexit/__init__.c \
 	audiocore/RawSample.c \
+	audiocore/Resampler.c \
 	audiocore/WaveFile.c \
 	audiocore/__init__.c \
 	audiodelays/Echo.c \
@@ -703,6 +704,7 @@ SRC_SHARED_MODULE_ALL = \
 	memorymonitor/AllocationSize.c \
 	network/__init__.c \
 	msgpack/__init__.c \
+	msgpack/Unpacker.c \
 	onewireio/__init__.c \
 	onewireio/OneWire.c \
 	os/__init__.c \
@@ -748,6 +750,7 @@ SRC_SHARED_MODULE_ALL = \
 	vectorio/__init__.c \
 	warnings/__init__.c \
 	watchdog/__init__.c \
+	zlib/Decompress.c \
 	zlib/__init__.c \
 
 # All possible sources are listed here, and are filtered by SRC_PATTERNS.
@@ -872,6 +875,7 @@ endif
 # All possible sources are listed here, and are filtered by SRC_PATTERNS.
 SRC_SHARED_MODULE_INTERNAL = \
 $(filter $(SRC_PATTERNS), \
+	audiocore/read_ahead.c \
 	displayio/bus_core.c \
 	displayio/display_core.c \
 	os/getenv.c \
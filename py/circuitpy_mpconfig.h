@@ -79,6 +79,8 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_GC_ALLOC_THRESHOLD       (0)
 #define MICROPY_GC_SPLIT_HEAP            (1)
 #define MICROPY_GC_SPLIT_HEAP_AUTO       (1)
+#define MICROPY_GC_INCREMENTAL_SWEEP     (CIRCUITPY_GC_INCREMENTAL_SWEEP)
+#define MICROPY_GC_NURSERY               (CIRCUITPY_GC_NURSERY)
 #define MP_PLAT_ALLOC_HEAP(size) port_malloc(size, false)
 #define MP_PLAT_FREE_HEAP(ptr) port_free(ptr)
 #include "supervisor/port_heap.h"
@@ -93,6 +95,10 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_OPT_COMPUTED_GOTO_SAVE_SPACE (CIRCUITPY_COMPUTED_GOTO_SAVE_SPACE)
 #define MICROPY_OPT_LOAD_ATTR_FAST_PATH  (CIRCUITPY_OPT_LOAD_ATTR_FAST_PATH)
 #define MICROPY_OPT_MAP_LOOKUP_CACHE  (CIRCUITPY_OPT_MAP_LOOKUP_CACHE)
+#define MICROPY_OPT_INLINE_CACHE  (CIRCUITPY_OPT_INLINE_CACHE)
+#define MICROPY_OPT_VM_BINARY_OP_FAST_PATH (CIRCUITPY_OPT_VM_BINARY_OP_FAST_PATH)
+#define MICROPY_OPT_ROM_MAP_INDEX        (CIRCUITPY_OPT_ROM_MAP_INDEX)
+#define MICROPY_OPT_QSTR_INDEX          (CIRCUITPY_OPT_QSTR_INDEX)
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (CIRCUITPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE)
 #define MICROPY_PERSISTENT_CODE_LOAD     (1)
 
@@ -127,6 +133,7 @@ extern void common_hal_mcu_enable_interrupts(void);
 // Uses about 80 bytes.
 #define MICROPY_PY_ERRNO_ERRORCODE      (CIRCUITPY_ERRNO)
 #define MICROPY_PY_GC                    (1)
+#define MICROPY_PY_GC_STATS              (CIRCUITPY_GC_STATS)
 // Supplanted by shared-bindings/math
 #define MICROPY_PY_IO                    (CIRCUITPY_IO)
 #define MICROPY_PY_IO_IOBASE             (CIRCUITPY_IO_IOBASE)
@@ -150,6 +150,10 @@ CFLAGS += -DCIRCUITPY_AUDIOFILTERS=$(CIRCUITPY_AUDIOFILTERS)
 CIRCUITPY_AURORA_EPAPER ?= 0
 CFLAGS += -DCIRCUITPY_AURORA_EPAPER=$(CIRCUITPY_AURORA_EPAPER)
 
+# Time background callbacks and report it with supervisor.get_background_callback_stats()
+CIRCUITPY_BACKGROUND_CALLBACK_STATS ?= 0
+CFLAGS += -DCIRCUITPY_BACKGROUND_CALLBACK_STATS=$(CIRCUITPY_BACKGROUND_CALLBACK_STATS)
+
 CIRCUITPY_BINASCII ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_BINASCII=$(CIRCUITPY_BINASCII)
 
@@ -262,8 +266,19 @@ CFLAGS += -DCIRCUITPY_VECTORIO=$(CIRCUITPY_VECTORIO)
 CIRCUITPY_DUALBANK ?= 0
 CFLAGS += -DCIRCUITPY_DUALBANK=$(CIRCUITPY_DUALBANK)
 
+# Compile frozen modules to native code ahead of time, falling back to
+# bytecode for modules the native emitter can't handle (experimental). Native
+# code runs several times faster but takes more flash. The port sets
+# MPY_CROSS_NATIVE_ARCH.
+CIRCUITPY_FROZEN_NATIVE ?= 0
+ifeq ($(CIRCUITPY_FROZEN_NATIVE),1)
+ifeq ($(MPY_CROSS_NATIVE_ARCH),)
+$(error CIRCUITPY_FROZEN_NATIVE needs MPY_CROSS_NATIVE_ARCH to be set for this port)
+endif
+endif
+
 # Enabled micropython.native decorator (experimental)
-CIRCUITPY_ENABLE_MPY_NATIVE ?= 0
+CIRCUITPY_ENABLE_MPY_NATIVE ?= $(CIRCUITPY_FROZEN_NATIVE)
 CFLAGS += -DCIRCUITPY_ENABLE_MPY_NATIVE=$(CIRCUITPY_ENABLE_MPY_NATIVE)
 
 CIRCUITPY_OS_GETENV ?= $(CIRCUITPY_FULL_BUILD)
@@ -301,6 +316,18 @@ CFLAGS += -DCIRCUITPY_FREQUENCYIO=$(CIRCUITPY_FREQUENCYIO)
 CIRCUITPY_FUTURE ?= 1
 CFLAGS += -DCIRCUITPY_FUTURE=$(CIRCUITPY_FUTURE)
 
+# Sweep the GC heap in slices from allocations and the background tick.
+CIRCUITPY_GC_INCREMENTAL_SWEEP ?= 0
+CFLAGS += -DCIRCUITPY_GC_INCREMENTAL_SWEEP=$(CIRCUITPY_GC_INCREMENTAL_SWEEP)
+
+# Keep a nursery for small allocations in the GC heap (see MICROPY_GC_NURSERY).
+CIRCUITPY_GC_NURSERY ?= 0
+CFLAGS += -DCIRCUITPY_GC_NURSERY=$(CIRCUITPY_GC_NURSERY)
+
+# Provide gc.stats() with collection counts and a pause time histogram.
+CIRCUITPY_GC_STATS ?= 0
+CFLAGS += -DCIRCUITPY_GC_STATS=$(CIRCUITPY_GC_STATS)
+
 CIRCUITPY_GETPASS ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_GETPASS=$(CIRCUITPY_GETPASS)
 
@@ -400,6 +427,18 @@ CFLAGS += -DCIRCUITPY_OPT_LOAD_ATTR_FAST_PATH=$(CIRCUITPY_OPT_LOAD_ATTR_FAST_PAT
 CIRCUITPY_OPT_MAP_LOOKUP_CACHE ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_OPT_MAP_LOOKUP_CACHE=$(CIRCUITPY_OPT_MAP_LOOKUP_CACHE)
 
+CIRCUITPY_OPT_INLINE_CACHE ?= $(CIRCUITPY_FULL_BUILD)
+CFLAGS += -DCIRCUITPY_OPT_INLINE_CACHE=$(CIRCUITPY_OPT_INLINE_CACHE)
+
+CIRCUITPY_OPT_VM_BINARY_OP_FAST_PATH ?= $(CIRCUITPY_FULL_BUILD)
+CFLAGS += -DCIRCUITPY_OPT_VM_BINARY_OP_FAST_PATH=$(CIRCUITPY_OPT_VM_BINARY_OP_FAST_PATH)
+
+CIRCUITPY_OPT_ROM_MAP_INDEX ?= $(CIRCUITPY_FULL_BUILD)
+CFLAGS += -DCIRCUITPY_OPT_ROM_MAP_INDEX=$(CIRCUITPY_OPT_ROM_MAP_INDEX)
+
+CIRCUITPY_OPT_QSTR_INDEX ?= $(CIRCUITPY_FULL_BUILD)
+CFLAGS += -DCIRCUITPY_OPT_QSTR_INDEX=$(CIRCUITPY_OPT_QSTR_INDEX)
+
 CIRCUITPY_OS ?= 1
 CFLAGS += -DCIRCUITPY_OS=$(CIRCUITPY_OS)
 
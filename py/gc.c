@@ -43,6 +43,10 @@
 #include "shared-module/memorymonitor/__init__.h"
 #endif
 
+#if MICROPY_PY_GC_STATS
+#include "py/mphal.h"
+#endif
+
 #if MICROPY_ENABLE_GC
 
 #if MICROPY_DEBUG_VERBOSE // print debugging info
@@ -209,6 +213,41 @@ static void gc_setup_area(mp_state_mem_area_t *area, void *start, void *end) {
         gc_pool_block_len * BYTES_PER_BLOCK, gc_pool_block_len);
 }
 
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_NURSERY
+// The nursery is a whole number of ATBs of the first area so that it can be
+// searched a byte at a time. Blocks that survive a minor collection aren't
+// moved out of it, so after each full collection the nursery moves to the most
+// free part of the area.
+static void gc_place_nursery(size_t start_atb, size_t atb_len) {
+    byte *pool_start = MP_STATE_MEM(area).gc_pool_start;
+    MP_STATE_MEM(gc_nursery_start) = pool_start + start_atb * BLOCKS_PER_ATB * BYTES_PER_BLOCK;
+    MP_STATE_MEM(gc_nursery_end) = MP_STATE_MEM(gc_nursery_start) + atb_len * BLOCKS_PER_ATB * BYTES_PER_BLOCK;
+    MP_STATE_MEM(gc_nursery_last_free_atb_index) = start_atb;
+}
+
+static void gc_setup_nursery(void) {
+    size_t area_atb_len = MP_STATE_MEM(area).gc_alloc_table_byte_len;
+    size_t atb_len = area_atb_len / MICROPY_GC_NURSERY_DIVISOR;
+    // Start out at the end of the area, away from the first-fit allocations.
+    gc_place_nursery(atb_len == 0 ? 0 : (area_atb_len / atb_len - 1) * atb_len, atb_len);
+    MP_STATE_MEM(gc_nursery_full) = atb_len == 0;
+    MP_STATE_MEM(gc_collecting_minor) = false;
+}
+
+static inline bool gc_in_nursery(const void *ptr) {
+    return (const byte *)ptr >= MP_STATE_MEM(gc_nursery_start) && (const byte *)ptr < MP_STATE_MEM(gc_nursery_end);
+}
+
+static inline size_t gc_nursery_start_atb(void) {
+    return (MP_STATE_MEM(gc_nursery_start) - MP_STATE_MEM(area).gc_pool_start) / (BLOCKS_PER_ATB * BYTES_PER_BLOCK);
+}
+
+static inline size_t gc_nursery_end_atb(void) {
+    return (MP_STATE_MEM(gc_nursery_end) - MP_STATE_MEM(area).gc_pool_start) / (BLOCKS_PER_ATB * BYTES_PER_BLOCK);
+}
+#endif
+
 void gc_init(void *start, void *end) {
     // align end pointer on block boundary
     end = (void *)((uintptr_t)end & (~(BYTES_PER_BLOCK - 1)));
@@ -216,6 +255,15 @@ void gc_init(void *start, void *end) {
 
     gc_setup_area(&MP_STATE_MEM(area), start, end);
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    gc_setup_nursery();
+    #endif
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // Drop any sweep left over from a previous heap.
+    memset(&MP_STATE_MEM(gc_sweep), 0, sizeof(MP_STATE_MEM(gc_sweep)));
+    #endif
+
     // set last free ATB index to start of heap
     #if MICROPY_GC_SPLIT_HEAP
     MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
@@ -223,6 +271,10 @@ void gc_init(void *start, void *end) {
 
     // unlock the GC
     MP_STATE_THREAD(gc_lock_depth) = 0;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    MP_STATE_THREAD(gc_minor_requested) = false;
+    #endif
 
     // allow auto collection
     MP_STATE_MEM(gc_auto_collect_enabled) = 1;
@@ -358,6 +410,9 @@ void gc_deinit(void) {
     // any additional heap areas (but not the first.)
     gc_sweep_all();
     memset(&MP_STATE_MEM(area), 0, sizeof(MP_STATE_MEM(area)));
+    #if MICROPY_GC_NURSERY
+    MP_STATE_MEM(gc_nursery_full) = true;
+    #endif
 }
 
 void gc_lock(void) {
@@ -452,6 +507,13 @@ static void MP_NO_INSTRUMENT PLACE_IN_ITCM(gc_mark_subtree)(size_t block)
         for (size_t i = n_blocks * BYTES_PER_BLOCK / sizeof(void *); i > 0; i--, ptrs++) {
             MICROPY_GC_HOOK_LOOP(i);
             void *ptr = *ptrs;
+            // CIRCUITPY-CHANGE
+            #if MICROPY_GC_NURSERY
+            // A minor collection leaves everything outside the nursery alone.
+            if (MP_STATE_MEM(gc_collecting_minor) && !gc_in_nursery(ptr)) {
+                continue;
+            }
+            #endif
             // If this is a heap pointer that hasn't been marked, mark it and push
             // it's children to the stack.
             #if MICROPY_GC_SPLIT_HEAP
@@ -520,24 +582,59 @@ static void gc_deal_with_stack_overflow(void) {
     }
 }
 
-static void gc_sweep(void) {
+// CIRCUITPY-CHANGE: The sweep can be stopped after a number of blocks and
+// carried on later, so its state is kept in a mp_state_gc_sweep_t.
+static void gc_sweep_start(mp_state_gc_sweep_t *sweep) {
     #if MICROPY_PY_GC_COLLECT_RETVAL
     MP_STATE_MEM(gc_collected) = 0;
     #endif
+    sweep->area = &MP_STATE_MEM(area);
+    sweep->block = 0;
+    sweep->last_used_block = 0;
+    sweep->free_tail = false;
+    #if MICROPY_GC_SPLIT_HEAP_AUTO
+    sweep->prev_area = NULL;
+    #endif
+    #if MICROPY_GC_NURSERY
+    if (MP_STATE_MEM(gc_collecting_minor)) {
+        // Only the nursery is swept.
+        sweep->block = gc_nursery_start_atb() * BLOCKS_PER_ATB;
+    }
+    #endif
+}
+
+// Sweeps at most budget blocks. Returns true once the sweep is done.
+static bool gc_sweep_step(mp_state_gc_sweep_t *sweep, size_t budget) {
     // free unmarked heads and their tails
-    int free_tail = 0;
+    int free_tail = sweep->free_tail;
+    size_t last_used_block = sweep->last_used_block;
     #if MICROPY_GC_SPLIT_HEAP_AUTO
-    mp_state_mem_area_t *prev_area = NULL;
+    mp_state_mem_area_t *prev_area = sweep->prev_area;
     #endif
-    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+    for (mp_state_mem_area_t *area = sweep->area; area != NULL; area = NEXT_AREA(area)) {
         size_t end_block = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
         if (area->gc_last_used_block < end_block) {
             end_block = area->gc_last_used_block + 1;
         }
 
-        size_t last_used_block = 0;
+        #if MICROPY_GC_NURSERY
+        if (MP_STATE_MEM(gc_collecting_minor)) {
+            end_block = MIN(end_block, gc_nursery_end_atb() * BLOCKS_PER_ATB);
+        }
+        #endif
 
-        for (size_t block = 0; block < end_block; block++) {
+        for (size_t block = sweep->block; block < end_block; block++) {
+            if (budget == 0) {
+                sweep->area = area;
+                sweep->block = block;
+                sweep->last_used_block = last_used_block;
+                sweep->free_tail = free_tail;
+                #if MICROPY_GC_SPLIT_HEAP_AUTO
+                sweep->prev_area = prev_area;
+                #endif
+                return false;
+            }
+            budget--;
             MICROPY_GC_HOOK_LOOP(block);
             switch (ATB_GET_KIND(area, block)) {
                 case AT_HEAD:
@@ -590,6 +687,20 @@ static void gc_sweep(void) {
             }
         }
 
+        #if MICROPY_GC_NURSERY
+        if (MP_STATE_MEM(gc_collecting_minor)) {
+            // The last chain in the nursery may run past its end, but not
+            // past the end of the area. The last used block is left as it
+            // was, since it's only an upper bound.
+            size_t area_end_block = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+            for (size_t block = end_block; free_tail && block < area_end_block && ATB_GET_KIND(area, block) == AT_TAIL; block++) {
+                ATB_ANY_TO_FREE(area, block);
+            }
+            // The nursery is all in the first area.
+            break;
+        }
+        #endif
+
         area->gc_last_used_block = last_used_block;
 
         #if MICROPY_GC_SPLIT_HEAP_AUTO
@@ -602,12 +713,190 @@ static void gc_sweep(void) {
         }
         prev_area = area;
         #endif
+
+        sweep->block = 0;
+        last_used_block = 0;
     }
+    sweep->area = NULL;
+    return true;
+}
+
+static void gc_sweep(void) {
+    mp_state_gc_sweep_t sweep;
+    gc_sweep_start(&sweep);
+    gc_sweep_step(&sweep, (size_t)-1);
 }
 
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_NURSERY
+// Marks the nursery blocks that are pointed to from outside the nursery. The
+// rest of the heap isn't traced by a minor collection, so every block in use
+// there is treated as live and scanned.
+static void gc_scan_outside_nursery(void) {
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        size_t end_block = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+        if (area->gc_last_used_block < end_block) {
+            end_block = area->gc_last_used_block + 1;
+        }
+        // Whether the current chain started outside the nursery. Its tail may
+        // run into the nursery and still has to be scanned.
+        bool old_chain = false;
+        for (size_t block = 0; block < end_block; block++) {
+            MICROPY_GC_HOOK_LOOP(block);
+            switch (ATB_GET_KIND(area, block)) {
+                case AT_FREE:
+                    old_chain = false;
+                    continue;
+                case AT_HEAD:
+                    old_chain = !gc_in_nursery((void *)PTR_FROM_BLOCK(area, block));
+                    break;
+                case AT_MARK:
+                    // Only nursery blocks are marked, and they've been traced.
+                    old_chain = false;
+                    continue;
+            }
+            if (old_chain) {
+                gc_collect_root((void **)PTR_FROM_BLOCK(area, block), BYTES_PER_BLOCK / sizeof(void *));
+            }
+        }
+    }
+}
+
+static size_t gc_count_free(mp_state_mem_area_t *area, size_t start_atb, size_t end_atb) {
+    size_t n_free = 0;
+    for (size_t block = start_atb * BLOCKS_PER_ATB; block < end_atb * BLOCKS_PER_ATB; block++) {
+        if (ATB_GET_KIND(area, block) == AT_FREE) {
+            n_free++;
+        }
+    }
+    return n_free;
+}
+
+// Called at the end of every collection. A full collection moves the nursery
+// to the part of the first area with the most free blocks. If the nursery is
+// still mostly in use, gc_nursery_full sends small allocations to the rest of
+// the heap until the next full collection, rather than running one minor
+// collection after another.
+static void gc_update_nursery(void) {
+    mp_state_mem_area_t *area = &MP_STATE_MEM(area);
+    size_t start_atb = gc_nursery_start_atb();
+    size_t atb_len = gc_nursery_end_atb() - start_atb;
+    if (atb_len == 0) {
+        return;
+    }
+    size_t n_free;
+    if (MP_STATE_MEM(gc_collecting_minor)) {
+        n_free = gc_count_free(area, start_atb, start_atb + atb_len);
+    } else {
+        n_free = 0;
+        for (size_t atb = 0; atb + atb_len <= area->gc_alloc_table_byte_len; atb += atb_len) {
+            size_t n = gc_count_free(area, atb, atb + atb_len);
+            // Ties go to the higher part, away from the first-fit allocations.
+            if (n >= n_free) {
+                n_free = n;
+                start_atb = atb;
+            }
+        }
+    }
+    gc_place_nursery(start_atb, atb_len);
+    MP_STATE_MEM(gc_nursery_full) = n_free < atb_len * BLOCKS_PER_ATB / 4;
+}
+#endif
+
+// Called once a sweep has finished. Blocks may have been freed behind the
+// point that allocations search from, so they start from the beginning again.
+static void gc_sweep_done(void) {
+    #if MICROPY_GC_SPLIT_HEAP
+    MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+    #endif
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        area->gc_last_free_atb_index = 0;
+    }
+    #if MICROPY_GC_NURSERY
+    gc_update_nursery();
+    #endif
+}
+
+#if MICROPY_GC_INCREMENTAL_SWEEP
+// Carries on with the sweep left over from the last full collection, if any.
+static void gc_sweep_slice(size_t budget) {
+    if (MP_STATE_MEM(gc_sweep).area == NULL) {
+        return;
+    }
+    GC_ENTER();
+    MP_STATE_THREAD(gc_lock_depth)++;
+    #if MICROPY_PY_GC_STATS
+    mp_uint_t start = mp_hal_ticks_us();
+    #endif
+    if (gc_sweep_step(&MP_STATE_MEM(gc_sweep), budget)) {
+        gc_sweep_done();
+    }
+    #if MICROPY_PY_GC_STATS
+    mp_uint_t slice = mp_hal_ticks_us() - start;
+    MP_STATE_MEM(gc_sweep_slice_max_us) = MAX(MP_STATE_MEM(gc_sweep_slice_max_us), slice);
+    MP_STATE_MEM(gc_sweep_slices)++;
+    #endif
+    MP_STATE_THREAD(gc_lock_depth)--;
+    GC_EXIT();
+}
+
+void gc_collect_step(void) {
+    if (MP_STATE_THREAD(gc_lock_depth) == 0) {
+        gc_sweep_slice(MICROPY_GC_INCREMENTAL_SWEEP_BUDGET);
+    }
+}
+
+// Finishes any sweep that's in progress.
+static void gc_sweep_finish(void) {
+    gc_sweep_slice((size_t)-1);
+}
+
+// Blocks allocated while a sweep is in progress must survive it. Those that
+// it hasn't reached yet are marked, and it has to know about any tail blocks
+// that run past where it has got to.
+static void gc_sweep_note_alloc(mp_state_mem_area_t *area, size_t start_block, size_t end_block) {
+    mp_state_gc_sweep_t *sweep = &MP_STATE_MEM(gc_sweep);
+    if (sweep->area == NULL) {
+        return;
+    }
+    if (area == sweep->area) {
+        if (start_block >= sweep->block) {
+            ATB_HEAD_TO_MARK(area, start_block);
+        } else {
+            sweep->last_used_block = MAX(sweep->last_used_block, end_block);
+            if (end_block >= sweep->block) {
+                sweep->free_tail = false;
+            }
+        }
+        return;
+    }
+    for (mp_state_mem_area_t *a = NEXT_AREA(sweep->area); a != NULL; a = NEXT_AREA(a)) {
+        if (a == area) {
+            ATB_HEAD_TO_MARK(area, start_block);
+            return;
+        }
+    }
+}
+#endif
+
 void gc_collect_start(void) {
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_sweep_finish();
+    #endif
     GC_ENTER();
     MP_STATE_THREAD(gc_lock_depth)++;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    // Only this thread's request decides what kind of collection this is, and
+    // the kind only changes while the lock is held, so a collection running on
+    // another thread never sees it.
+    MP_STATE_MEM(gc_collecting_minor) = MP_STATE_THREAD(gc_minor_requested);
+    MP_STATE_THREAD(gc_minor_requested) = false;
+    #endif
+    #if MICROPY_PY_GC_STATS
+    MP_STATE_MEM(gc_pause_start_us) = mp_hal_ticks_us();
+    #endif
     #if MICROPY_GC_ALLOC_THRESHOLD
     MP_STATE_MEM(gc_alloc_amount) = 0;
     #endif
@@ -657,6 +946,12 @@ void gc_collect_root(void **ptrs, size_t len) {
     for (size_t i = 0; i < len; i++) {
         MICROPY_GC_HOOK_LOOP(i);
         void *ptr = gc_get_ptr(ptrs, i);
+        // CIRCUITPY-CHANGE
+        #if MICROPY_GC_NURSERY
+        if (MP_STATE_MEM(gc_collecting_minor) && !gc_in_nursery(ptr)) {
+            continue;
+        }
+        #endif
         #if MICROPY_GC_SPLIT_HEAP
         mp_state_mem_area_t *area = gc_get_ptr_area(ptr);
         if (!area) {
@@ -681,26 +976,94 @@ void gc_collect_root(void **ptrs, size_t len) {
 }
 
 void gc_collect_end(void) {
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    if (MP_STATE_MEM(gc_collecting_minor)) {
+        gc_scan_outside_nursery();
+    }
+    #endif
     gc_deal_with_stack_overflow();
-    gc_sweep();
-    #if MICROPY_GC_SPLIT_HEAP
-    MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // Only the first slice of a full collection's sweep is done now. Minor
+    // collections are short enough to sweep all at once.
+    bool sweep_all_now = false;
+    #if MICROPY_GC_NURSERY
+    sweep_all_now = MP_STATE_MEM(gc_collecting_minor);
     #endif
-    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
-        area->gc_last_free_atb_index = 0;
+    if (!sweep_all_now) {
+        gc_sweep_start(&MP_STATE_MEM(gc_sweep));
+        if (gc_sweep_step(&MP_STATE_MEM(gc_sweep), MICROPY_GC_INCREMENTAL_SWEEP_BUDGET)) {
+            gc_sweep_done();
+        } else {
+            // Let allocations find what the first slice freed.
+            #if MICROPY_GC_SPLIT_HEAP
+            MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+            #endif
+            for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+                area->gc_last_free_atb_index = 0;
+            }
+        }
+    } else
+    #endif
+    {
+        gc_sweep();
+        gc_sweep_done();
     }
+    #if MICROPY_PY_GC_STATS
+    mp_uint_t pause = mp_hal_ticks_us() - MP_STATE_MEM(gc_pause_start_us);
+    size_t bucket = 0;
+    while (pause >> bucket != 0 && bucket < MICROPY_GC_PAUSE_HISTOGRAM_LEN - 1) {
+        bucket++;
+    }
+    MP_STATE_MEM(gc_pause_histogram)[bucket]++;
+    MP_STATE_MEM(gc_pause_max_us) = MAX(MP_STATE_MEM(gc_pause_max_us), pause);
+    MP_STATE_MEM(gc_collections)++;
+    #if MICROPY_GC_NURSERY
+    if (MP_STATE_MEM(gc_collecting_minor)) {
+        MP_STATE_MEM(gc_minor_collections)++;
+    }
+    #endif
+    #endif
+    #if MICROPY_GC_NURSERY
+    MP_STATE_MEM(gc_collecting_minor) = false;
+    #endif
     MP_STATE_THREAD(gc_lock_depth)--;
     GC_EXIT();
 }
 
+#if MICROPY_GC_NURSERY
+// Runs the port's gc_collect() as a minor collection.
+static void gc_collect_nursery(void) {
+    MP_STATE_THREAD(gc_minor_requested) = true;
+    gc_collect();
+}
+#endif
+
 void gc_sweep_all(void) {
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_sweep_finish();
+    #endif
     GC_ENTER();
     MP_STATE_THREAD(gc_lock_depth)++;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_GC_STATS
+    MP_STATE_MEM(gc_pause_start_us) = mp_hal_ticks_us();
+    #endif
     MP_STATE_MEM(gc_stack_overflow) = 0;
     gc_collect_end();
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_sweep_finish();
+    #endif
 }
 
 void gc_info(gc_info_t *info) {
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_sweep_finish();
+    #endif
     GC_ENTER();
     info->total = 0;
     info->used = 0;
@@ -779,6 +1142,27 @@ bool gc_alloc_possible(void) {
     return MP_STATE_MEM(area).gc_pool_start != 0;
 }
 
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_NURSERY
+// Returns the last block of the first run of n_blocks free blocks in the
+// nursery, or (size_t)-1 if there isn't one.
+static size_t gc_nursery_find(size_t n_blocks) {
+    mp_state_mem_area_t *area = &MP_STATE_MEM(area);
+    size_t end_atb = gc_nursery_end_atb();
+    size_t n_free = 0;
+    for (size_t i = MP_STATE_MEM(gc_nursery_last_free_atb_index); i < end_atb; i++) {
+        byte a = area->gc_alloc_table_start[i];
+        // *FORMAT-OFF*
+        if (ATB_0_IS_FREE(a)) { if (++n_free >= n_blocks) { return i * BLOCKS_PER_ATB + 0; } } else { n_free = 0; }
+        if (ATB_1_IS_FREE(a)) { if (++n_free >= n_blocks) { return i * BLOCKS_PER_ATB + 1; } } else { n_free = 0; }
+        if (ATB_2_IS_FREE(a)) { if (++n_free >= n_blocks) { return i * BLOCKS_PER_ATB + 2; } } else { n_free = 0; }
+        if (ATB_3_IS_FREE(a)) { if (++n_free >= n_blocks) { return i * BLOCKS_PER_ATB + 3; } } else { n_free = 0; }
+        // *FORMAT-ON*
+    }
+    return (size_t)-1;
+}
+#endif
+
 void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
     bool has_finaliser = alloc_flags & GC_ALLOC_FLAG_HAS_FINALISER;
     size_t n_blocks = ((n_bytes + BYTES_PER_BLOCK - 1) & (~(BYTES_PER_BLOCK - 1))) / BYTES_PER_BLOCK;
@@ -794,6 +1178,12 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
         return NULL;
     }
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // Every allocation moves a pending sweep along by a slice.
+    gc_sweep_slice(MICROPY_GC_INCREMENTAL_SWEEP_BUDGET);
+    #endif
+
     GC_ENTER();
 
     mp_state_mem_area_t *area;
@@ -815,6 +1205,30 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
     }
     #endif
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    // Small allocations are made in the nursery while it has room. When it
+    // runs out, a minor collection usually frees most of it again.
+    bool in_nursery = false;
+    if (n_blocks <= MICROPY_GC_NURSERY_MAX_BLOCKS && !MP_STATE_MEM(gc_nursery_full)) {
+        i = gc_nursery_find(n_blocks);
+        if (i == (size_t)-1 && !collected) {
+            GC_EXIT();
+            gc_collect_nursery();
+            GC_ENTER();
+            if (!MP_STATE_MEM(gc_nursery_full)) {
+                i = gc_nursery_find(n_blocks);
+            }
+        }
+        if (i != (size_t)-1) {
+            area = &MP_STATE_MEM(area);
+            n_free = n_blocks;
+            in_nursery = true;
+            goto found;
+        }
+    }
+    #endif
+
     for (;;) {
 
         #if MICROPY_GC_SPLIT_HEAP
@@ -853,6 +1267,15 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
         }
 
         GC_EXIT();
+        // CIRCUITPY-CHANGE
+        #if MICROPY_GC_INCREMENTAL_SWEEP
+        // Sweep another slice and look again, before resorting to a collection.
+        if (MP_STATE_MEM(gc_sweep).area != NULL) {
+            gc_sweep_slice(MICROPY_GC_INCREMENTAL_SWEEP_BUDGET);
+            GC_ENTER();
+            continue;
+        }
+        #endif
         // nothing found!
         if (collected) {
             #if MICROPY_GC_SPLIT_HEAP_AUTO
@@ -885,6 +1308,14 @@ found:
     // for a single free block, which guarantees that there are no free blocks
     // before this one.  Also, whenever we free or shink a block we must check
     // if this index needs adjusting (see gc_realloc and gc_free).
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    if (in_nursery) {
+        if (n_free == 1) {
+            MP_STATE_MEM(gc_nursery_last_free_atb_index) = (i + 1) / BLOCKS_PER_ATB;
+        }
+    } else
+    #endif
     if (n_free == 1) {
         #if MICROPY_GC_SPLIT_HEAP
         MP_STATE_MEM(gc_last_free_area) = area;
@@ -908,6 +1339,11 @@ found:
         ATB_FREE_TO_TAIL(area, bl);
     }
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_sweep_note_alloc(area, start_block, end_block);
+    #endif
+
     // get pointer to first block
     // we must create this pointer before unlocking the GC so a collection can find it
     void *ret_ptr = (void *)(area->gc_pool_start + start_block * BYTES_PER_BLOCK);
@@ -1002,7 +1438,8 @@ void gc_free(void *ptr) {
     #endif
 
     size_t block = BLOCK_FROM_PTR(area, ptr);
-    assert(ATB_GET_KIND(area, block) == AT_HEAD);
+    // CIRCUITPY-CHANGE: Blocks a pending sweep hasn't reached yet are marked.
+    assert(ATB_GET_KIND(area, block) == AT_HEAD || ATB_GET_KIND(area, block) == AT_MARK);
 
     #if MICROPY_ENABLE_FINALISER
     FTB_CLEAR(area, block);
@@ -1027,6 +1464,12 @@ void gc_free(void *ptr) {
     if (block / BLOCKS_PER_ATB < area->gc_last_free_atb_index) {
         area->gc_last_free_atb_index = block / BLOCKS_PER_ATB;
     }
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    if (gc_in_nursery(ptr) && block / BLOCKS_PER_ATB < MP_STATE_MEM(gc_nursery_last_free_atb_index)) {
+        MP_STATE_MEM(gc_nursery_last_free_atb_index) = block / BLOCKS_PER_ATB;
+    }
+    #endif
 
     // CIRCUITPY-CHANGE
     #ifdef LOG_HEAP_ACTIVITY
@@ -1062,7 +1505,9 @@ size_t gc_nbytes(const void *ptr) {
 
     if (area) {
         size_t block = BLOCK_FROM_PTR(area, ptr);
-        if (ATB_GET_KIND(area, block) == AT_HEAD) {
+        // CIRCUITPY-CHANGE: Blocks a pending sweep hasn't reached yet are marked.
+        byte kind = ATB_GET_KIND(area, block);
+        if (kind == AT_HEAD || kind == AT_MARK) {
             // work out number of consecutive blocks in the chain starting with this on
             size_t n_blocks = 0;
             do {
@@ -1137,7 +1582,8 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     area = &MP_STATE_MEM(area);
     #endif
     size_t block = BLOCK_FROM_PTR(area, ptr);
-    assert(ATB_GET_KIND(area, block) == AT_HEAD);
+    // CIRCUITPY-CHANGE: Blocks a pending sweep hasn't reached yet are marked.
+    assert(ATB_GET_KIND(area, block) == AT_HEAD || ATB_GET_KIND(area, block) == AT_MARK);
 
     // compute number of new blocks that are requested
     size_t new_blocks = (n_bytes + BYTES_PER_BLOCK - 1) / BYTES_PER_BLOCK;
@@ -1192,6 +1638,12 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
         if ((block + new_blocks) / BLOCKS_PER_ATB < area->gc_last_free_atb_index) {
             area->gc_last_free_atb_index = (block + new_blocks) / BLOCKS_PER_ATB;
         }
+        // CIRCUITPY-CHANGE
+        #if MICROPY_GC_NURSERY
+        if (gc_in_nursery((void *)PTR_FROM_BLOCK(area, block + new_blocks)) && (block + new_blocks) / BLOCKS_PER_ATB < MP_STATE_MEM(gc_nursery_last_free_atb_index)) {
+            MP_STATE_MEM(gc_nursery_last_free_atb_index) = (block + new_blocks) / BLOCKS_PER_ATB;
+        }
+        #endif
 
         GC_EXIT();
 
@@ -1222,6 +1674,11 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
 
         area->gc_last_used_block = MAX(area->gc_last_used_block, end_block);
 
+        // CIRCUITPY-CHANGE
+        #if MICROPY_GC_INCREMENTAL_SWEEP
+        gc_sweep_note_alloc(area, block, end_block - 1);
+        #endif
+
         GC_EXIT();
 
         #if MICROPY_GC_CONSERVATIVE_CLEAR
@@ -1289,6 +1746,10 @@ void gc_dump_info(const mp_print_t *print) {
 }
 
 void gc_dump_alloc_table(const mp_print_t *print) {
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_sweep_finish();
+    #endif
     GC_ENTER();
     static const size_t DUMP_BYTES_PER_LINE = 64;
     for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
@@ -64,6 +64,13 @@ void gc_collect_ptr(void *ptr);
 void gc_collect_root(void **ptrs, size_t len);
 void gc_collect_end(void);
 
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_INCREMENTAL_SWEEP
+// Sweeps the next slice of the heap if a sweep is in progress. Call this
+// periodically, such as from a background task, to finish sweeps sooner.
+void gc_collect_step(void);
+#endif
+
 // CIRCUITPY-CHANGE
 // Is the gc heap available?
 bool gc_alloc_possible(void);
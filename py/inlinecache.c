@@ -0,0 +1,337 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/inlinecache.h"
+#include "py/objfun.h"
+#include "py/objmodule.h"
+#include "py/objtype.h"
+#include "py/runtime.h"
+
+#if MICROPY_OPT_INLINE_CACHE
+
+// Every LOAD_ATTR, LOAD_METHOD and LOAD_GLOBAL call site gets its own entry,
+// remembering the type or map the name was last found in and the slot it was
+// found at. The entries of a function are kept with its bytecode, in a small
+// hash table hanging off the function object that is keyed by the offset of
+// the call site and grows as more sites are run. So, unlike the map lookup
+// cache, which is keyed on the name alone and shared by every map, call sites
+// never evict each other. Bytecode in flash and the .mpy format are unchanged.
+//
+// Entries are never trusted: a hit needs the live object to still have the
+// cached type or map and the slot to still hold the name. So entries never
+// have to be invalidated; after a map is resized, an attribute is deleted or
+// the object is freed they simply miss and are refilled. Entry keys do keep
+// the types and maps they point at alive for as long as the function is.
+
+// Given to functions whose table couldn't be allocated, so they don't keep
+// trying. Its one entry stays unused.
+static struct {
+    mp_inline_cache_t cache;
+    mp_inline_cache_entry_t entry[1];
+} inline_cache_none = { .cache = { .mask = 0, .used = UINT16_MAX } };
+
+// The table is grown once it is this full, which keeps probes short.
+#define INLINE_CACHE_MAX_USED(cache) (((cache)->mask + 1) / 4 * 3)
+#define INLINE_CACHE_MIN_SIZE (8)
+
+static mp_inline_cache_entry_t *inline_cache_probe(mp_inline_cache_t *cache, size_t site) {
+    // Call sites are at least two bytes apart.
+    size_t i = (site >> 1) & cache->mask;
+    for (;;) {
+        mp_inline_cache_entry_t *entry = &cache->entry[i];
+        if (entry->site == site || entry->site == 0) {
+            return entry;
+        }
+        i = (i + 1) & cache->mask;
+    }
+}
+
+static mp_inline_cache_t *inline_cache_new(const mp_inline_cache_t *old) {
+    size_t size = old == NULL ? INLINE_CACHE_MIN_SIZE : 2 * ((size_t)old->mask + 1);
+    if (size > UINT16_MAX) {
+        return NULL;
+    }
+    mp_inline_cache_t *cache = m_new_obj_var_maybe(mp_inline_cache_t, entry, mp_inline_cache_entry_t, size);
+    if (cache == NULL) {
+        return NULL;
+    }
+    memset(cache->entry, 0, size * sizeof(mp_inline_cache_entry_t));
+    cache->mask = size - 1;
+    cache->used = 0;
+    if (old != NULL) {
+        // The old table is left to the GC.
+        for (size_t i = 0; i <= old->mask; i++) {
+            if (old->entry[i].site != 0) {
+                *inline_cache_probe(cache, old->entry[i].site) = old->entry[i];
+            }
+        }
+        cache->used = old->used;
+    }
+    return cache;
+}
+
+// Returns the entry of the call site, which is unused (site 0) if the site
+// hasn't been run before, or NULL if there is no room for it.
+static mp_inline_cache_entry_t *inline_cache_entry(mp_obj_fun_bc_t *fun, const byte *site) {
+    size_t offset = site - fun->bytecode;
+    if (offset > UINT16_MAX) {
+        return NULL;
+    }
+    mp_inline_cache_t *cache = fun->inline_cache;
+    if (cache != NULL) {
+        mp_inline_cache_entry_t *entry = inline_cache_probe(cache, offset);
+        if (entry->site != 0 || cache->used < INLINE_CACHE_MAX_USED(cache)) {
+            return entry;
+        }
+        if (cache->used == UINT16_MAX) {
+            return NULL;
+        }
+    }
+    mp_inline_cache_t *grown = inline_cache_new(cache);
+    if (grown == NULL) {
+        if (cache == NULL) {
+            fun->inline_cache = &inline_cache_none.cache;
+        } else {
+            cache->used = UINT16_MAX;
+        }
+        return NULL;
+    }
+    fun->inline_cache = grown;
+    return inline_cache_probe(grown, offset);
+}
+
+static void inline_cache_claim(mp_obj_fun_bc_t *fun, mp_inline_cache_entry_t *entry, const byte *site) {
+    if (entry->site == 0) {
+        entry->site = site - fun->bytecode;
+        fun->inline_cache->used += 1;
+    }
+}
+
+static mp_map_elem_t *inline_cache_slot(const mp_inline_cache_entry_t *entry, const mp_map_t *map, qstr attr) {
+    if (entry->index < map->alloc) {
+        mp_map_elem_t *elem = &map->table[entry->index];
+        if (elem->key == MP_OBJ_NEW_QSTR(attr)) {
+            return elem;
+        }
+    }
+    return NULL;
+}
+
+static void inline_cache_set(mp_inline_cache_entry_t *entry, const void *key, const mp_map_t *map, const mp_map_elem_t *elem, mp_inline_cache_kind_t kind) {
+    size_t index = elem - map->table;
+    if (index > UINT16_MAX) {
+        return;
+    }
+    entry->key = key;
+    entry->index = index;
+    entry->kind = kind;
+}
+
+static mp_map_t *inline_cache_locals_map(const mp_obj_type_t *type) {
+    return &MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map;
+}
+
+// The key entries for obj are stored under, see mp_inline_cache_kind_t.
+static const void *inline_cache_key(mp_obj_t obj, const mp_obj_type_t *type) {
+    if (type == &mp_type_module) {
+        return &mp_obj_module_get_globals(obj)->map;
+    }
+    if (type == &mp_type_type) {
+        const mp_obj_type_t *self = MP_OBJ_TO_PTR(obj);
+        return MP_OBJ_TYPE_HAS_SLOT(self, locals_dict) ? inline_cache_locals_map(self) : NULL;
+    }
+    return type;
+}
+
+// Produces the same dest as mp_load_method_maybe would, but only when the
+// entry still matches; dest is left alone otherwise.
+static inline bool inline_cache_hit(const mp_inline_cache_entry_t *entry, const void *key, mp_obj_t obj, const mp_obj_type_t *type, qstr attr, mp_obj_t *dest) {
+    if (entry->key != key) {
+        return false;
+    }
+    mp_map_elem_t *elem;
+    switch (entry->kind) {
+        case MP_INLINE_CACHE_MEMBER: {
+            mp_obj_instance_t *self = MP_OBJ_TO_PTR(obj);
+            elem = inline_cache_slot(entry, &self->members, attr);
+            if (elem == NULL) {
+                return false;
+            }
+            dest[0] = elem->value;
+            dest[1] = MP_OBJ_NULL;
+            return true;
+        }
+        case MP_INLINE_CACHE_METHOD: {
+            if (type->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS) {
+                return false;
+            }
+            // An instance member with the same name hides the class attribute.
+            // Only types that have had such a member need to look.
+            mp_obj_instance_t *self = MP_OBJ_TO_PTR(obj);
+            if ((type->flags & MP_TYPE_FLAG_MEMBER_HIDES_LOCAL) && self->members.used != 0
+                && mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP) != NULL) {
+                return false;
+            }
+            elem = inline_cache_slot(entry, inline_cache_locals_map(type), attr);
+            if (elem == NULL) {
+                return false;
+            }
+            dest[1] = MP_OBJ_NULL;
+            mp_convert_member_lookup(obj, type, elem->value, dest);
+            return true;
+        }
+        case MP_INLINE_CACHE_NATIVE: {
+            elem = inline_cache_slot(entry, inline_cache_locals_map(type), attr);
+            if (elem == NULL) {
+                return false;
+            }
+            #if MICROPY_PY_BUILTINS_PROPERTY
+            if (mp_obj_is_type(elem->value, &mp_type_property) && (type->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS) == 0) {
+                return false;
+            }
+            #endif
+            dest[1] = MP_OBJ_NULL;
+            mp_convert_member_lookup(obj, type, elem->value, dest);
+            return true;
+        }
+        case MP_INLINE_CACHE_CLASS: {
+            if (type != &mp_type_type) {
+                return false;
+            }
+            elem = inline_cache_slot(entry, key, attr);
+            if (elem == NULL) {
+                return false;
+            }
+            dest[1] = MP_OBJ_NULL;
+            mp_convert_member_lookup(MP_OBJ_NULL, MP_OBJ_TO_PTR(obj), elem->value, dest);
+            return true;
+        }
+        case MP_INLINE_CACHE_MODULE: {
+            if (type != &mp_type_module) {
+                return false;
+            }
+            elem = inline_cache_slot(entry, key, attr);
+            if (elem == NULL) {
+                return false;
+            }
+            // Names found in the globals never reach the module's __getattr__,
+            // but still warn if they moved.
+            #if MICROPY_MODULE_WARN_MOVED_ATTR
+            mp_module_warn_moved_attr(MP_OBJ_TO_PTR(obj), attr);
+            #endif
+            dest[0] = elem->value;
+            dest[1] = MP_OBJ_NULL;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// Only names that mp_load_method_maybe finds with a single map lookup are
+// cached. Anything else is remembered as MP_INLINE_CACHE_NONE for the key so
+// the call site doesn't try again on every run.
+static void inline_cache_fill(mp_inline_cache_entry_t *entry, const void *key, mp_obj_t obj, const mp_obj_type_t *type, qstr attr) {
+    entry->key = key;
+    entry->kind = MP_INLINE_CACHE_NONE;
+
+    // Dunder names are special cased all through the runtime, so leave them to it.
+    if (key == NULL || strncmp(qstr_str(attr), "__", 2) == 0) {
+        return;
+    }
+
+    mp_map_t *map;
+    mp_inline_cache_kind_t kind;
+    mp_map_elem_t *elem;
+    if (mp_obj_is_instance_type(type)) {
+        mp_obj_instance_t *self = MP_OBJ_TO_PTR(obj);
+        map = &self->members;
+        kind = MP_INLINE_CACHE_MEMBER;
+        elem = mp_map_lookup(map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+        if (elem == NULL) {
+            // Class attributes are only cached from the instance's own class
+            // and when no descriptors need to be considered.
+            if ((type->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS) || !MP_OBJ_TYPE_HAS_SLOT(type, locals_dict)) {
+                return;
+            }
+            map = inline_cache_locals_map(type);
+            kind = MP_INLINE_CACHE_METHOD;
+            elem = mp_map_lookup(map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+        }
+    } else {
+        if (type == &mp_type_module) {
+            kind = MP_INLINE_CACHE_MODULE;
+        } else if (type == &mp_type_type) {
+            kind = MP_INLINE_CACHE_CLASS;
+        } else if (!MP_OBJ_TYPE_HAS_SLOT(type, attr) && MP_OBJ_TYPE_HAS_SLOT(type, locals_dict)) {
+            kind = MP_INLINE_CACHE_NATIVE;
+        } else {
+            return;
+        }
+        map = kind == MP_INLINE_CACHE_NATIVE ? inline_cache_locals_map(type) : (mp_map_t *)key;
+        elem = mp_map_lookup(map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+    }
+    if (elem != NULL) {
+        inline_cache_set(entry, key, map, elem, kind);
+    }
+}
+
+bool mp_inline_cache_load_method(mp_obj_fun_bc_t *fun, const byte *site, mp_obj_t obj, qstr attr, mp_obj_t *dest) {
+    // Small ints, qstrs and other immediate objects are left to the generic
+    // lookup, which saves a call to mp_obj_get_type here.
+    if (!mp_obj_is_obj(obj)) {
+        return false;
+    }
+    mp_inline_cache_entry_t *entry = inline_cache_entry(fun, site);
+    if (entry == NULL) {
+        return false;
+    }
+    const mp_obj_type_t *type = ((mp_obj_base_t *)MP_OBJ_TO_PTR(obj))->type;
+    const void *key = inline_cache_key(obj, type);
+    if (entry->site != 0) {
+        if (inline_cache_hit(entry, key, obj, type, attr, dest)) {
+            return true;
+        }
+        if (entry->kind == MP_INLINE_CACHE_NONE && entry->key == key) {
+            return false;
+        }
+    }
+    inline_cache_claim(fun, entry, site);
+    inline_cache_fill(entry, key, obj, type, attr);
+    return inline_cache_hit(entry, key, obj, type, attr, dest);
+}
+
+mp_obj_t mp_inline_cache_load_global(mp_obj_fun_bc_t *fun, const byte *site, qstr qst) {
+    mp_inline_cache_entry_t *entry = inline_cache_entry(fun, site);
+    if (entry == NULL) {
+        return mp_load_global(qst);
+    }
+    mp_map_t *globals_map = &mp_globals_get()->map;
+    if (entry->site != 0 && entry->key == globals_map) {
+        if (entry->kind == MP_INLINE_CACHE_GLOBAL) {
+            mp_map_elem_t *elem = inline_cache_slot(entry, globals_map, qst);
+            if (elem != NULL) {
+                return elem->value;
+            }
+        } else {
+            // Last time this was a builtin.
+            return mp_load_global(qst);
+        }
+    }
+    inline_cache_claim(fun, entry, site);
+    entry->key = globals_map;
+    entry->kind = MP_INLINE_CACHE_NONE;
+    mp_map_elem_t *elem = mp_map_lookup(globals_map, MP_OBJ_NEW_QSTR(qst), MP_MAP_LOOKUP);
+    if (elem == NULL) {
+        return mp_load_global(qst);
+    }
+    inline_cache_set(entry, globals_map, globals_map, elem, MP_INLINE_CACHE_GLOBAL);
+    return elem->value;
+}
+
+#endif // MICROPY_OPT_INLINE_CACHE
@@ -0,0 +1,42 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+struct _mp_obj_fun_bc_t;
+
+// Where a cached name was found, which decides what the entry key is and how
+// the slot value is turned into a result.
+typedef enum {
+    MP_INLINE_CACHE_NONE, // key is what the name can't be cached for
+    MP_INLINE_CACHE_MEMBER, // key is an instance type, slot is in the instance members
+    MP_INLINE_CACHE_METHOD, // key is an instance type, slot is in its locals dict
+    MP_INLINE_CACHE_NATIVE, // key is a native type, slot is in its locals dict
+    MP_INLINE_CACHE_CLASS, // key is the locals map of the type object being loaded from
+    MP_INLINE_CACHE_MODULE, // key is the globals map of the module being loaded from
+    MP_INLINE_CACHE_GLOBAL, // key is the current globals map
+} mp_inline_cache_kind_t;
+
+typedef struct _mp_inline_cache_entry_t {
+    const void *key;
+    uint16_t site; // offset of the call site in the bytecode, 0 if the entry is unused
+    uint16_t index;
+    uint8_t kind;
+} mp_inline_cache_entry_t;
+
+// The entries of one function, one per call site, found by bytecode offset.
+typedef struct _mp_inline_cache_t {
+    uint16_t mask; // number of entries - 1
+    uint16_t used;
+    mp_inline_cache_entry_t entry[];
+} mp_inline_cache_t;
+
+// Both look the name up through the entry for the call site of `fun` that
+// ends at `site` in its bytecode.
+bool mp_inline_cache_load_method(struct _mp_obj_fun_bc_t *fun, const byte *site, mp_obj_t obj, qstr attr, mp_obj_t *dest);
+mp_obj_t mp_inline_cache_load_global(struct _mp_obj_fun_bc_t *fun, const byte *site, qstr qst);
@@ -32,6 +32,8 @@
 #include "py/mpconfig.h"
 #include "py/misc.h"
 #include "py/runtime.h"
+// CIRCUITPY-CHANGE
+#include "py/gc.h"
 
 #if MICROPY_DEBUG_VERBOSE // print debugging info
 #define DEBUG_PRINT (1)
@@ -61,6 +63,141 @@
 #define MAP_CACHE_SET(index, pos)
 #endif
 
+// CIRCUITPY-CHANGE
+#if MICROPY_OPT_ROM_MAP_INDEX
+// Large const maps (module globals and class locals dicts) are ordered arrays
+// and would otherwise need a linear search on every lookup that misses the
+// caches. The first time such a map is searched, build a side index of its
+// slots sorted by key so later lookups can binary search. Const tables are
+// static and have no room for a pointer, so the indices live on the heap in a
+// small hash table keyed by the address of their map, and are dropped on soft
+// reset by mp_init().
+
+typedef struct _mp_rom_map_index_t {
+    const mp_map_t *map;
+    uint16_t order[];
+} mp_rom_map_index_t;
+
+typedef struct _mp_rom_map_index_table_t {
+    size_t alloc; // a power of two, kept at most half used
+    size_t used;
+    // Set once an index didn't fit in the heap, so a full heap doesn't cost
+    // an allocation attempt on every lookup.
+    bool full;
+    mp_rom_map_index_t *slots[];
+} mp_rom_map_index_table_t;
+
+// Used when not even the table fits.
+static const mp_rom_map_index_table_t rom_map_index_table_full = { .alloc = 0, .used = 0, .full = true };
+
+// Returns the slot holding the index of map, or the empty slot it would go in.
+static mp_rom_map_index_t **rom_map_index_slot(const mp_rom_map_index_table_t *table, const mp_map_t *map) {
+    size_t mask = table->alloc - 1;
+    size_t hash = (uintptr_t)map >> 4;
+    size_t pos = (hash ^ (hash >> 7)) & mask;
+    while (table->slots[pos] != NULL && table->slots[pos]->map != map) {
+        pos = (pos + 1) & mask;
+    }
+    return (mp_rom_map_index_t **)&table->slots[pos];
+}
+
+static mp_rom_map_index_table_t *rom_map_index_table_grow(mp_rom_map_index_table_t *old) {
+    size_t alloc = old == NULL ? 8 : old->alloc * 2;
+    mp_rom_map_index_table_t *table = m_new_obj_var_maybe(mp_rom_map_index_table_t, slots, mp_rom_map_index_t *, alloc);
+    if (table == NULL) {
+        return NULL;
+    }
+    table->alloc = alloc;
+    table->used = 0;
+    table->full = false;
+    memset(table->slots, 0, alloc * sizeof(mp_rom_map_index_t *));
+    if (old != NULL) {
+        for (size_t i = 0; i < old->alloc; i++) {
+            if (old->slots[i] != NULL) {
+                *rom_map_index_slot(table, old->slots[i]->map) = old->slots[i];
+            }
+        }
+        table->used = old->used;
+        m_del_var(mp_rom_map_index_table_t, slots, mp_rom_map_index_t *, old->alloc, old);
+    }
+    return table;
+}
+
+static const mp_rom_map_index_t *rom_map_index_get(const mp_map_t *map) {
+    mp_rom_map_index_table_t *table = MP_STATE_VM(rom_map_index_table);
+    if (table != NULL) {
+        if (table->used > 0) {
+            mp_rom_map_index_t *rom_index = *rom_map_index_slot(table, map);
+            if (rom_index != NULL) {
+                return rom_index;
+            }
+        }
+        if (table->full) {
+            return NULL;
+        }
+    }
+    if (map->used > UINT16_MAX || gc_is_locked() || !gc_alloc_possible()) {
+        return NULL;
+    }
+    if (table == NULL || (table->used + 1) * 2 > table->alloc) {
+        mp_rom_map_index_table_t *bigger = rom_map_index_table_grow(table);
+        if (bigger == NULL) {
+            if (table == NULL) {
+                MP_STATE_VM(rom_map_index_table) = (mp_rom_map_index_table_t *)&rom_map_index_table_full;
+            } else {
+                table->full = true;
+            }
+            return NULL;
+        }
+        table = bigger;
+        MP_STATE_VM(rom_map_index_table) = table;
+    }
+    mp_rom_map_index_t *rom_index = m_new_obj_var_maybe(mp_rom_map_index_t, order, uint16_t, map->used);
+    if (rom_index == NULL) {
+        table->full = true;
+        return NULL;
+    }
+    rom_index->map = map;
+    // Insertion sort keeps this small; it only runs once per map.
+    const mp_map_elem_t *table_elems = map->table;
+    for (size_t j = 0; j < map->used; j++) {
+        size_t k = j;
+        while (k > 0 && (uintptr_t)table_elems[rom_index->order[k - 1]].key > (uintptr_t)table_elems[j].key) {
+            rom_index->order[k] = rom_index->order[k - 1];
+            k--;
+        }
+        rom_index->order[k] = j;
+    }
+    *rom_map_index_slot(table, map) = rom_index;
+    table->used += 1;
+    return rom_index;
+}
+
+// The index is authoritative: if the key isn't found here it isn't in the map.
+static mp_map_elem_t *rom_map_index_lookup(const mp_map_t *map, const mp_rom_map_index_t *rom_index, mp_obj_t index) {
+    size_t lo = 0;
+    size_t hi = map->used;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if ((uintptr_t)map->table[rom_index->order[mid]].key < (uintptr_t)index) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < map->used) {
+        size_t pos = rom_index->order[lo];
+        if (map->table[pos].key == index) {
+            MAP_CACHE_SET(index, pos);
+            return &map->table[pos];
+        }
+    }
+    return NULL;
+}
+
+MP_REGISTER_ROOT_POINTER(struct _mp_rom_map_index_table_t *rom_map_index_table);
+#endif
+
 // This table of sizes is used to control the growth of hash tables.
 // The first set of sizes are chosen so the allocation fits exactly in a
 // 4-word GC block, and it's not so important for these small values to be
@@ -98,6 +235,8 @@ void mp_map_init(mp_map_t *map, size_t n) {
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 0;
     map->is_ordered = 0;
+    // CIRCUITPY-CHANGE
+    map->is_rom = 0;
 }
 
 void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
@@ -106,6 +245,8 @@ void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 1;
     map->is_ordered = 1;
+    // CIRCUITPY-CHANGE
+    map->is_rom = 0;
     map->table = (mp_map_elem_t *)table;
 }
 
@@ -190,6 +331,15 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
 
     // if the map is an ordered array then we must do a brute force linear search
     if (map->is_ordered) {
+        // CIRCUITPY-CHANGE: unless it is a large const map with a sorted index
+        #if MICROPY_OPT_ROM_MAP_INDEX
+        if (map->is_rom && compare_only_ptrs && map->used >= MICROPY_OPT_ROM_MAP_INDEX_MIN_SIZE) {
+            const mp_rom_map_index_t *rom_index = rom_map_index_get(map);
+            if (rom_index != NULL) {
+                return rom_map_index_lookup(map, rom_index, index);
+            }
+        }
+        #endif
         for (mp_map_elem_t *elem = &map->table[0], *top = &map->table[map->used]; elem < top; elem++) {
             if (elem->key == index || (!compare_only_ptrs && mp_obj_equal(elem->key, index))) {
                 #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
@@ -100,6 +100,31 @@ static mp_obj_t gc_threshold(size_t n_args, const mp_obj_t *args) {
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_threshold_obj, 0, 1, gc_threshold);
 #endif
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PY_GC_STATS
+// stats(): return a dict with the number of collections and their pause times
+static mp_obj_t gc_stats(void) {
+    mp_obj_t histogram = mp_obj_new_list(MICROPY_GC_PAUSE_HISTOGRAM_LEN, NULL);
+    for (size_t i = 0; i < MICROPY_GC_PAUSE_HISTOGRAM_LEN; i++) {
+        mp_obj_list_store(histogram, MP_OBJ_NEW_SMALL_INT(i), mp_obj_new_int_from_uint(MP_STATE_MEM(gc_pause_histogram)[i]));
+    }
+    mp_obj_t stats = mp_obj_new_dict(7);
+    mp_obj_dict_store(stats, MP_OBJ_NEW_QSTR(MP_QSTR_collections), mp_obj_new_int_from_uint(MP_STATE_MEM(gc_collections)));
+    #if MICROPY_GC_NURSERY
+    mp_obj_dict_store(stats, MP_OBJ_NEW_QSTR(MP_QSTR_minor_collections), mp_obj_new_int_from_uint(MP_STATE_MEM(gc_minor_collections)));
+    #endif
+    mp_obj_dict_store(stats, MP_OBJ_NEW_QSTR(MP_QSTR_max_pause_us), mp_obj_new_int_from_uint(MP_STATE_MEM(gc_pause_max_us)));
+    mp_obj_dict_store(stats, MP_OBJ_NEW_QSTR(MP_QSTR_pause_histogram), histogram);
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    mp_obj_dict_store(stats, MP_OBJ_NEW_QSTR(MP_QSTR_sweep_budget), MP_OBJ_NEW_SMALL_INT(MICROPY_GC_INCREMENTAL_SWEEP_BUDGET));
+    mp_obj_dict_store(stats, MP_OBJ_NEW_QSTR(MP_QSTR_sweep_slices), mp_obj_new_int_from_uint(MP_STATE_MEM(gc_sweep_slices)));
+    mp_obj_dict_store(stats, MP_OBJ_NEW_QSTR(MP_QSTR_max_slice_us), mp_obj_new_int_from_uint(MP_STATE_MEM(gc_sweep_slice_max_us)));
+    #endif
+    return stats;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(gc_stats_obj, gc_stats);
+#endif
+
 static const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_gc) },
     { MP_ROM_QSTR(MP_QSTR_collect), MP_ROM_PTR(&gc_collect_obj) },
@@ -111,6 +136,10 @@ static const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     #if MICROPY_GC_ALLOC_THRESHOLD
     { MP_ROM_QSTR(MP_QSTR_threshold), MP_ROM_PTR(&gc_threshold_obj) },
     #endif
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_GC_STATS
+    { MP_ROM_QSTR(MP_QSTR_stats), MP_ROM_PTR(&gc_stats_obj) },
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(mp_module_gc_globals, mp_module_gc_globals_table);
@@ -171,6 +171,9 @@ static void *thread_entry(void *args_in) {
     // CIRCUITPY-CHANGE
     // The GC starts off unlocked on this thread.
     ts.gc_lock_depth = 0;
+    #if MICROPY_GC_NURSERY
+    ts.gc_minor_requested = false;
+    #endif
 
     ts.nlr_jump_callback_top = NULL;
     ts.mp_pending_exception = MP_OBJ_NULL;
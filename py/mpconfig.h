@@ -593,6 +593,55 @@
 #define MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE (128)
 #endif
 
+// CIRCUITPY-CHANGE
+// Use extra RAM to remember, for each LOAD_ATTR/LOAD_METHOD/LOAD_GLOBAL call
+// site, which type or map the name was last found in and at which slot. Hits
+// skip the generic attribute lookup and the map search entirely. Each function
+// that runs such a call site gets a table with about two entries, of 3 words
+// each, per call site it has run.
+#ifndef MICROPY_OPT_INLINE_CACHE
+#define MICROPY_OPT_INLINE_CACHE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// CIRCUITPY-CHANGE
+// Do arithmetic and comparisons on small ints and floats directly in the VM
+// loop, falling back to mp_binary_op for other types. Speeds up numeric loops
+// at the cost of some code size.
+#ifndef MICROPY_OPT_VM_BINARY_OP_FAST_PATH
+#define MICROPY_OPT_VM_BINARY_OP_FAST_PATH (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// CIRCUITPY-CHANGE
+// Build a sorted side index for large const (ROM) maps the first time they
+// are searched, so lookups binary search instead of scanning linearly. The
+// indices are kept on the heap until soft reset: 2 bytes per map entry, plus
+// two pointers in a hash table from map to index. There is no fixed limit on
+// how many maps get one; once an index doesn't fit in the heap, no more are
+// built until soft reset and the remaining maps are searched linearly.
+#ifndef MICROPY_OPT_ROM_MAP_INDEX
+#define MICROPY_OPT_ROM_MAP_INDEX (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// Const maps with fewer entries than this are still searched linearly, and
+// never look for an index.
+#ifndef MICROPY_OPT_ROM_MAP_INDEX_MIN_SIZE
+#define MICROPY_OPT_ROM_MAP_INDEX_MIN_SIZE (16)
+#endif
+
+// CIRCUITPY-CHANGE
+// Keep an open-addressing hash index over the qstrs interned at runtime, so
+// qstr_find_strn doesn't search the dynamic pools linearly. Costs 2 bytes of
+// heap per table slot; see MICROPY_OPT_QSTR_INDEX_LOAD_PERCENT.
+#ifndef MICROPY_OPT_QSTR_INDEX
+#define MICROPY_OPT_QSTR_INDEX (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// How full (in percent) the qstr index may get before it doubles in size.
+// Lower values mean shorter probe sequences but more RAM.
+#ifndef MICROPY_OPT_QSTR_INDEX_LOAD_PERCENT
+#define MICROPY_OPT_QSTR_INDEX_LOAD_PERCENT (75)
+#endif
+
 // Whether to use fast versions of bitwise operations (and, or, xor) when the
 // arguments are both positive.  Increases Thumb2 code size by about 250 bytes.
 #ifndef MICROPY_OPT_MPZ_BITWISE
@@ -679,6 +728,42 @@
 #define MICROPY_GC_SPLIT_HEAP_AUTO (0)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether to keep part of the first heap area as a nursery for small
+// allocations. When the nursery fills up, a minor collection frees only the
+// nursery: it traces the roots and the nursery, and finds pointers from the
+// rest of the heap with a linear scan instead of tracing it. Loops that make
+// lots of short-lived objects then see many short pauses instead of a few
+// full collections.
+#ifndef MICROPY_GC_NURSERY
+#define MICROPY_GC_NURSERY (0)
+#endif
+
+// The nursery is 1/MICROPY_GC_NURSERY_DIVISOR of the first heap area.
+#ifndef MICROPY_GC_NURSERY_DIVISOR
+#define MICROPY_GC_NURSERY_DIVISOR (8)
+#endif
+
+// Allocations of at most this many blocks go to the nursery.
+#ifndef MICROPY_GC_NURSERY_MAX_BLOCKS
+#define MICROPY_GC_NURSERY_MAX_BLOCKS (4)
+#endif
+
+// CIRCUITPY-CHANGE
+// Whether to sweep the heap a slice at a time after a full collection, rather
+// than all at once. The first slice runs straight after marking and the rest
+// from gc_alloc() and gc_collect_step(); blocks the sweep hasn't reached yet
+// are still marked. Marking itself always runs to completion, since there is
+// no write barrier to keep it correct if the VM ran in between.
+#ifndef MICROPY_GC_INCREMENTAL_SWEEP
+#define MICROPY_GC_INCREMENTAL_SWEEP (0)
+#endif
+
+// Number of blocks that each slice of an incremental sweep covers.
+#ifndef MICROPY_GC_INCREMENTAL_SWEEP_BUDGET
+#define MICROPY_GC_INCREMENTAL_SWEEP_BUDGET (1024)
+#endif
+
 // Hook to run code during time consuming garbage collector operations
 // *i* is the loop index variable (e.g. can be used to run every x loops)
 #ifndef MICROPY_GC_HOOK_LOOP
@@ -1448,6 +1533,18 @@ typedef double mp_float_t;
 #define MICROPY_PY_GC_COLLECT_RETVAL (0)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether to provide gc.stats(), which counts collections and keeps a
+// histogram of how long they paused the VM. Needs mp_hal_ticks_us().
+#ifndef MICROPY_PY_GC_STATS
+#define MICROPY_PY_GC_STATS (0)
+#endif
+
+// Number of power-of-two buckets in the gc.stats() pause histogram.
+#ifndef MICROPY_GC_PAUSE_HISTOGRAM_LEN
+#define MICROPY_GC_PAUSE_HISTOGRAM_LEN (16)
+#endif
+
 // Whether to provide "io" module
 #ifndef MICROPY_PY_IO
 #define MICROPY_PY_IO (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
@@ -107,6 +107,18 @@ typedef struct _mp_state_mem_area_t {
     size_t gc_last_used_block; // The block ID of the highest block allocated in the area
 } mp_state_mem_area_t;
 
+// CIRCUITPY-CHANGE
+// How far a sweep has got, so that it can be done a slice at a time.
+typedef struct _mp_state_gc_sweep_t {
+    mp_state_mem_area_t *area; // NULL once the sweep is done
+    size_t block;
+    size_t last_used_block;
+    #if MICROPY_GC_SPLIT_HEAP_AUTO
+    mp_state_mem_area_t *prev_area;
+    #endif
+    bool free_tail;
+} mp_state_gc_sweep_t;
+
 // This structure hold information about the memory allocation system.
 typedef struct _mp_state_mem_t {
     #if MICROPY_MEM_STATS
@@ -142,6 +154,38 @@ typedef struct _mp_state_mem_t {
     size_t gc_collected;
     #endif
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    // Part of the first area that small allocations are made in, and whether
+    // it's too full to use until the next full collection. gc_collecting_minor
+    // is set while a collection that only frees nursery blocks is in progress,
+    // and is only changed with the GC lock held.
+    byte *gc_nursery_start;
+    byte *gc_nursery_end;
+    size_t gc_nursery_last_free_atb_index;
+    bool gc_nursery_full;
+    bool gc_collecting_minor;
+    #endif
+
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // The sweep left over from the last full collection.
+    mp_state_gc_sweep_t gc_sweep;
+    #endif
+
+    #if MICROPY_PY_GC_STATS
+    mp_uint_t gc_pause_start_us;
+    mp_uint_t gc_pause_max_us;
+    size_t gc_collections;
+    size_t gc_minor_collections;
+    // Bucket i counts pauses shorter than 2**i microseconds (and at least
+    // 2**(i-1)); the last one also counts everything longer.
+    size_t gc_pause_histogram[MICROPY_GC_PAUSE_HISTOGRAM_LEN];
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    size_t gc_sweep_slices;
+    mp_uint_t gc_sweep_slice_max_us;
+    #endif
+    #endif
+
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
     // This is a global mutex used to make the GC thread-safe.
     mp_thread_mutex_t gc_mutex;
@@ -160,6 +204,12 @@ typedef struct _mp_state_vm_t {
 
     qstr_pool_t *last_pool;
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_QSTR_INDEX
+    // hash table of runtime qstr ids, see qstr_find_strn
+    qstr_short_t *qstr_index;
+    #endif
+
     #if MICROPY_TRACKED_ALLOC
     struct _m_tracked_node_t *m_tracked_head;
     #endif
@@ -219,6 +269,14 @@ typedef struct _mp_state_vm_t {
     size_t qstr_last_alloc;
     size_t qstr_last_used;
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_QSTR_INDEX
+    size_t qstr_index_alloc;
+    size_t qstr_index_used;
+    // runtime qstrs below this id are in qstr_index, the rest are not (yet)
+    qstr qstr_index_top;
+    #endif
+
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
     // This is a global mutex used to make qstr interning thread-safe.
     mp_thread_mutex_t qstr_mutex;
@@ -294,6 +352,13 @@ typedef struct _mp_state_thread_t {
     // Locking of the GC is done per thread.
     uint16_t gc_lock_depth;
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    // Set by a thread that wants its next collection to be a minor one.
+    // gc_collect_start takes it once it holds the GC lock.
+    bool gc_minor_requested;
+    #endif
+
     ////////////////////////////////////////////////////////////
     // START ROOT POINTER SECTION
     // Everything that needs GC scanning must start here, and
@@ -404,6 +404,7 @@ typedef struct _mp_rom_obj_t { mp_const_obj_t o; } mp_rom_obj_t;
         .all_keys_are_qstrs = 1, \
         .is_fixed = 1, \
         .is_ordered = 1, \
+        .is_rom = 1, \
         .used = MP_ARRAY_SIZE(table_name), \
         .alloc = MP_ARRAY_SIZE(table_name), \
         .table = (mp_map_elem_t *)(mp_rom_map_elem_t *)table_name, \
@@ -416,6 +417,7 @@ typedef struct _mp_rom_obj_t { mp_const_obj_t o; } mp_rom_obj_t;
             .all_keys_are_qstrs = 1, \
             .is_fixed = 1, \
             .is_ordered = 1, \
+            .is_rom = 1, \
             .used = n, \
             .alloc = n, \
             .table = (mp_map_elem_t *)(mp_rom_map_elem_t *)table_name, \
@@ -495,7 +497,9 @@ typedef struct _mp_map_t {
     size_t all_keys_are_qstrs : 1;
     size_t is_fixed : 1;    // if set, table is fixed/read-only and can't be modified
     size_t is_ordered : 1;  // if set, table is an ordered array, not a hash map
-    size_t used : (8 * sizeof(size_t) - 3);
+    // CIRCUITPY-CHANGE: set for const maps whose keys never change, see MICROPY_OPT_ROM_MAP_INDEX
+    size_t is_rom : 1;
+    size_t used : (8 * sizeof(size_t) - 4);
     size_t alloc;
     mp_map_elem_t *table;
 } mp_map_t;
@@ -583,6 +587,9 @@ typedef mp_obj_t (*mp_fun_kw_t)(size_t n, const mp_obj_t *, mp_map_t *);
 #define MP_TYPE_FLAG_INSTANCE_TYPE (0x0200)
 // CIRCUITPY-CHANGE: check for valid types in json dumps
 #define MP_TYPE_FLAG_PRINT_JSON (0x0400)
+// CIRCUITPY-CHANGE: set once an instance member may hide an attribute in the
+// type's own locals dict, see py/inlinecache.c
+#define MP_TYPE_FLAG_MEMBER_HIDES_LOCAL (0x0800)
 
 typedef enum {
     PRINT_STR = 0,
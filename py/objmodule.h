@@ -41,4 +41,10 @@ mp_obj_t mp_module_get_builtin(qstr module_name, bool extensible);
 
 void mp_module_generic_attr(qstr attr, mp_obj_t *dest, const uint16_t *keys, mp_obj_t *values);
 
+// CIRCUITPY-CHANGE: loading a name from the module it moved out of warns
+#define MICROPY_MODULE_WARN_MOVED_ATTR (CIRCUITPY_8_9_WARNINGS && CIRCUITPY_DISPLAYIO && CIRCUITPY_WARNINGS)
+#if MICROPY_MODULE_WARN_MOVED_ATTR
+void mp_module_warn_moved_attr(const mp_obj_module_t *self, qstr attr);
+#endif
+
 #endif // MICROPY_INCLUDED_PY_OBJMODULE_H
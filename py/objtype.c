@@ -705,6 +705,24 @@ static void mp_obj_instance_load_attr(mp_obj_t self_in, qstr attr, mp_obj_t *des
     }
 }
 
+// CIRCUITPY-CHANGE
+void mp_obj_instance_store_member(mp_obj_instance_t *self, mp_obj_t attr, mp_obj_t value) {
+    #if MICROPY_OPT_INLINE_CACHE
+    size_t used = self->members.used;
+    #endif
+    mp_map_lookup(&self->members, attr, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+    #if MICROPY_OPT_INLINE_CACHE
+    // A new member that hides an attribute of the class means instances of it
+    // can no longer be assumed to take that attribute from the class.
+    mp_obj_type_t *type = (mp_obj_type_t *)self->base.type;
+    if (self->members.used != used && !(type->flags & MP_TYPE_FLAG_MEMBER_HIDES_LOCAL)
+        && MP_OBJ_TYPE_HAS_SLOT(type, locals_dict)
+        && mp_map_lookup(&MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map, attr, MP_MAP_LOOKUP) != NULL) {
+        type->flags |= MP_TYPE_FLAG_MEMBER_HIDES_LOCAL;
+    }
+    #endif
+}
+
 static bool mp_obj_instance_store_attr(mp_obj_t self_in, qstr attr, mp_obj_t value) {
     mp_obj_instance_t *self = MP_OBJ_TO_PTR(self_in);
 
@@ -825,7 +843,8 @@ skip_special_accessors:
         return elem != NULL;
     } else {
         // store attribute
-        mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+        // CIRCUITPY-CHANGE
+        mp_obj_instance_store_member(self, MP_OBJ_NEW_QSTR(attr), value);
         return true;
     }
 }
@@ -1130,8 +1149,18 @@ static void type_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
                 #endif
 
                 // store attribute
+                // CIRCUITPY-CHANGE
+                #if MICROPY_OPT_INLINE_CACHE
+                size_t used = locals_map->used;
+                #endif
                 mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
                 elem->value = dest[1];
+                #if MICROPY_OPT_INLINE_CACHE
+                // Instances may already have a member of the new name.
+                if (locals_map->used != used) {
+                    self->flags |= MP_TYPE_FLAG_MEMBER_HIDES_LOCAL;
+                }
+                #endif
                 dest[0] = MP_OBJ_NULL; // indicate success
             }
         }
@@ -148,6 +148,7 @@ PY_CORE_O_BASENAME = $(addprefix py/,\
 	warning.o \
 	profile.o \
 	map.o \
+	inlinecache.o \
 	obj.o \
 	objarray.o \
 	objattrtuple.o \
@@ -311,6 +312,8 @@ endif
 
 ifeq ($(SUPEROPT_VM),1)
 $(PY_BUILD)/vm.o: CFLAGS += $(CSUPEROPT)
+# CIRCUITPY-CHANGE: the call site cache is part of the VM's hot path
+$(PY_BUILD)/inlinecache.o: CFLAGS += $(CSUPEROPT)
 endif
 
 # Optimizing vm.o for modern deeply pipelined CPUs with branch predictors
@@ -60,13 +60,17 @@
 // allocated pool is twice this size.  The value here must be <= MP_QSTRnumber_of.
 #define MICROPY_ALLOC_QSTR_ENTRIES_INIT (10)
 
-// this must match the equivalent function in makeqstrdata.py
-size_t qstr_compute_hash(const byte *data, size_t len) {
+// CIRCUITPY-CHANGE: split out so the qstr index can use all bits of the hash
+static size_t qstr_compute_hash_full(const byte *data, size_t len) {
     // djb2 algorithm; see http://www.cse.yorku.ca/~oz/hash.html
     size_t hash = 5381;
     for (const byte *top = data + len; data < top; data++) {
         hash = ((hash << 5) + hash) ^ (*data); // hash * 33 ^ data
     }
+    return hash;
+}
+
+static size_t qstr_mask_hash(size_t hash) {
     hash &= Q_HASH_MASK;
     // Make sure that valid hash is never zero, zero means "hash not computed"
     if (hash == 0) {
@@ -75,6 +79,11 @@ size_t qstr_compute_hash(const byte *data, size_t len) {
     return hash;
 }
 
+// this must match the equivalent function in makeqstrdata.py
+size_t qstr_compute_hash(const byte *data, size_t len) {
+    return qstr_mask_hash(qstr_compute_hash_full(data, len));
+}
+
 // The first pool is the static qstr table. The contents must remain stable as
 // it is part of the .mpy ABI. See the top of py/persistentcode.c and
 // static_qstr_list in makeqstrdata.py. This pool is unsorted (although in a
@@ -206,6 +215,12 @@ extern const qstr_pool_t MICROPY_QSTR_EXTRA_POOL;
 void qstr_reset(void) {
     MP_STATE_VM(last_pool) = (qstr_pool_t *)&CONST_POOL; // we won't modify the const_pool since it has no allocated room left
     MP_STATE_VM(qstr_last_chunk) = NULL;
+    #if MICROPY_OPT_QSTR_INDEX
+    MP_STATE_VM(qstr_index) = NULL;
+    MP_STATE_VM(qstr_index_alloc) = 0;
+    MP_STATE_VM(qstr_index_used) = 0;
+    MP_STATE_VM(qstr_index_top) = QSTR_TOTAL();
+    #endif
 }
 
 void qstr_init(void) {
@@ -228,6 +243,89 @@ static const qstr_pool_t *find_qstr(qstr *q) {
     return pool;
 }
 
+static bool qstr_pool_entry_equals(const qstr_pool_t *pool, size_t at, const char *str, size_t str_len, size_t str_hash) {
+    #if MICROPY_QSTR_BYTES_IN_HASH
+    if (pool->hashes[at] != str_hash) {
+        return false;
+    }
+    #else
+    (void)str_hash;
+    #endif
+    return pool->lengths[at] == str_len && memcmp(pool->qstrs[at], str, str_len) == 0;
+}
+
+// CIRCUITPY-CHANGE
+#if MICROPY_OPT_QSTR_INDEX
+// The qstrs interned at runtime (everything after CONST_POOL) are tracked by
+// a linear-probing hash table of ids, keyed on the full-width qstr hash.
+// Every runtime qstr with an id below qstr_index_top is in the table. If the
+// table can't grow (heap full or locked) newer qstrs are left out and
+// searched linearly until a later qstr_add catches the table up.
+
+static qstr qstr_index_find(const char *str, size_t str_len, size_t full_hash, size_t str_hash) {
+    if (MP_STATE_VM(qstr_index) == NULL) {
+        return MP_QSTRnull;
+    }
+    size_t mask = MP_STATE_VM(qstr_index_alloc) - 1;
+    for (size_t pos = full_hash & mask;; pos = (pos + 1) & mask) {
+        qstr q = MP_STATE_VM(qstr_index)[pos];
+        if (q == MP_QSTRnull) {
+            return MP_QSTRnull;
+        }
+        size_t at = q;
+        const qstr_pool_t *pool = find_qstr(&at);
+        if (qstr_pool_entry_equals(pool, at, str, str_len, str_hash)) {
+            return q;
+        }
+    }
+}
+
+static void qstr_index_insert(qstr_short_t *table, size_t alloc, qstr q) {
+    size_t len;
+    const byte *data = qstr_data(q, &len);
+    size_t pos = qstr_compute_hash_full(data, len) & (alloc - 1);
+    while (table[pos] != MP_QSTRnull) {
+        pos = (pos + 1) & (alloc - 1);
+    }
+    table[pos] = q;
+}
+
+// qstr_mutex must be taken while in this function
+static void qstr_index_update(void) {
+    while (MP_STATE_VM(qstr_index_top) < QSTR_TOTAL()) {
+        qstr q = MP_STATE_VM(qstr_index_top);
+        if (q > (qstr_short_t)-1) {
+            // doesn't fit in a table entry
+            return;
+        }
+        size_t alloc = MP_STATE_VM(qstr_index_alloc);
+        if ((MP_STATE_VM(qstr_index_used) + 1) * 100 > alloc * MICROPY_OPT_QSTR_INDEX_LOAD_PERCENT) {
+            size_t new_alloc = alloc ? alloc * 2 : 32;
+            if (gc_is_locked()) {
+                return;
+            }
+            qstr_short_t *new_table = m_new_maybe(qstr_short_t, new_alloc);
+            if (new_table == NULL) {
+                return;
+            }
+            memset(new_table, 0, new_alloc * sizeof(qstr_short_t));
+            qstr_short_t *old_table = MP_STATE_VM(qstr_index);
+            for (size_t i = 0; i < alloc; i++) {
+                if (old_table[i] != MP_QSTRnull) {
+                    qstr_index_insert(new_table, new_alloc, old_table[i]);
+                }
+            }
+            m_del(qstr_short_t, old_table, alloc);
+            MP_STATE_VM(qstr_index) = new_table;
+            MP_STATE_VM(qstr_index_alloc) = new_alloc;
+        }
+        qstr_index_insert(MP_STATE_VM(qstr_index), MP_STATE_VM(qstr_index_alloc), q);
+        MP_STATE_VM(qstr_index_used) += 1;
+        MP_STATE_VM(qstr_index_top) = q + 1;
+    }
+}
+#endif
+
 // qstr_mutex must be taken while in this function
 static qstr qstr_add(mp_uint_t len, const char *q_ptr) {
     #if MICROPY_QSTR_BYTES_IN_HASH
@@ -284,6 +382,11 @@ static qstr qstr_add(mp_uint_t len, const char *q_ptr) {
     MP_STATE_VM(last_pool)->qstrs[at] = q_ptr;
     MP_STATE_VM(last_pool)->len++;
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_QSTR_INDEX
+    qstr_index_update();
+    #endif
+
     // return id for the newly-added qstr
     return MP_STATE_VM(last_pool)->total_prev_len + at;
 }
@@ -294,9 +397,19 @@ qstr qstr_find_strn(const char *str, size_t str_len) {
         return MP_QSTR_;
     }
 
-    #if MICROPY_QSTR_BYTES_IN_HASH
+    // CIRCUITPY-CHANGE: use the index for runtime qstrs
+    #if MICROPY_OPT_QSTR_INDEX
+    size_t full_hash = qstr_compute_hash_full((const byte *)str, str_len);
+    size_t str_hash = qstr_mask_hash(full_hash);
+    qstr q = qstr_index_find(str, str_len, full_hash, str_hash);
+    if (q != MP_QSTRnull) {
+        return q;
+    }
+    #elif MICROPY_QSTR_BYTES_IN_HASH
     // work out hash of str
     size_t str_hash = qstr_compute_hash((const byte *)str, str_len);
+    #else
+    size_t str_hash = 0;
     #endif
 
     // search pools for the data
@@ -304,6 +417,19 @@ qstr qstr_find_strn(const char *str, size_t str_len) {
         size_t low = 0;
         size_t high = pool->len - 1;
 
+        // CIRCUITPY-CHANGE: only search runtime qstrs the index doesn't cover
+        #if MICROPY_OPT_QSTR_INDEX
+        if (pool->total_prev_len >= CONST_POOL.total_prev_len + CONST_POOL.len) {
+            size_t top = MP_STATE_VM(qstr_index_top);
+            if (pool->total_prev_len + pool->len <= top) {
+                continue;
+            }
+            if (top > pool->total_prev_len) {
+                low = top - pool->total_prev_len;
+            }
+        }
+        #endif
+
         // binary search inside the pool
         if (pool->is_sorted) {
             while (high - low > 1) {
@@ -319,12 +445,7 @@ qstr qstr_find_strn(const char *str, size_t str_len) {
 
         // sequential search for the remaining strings
         for (mp_uint_t at = low; at < high + 1; at++) {
-            if (
-                #if MICROPY_QSTR_BYTES_IN_HASH
-                pool->hashes[at] == str_hash &&
-                #endif
-                pool->lengths[at] == str_len
-                && memcmp(pool->qstrs[at], str, str_len) == 0) {
+            if (qstr_pool_entry_equals(pool, at, str, str_len, str_hash)) {
                 return pool->total_prev_len + at;
             }
         }
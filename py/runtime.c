@@ -134,6 +134,12 @@ void mp_init(void) {
     MP_STATE_VM(track_reloc_code_list) = MP_OBJ_NULL;
     #endif
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_ROM_MAP_INDEX
+    // indices from before a soft reset were on the old heap
+    MP_STATE_VM(rom_map_index_table) = NULL;
+    #endif
+
     #if MICROPY_PY_OS_DUPTERM
     for (size_t i = 0; i < MICROPY_PY_OS_DUPTERM; ++i) {
         MP_STATE_VM(dupterm_objs[i]) = MP_OBJ_NULL;
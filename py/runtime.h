@@ -193,6 +193,10 @@ static inline void mp_thread_init_state(mp_state_thread_t *ts, size_t stack_size
 
     // GC starts off unlocked
     ts->gc_lock_depth = 0;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    ts->gc_minor_requested = false;
+    #endif
 
     // There are no pending jump callbacks or exceptions yet
     ts->nlr_jump_callback_top = NULL;
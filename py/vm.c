@@ -35,6 +35,9 @@
 #include "py/runtime.h"
 #include "py/bc0.h"
 #include "py/profile.h"
+// CIRCUITPY-CHANGE
+#include "py/inlinecache.h"
+#include "py/smallint.h"
 
 // *FORMAT-OFF*
 
@@ -205,6 +208,99 @@ static mp_obj_t get_active_exception(mp_exc_stack_t *exc_sp, mp_exc_stack_t *exc
     return MP_OBJ_NULL;
 }
 
+// CIRCUITPY-CHANGE
+#if MICROPY_OPT_VM_BINARY_OP_FAST_PATH
+// Does the most common arithmetic and comparisons on two small ints, or on
+// floats mixed with small ints, without the type dispatch in mp_binary_op.
+// Returns MP_OBJ_NULL for anything else (other types, other ops, overflow,
+// division by zero) so the caller can fall back to mp_binary_op.
+static inline mp_obj_t vm_binary_op_fast(mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs) {
+    if (mp_obj_is_small_int(lhs) && mp_obj_is_small_int(rhs)) {
+        mp_int_t l = MP_OBJ_SMALL_INT_VALUE(lhs);
+        mp_int_t r = MP_OBJ_SMALL_INT_VALUE(rhs);
+        switch (op) {
+            case MP_BINARY_OP_ADD:
+            case MP_BINARY_OP_INPLACE_ADD:
+                l += r;
+                return MP_SMALL_INT_FITS(l) ? MP_OBJ_NEW_SMALL_INT(l) : MP_OBJ_NULL;
+            case MP_BINARY_OP_SUBTRACT:
+            case MP_BINARY_OP_INPLACE_SUBTRACT:
+                l -= r;
+                return MP_SMALL_INT_FITS(l) ? MP_OBJ_NEW_SMALL_INT(l) : MP_OBJ_NULL;
+            case MP_BINARY_OP_LESS:
+                return mp_obj_new_bool(l < r);
+            case MP_BINARY_OP_MORE:
+                return mp_obj_new_bool(l > r);
+            case MP_BINARY_OP_EQUAL:
+                return mp_obj_new_bool(l == r);
+            case MP_BINARY_OP_LESS_EQUAL:
+                return mp_obj_new_bool(l <= r);
+            case MP_BINARY_OP_MORE_EQUAL:
+                return mp_obj_new_bool(l >= r);
+            case MP_BINARY_OP_NOT_EQUAL:
+                return mp_obj_new_bool(l != r);
+            default:
+                return MP_OBJ_NULL;
+        }
+    }
+    #if MICROPY_PY_BUILTINS_FLOAT
+    mp_float_t l;
+    mp_float_t r;
+    if (mp_obj_is_float(lhs)) {
+        l = mp_obj_float_get(lhs);
+    } else if (mp_obj_is_small_int(lhs)) {
+        l = (mp_float_t)MP_OBJ_SMALL_INT_VALUE(lhs);
+    } else {
+        return MP_OBJ_NULL;
+    }
+    if (mp_obj_is_float(rhs)) {
+        r = mp_obj_float_get(rhs);
+    } else if (mp_obj_is_small_int(rhs)) {
+        r = (mp_float_t)MP_OBJ_SMALL_INT_VALUE(rhs);
+    } else {
+        return MP_OBJ_NULL;
+    }
+    switch (op) {
+        case MP_BINARY_OP_ADD:
+        case MP_BINARY_OP_INPLACE_ADD:
+            return mp_obj_new_float(l + r);
+        case MP_BINARY_OP_SUBTRACT:
+        case MP_BINARY_OP_INPLACE_SUBTRACT:
+            return mp_obj_new_float(l - r);
+        case MP_BINARY_OP_MULTIPLY:
+        case MP_BINARY_OP_INPLACE_MULTIPLY:
+            return mp_obj_new_float(l * r);
+        case MP_BINARY_OP_TRUE_DIVIDE:
+        case MP_BINARY_OP_INPLACE_TRUE_DIVIDE:
+            // Let mp_binary_op raise ZeroDivisionError.
+            return r == 0 ? MP_OBJ_NULL : mp_obj_new_float(l / r);
+        case MP_BINARY_OP_LESS:
+            return mp_obj_new_bool(l < r);
+        case MP_BINARY_OP_MORE:
+            return mp_obj_new_bool(l > r);
+        case MP_BINARY_OP_LESS_EQUAL:
+            return mp_obj_new_bool(l <= r);
+        case MP_BINARY_OP_MORE_EQUAL:
+            return mp_obj_new_bool(l >= r);
+        default:
+            return MP_OBJ_NULL;
+    }
+    #else
+    return MP_OBJ_NULL;
+    #endif
+}
+
+static inline mp_obj_t vm_binary_op(mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs) {
+    mp_obj_t result = vm_binary_op_fast(op, lhs, rhs);
+    if (result == MP_OBJ_NULL) {
+        result = mp_binary_op(op, lhs, rhs);
+    }
+    return result;
+}
+#else
+#define vm_binary_op mp_binary_op
+#endif
+
 // fastn has items in reverse order (fastn[0] is local[0], fastn[-1] is local[1], etc)
 // sp points to bottom of stack which grows up
 // returns:
@@ -410,7 +506,12 @@ dispatch_loop:
                 ENTRY(MP_BC_LOAD_GLOBAL): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
+                    // CIRCUITPY-CHANGE
+                    #if MICROPY_OPT_INLINE_CACHE
+                    PUSH(mp_inline_cache_load_global(code_state->fun_bc, ip, qst));
+                    #else
                     PUSH(mp_load_global(qst));
+                    #endif
                     DISPATCH();
                 }
 
@@ -420,7 +521,15 @@ dispatch_loop:
                     DECODE_QSTR;
                     mp_obj_t top = TOP();
                     mp_obj_t obj;
-                    #if MICROPY_OPT_LOAD_ATTR_FAST_PATH
+                    // CIRCUITPY-CHANGE
+                    #if MICROPY_OPT_INLINE_CACHE
+                    // The call site cache covers instance members too, so it
+                    // replaces the fast path below.
+                    mp_obj_t dest[2];
+                    if (mp_inline_cache_load_method(code_state->fun_bc, ip, top, qst, dest)) {
+                        obj = dest[1] == MP_OBJ_NULL ? dest[0] : mp_obj_new_bound_meth(dest[0], dest[1]);
+                    } else
+                    #elif MICROPY_OPT_LOAD_ATTR_FAST_PATH
                     // For the specific case of an instance type, it implements .attr
                     // and forwards to its members map. Attribute lookups on instance
                     // types are extremely common, so avoid all the other checks and
@@ -444,7 +553,13 @@ dispatch_loop:
                 ENTRY(MP_BC_LOAD_METHOD): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
-                    mp_load_method(*sp, qst, sp);
+                    // CIRCUITPY-CHANGE
+                    #if MICROPY_OPT_INLINE_CACHE
+                    if (!mp_inline_cache_load_method(code_state->fun_bc, ip, *sp, qst, sp))
+                    #endif
+                    {
+                        mp_load_method(*sp, qst, sp);
+                    }
                     sp += 1;
                     DISPATCH();
                 }
@@ -1306,7 +1421,8 @@ yield:
                     MARK_EXC_IP_SELECTIVE();
                     mp_obj_t rhs = POP();
                     mp_obj_t lhs = TOP();
-                    SET_TOP(mp_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
+                    // CIRCUITPY-CHANGE
+                    SET_TOP(vm_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
                     DISPATCH();
                 }
 
@@ -1329,7 +1445,8 @@ yield:
                     } else if (ip[-1] < MP_BC_BINARY_OP_MULTI + MP_BC_BINARY_OP_MULTI_NUM) {
                         mp_obj_t rhs = POP();
                         mp_obj_t lhs = TOP();
-                        SET_TOP(mp_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
+                        // CIRCUITPY-CHANGE
+                        SET_TOP(vm_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
                         DISPATCH();
                     } else
                 #endif // MICROPY_OPT_COMPUTED_GOTO
@@ -0,0 +1,164 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <stdint.h>
+
+#include "shared/runtime/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/audiocore/Resampler.h"
+#include "shared-bindings/audiocore/__init__.h"
+#include "shared-bindings/util.h"
+
+//| class Resampler:
+//|     """Play a sample at a different sample rate
+//|
+//|     Converts another sample to a new sample rate as it plays, so that samples recorded at
+//|     different rates can share one `audiomixer.Mixer` or effect chain. Output is always
+//|     16 bit signed. Values between source samples are linearly interpolated, which is cheap
+//|     enough to run on every core but lets some aliasing through when downsampling."""
+//|
+//|     def __init__(
+//|         self,
+//|         sample: circuitpython_typing.AudioSample,
+//|         *,
+//|         sample_rate: int,
+//|         channel_count: Optional[int] = None,
+//|         buffer_size: int = 1024,
+//|     ) -> None:
+//|         """Create a Resampler that plays ``sample`` at ``sample_rate``.
+//|
+//|         :param ~circuitpython_typing.AudioSample sample: The sample to convert. It must be 8 or 16 bit and mono or stereo.
+//|         :param int sample_rate: The sample rate to output at
+//|         :param int channel_count: The number of channels to output. Mono samples are copied to both channels
+//|           and stereo samples are averaged down to one. Defaults to the channel count of ``sample``.
+//|         :param int buffer_size: The total size in bytes of each of the two output buffers to use
+//|
+//|         Playing an 8kHz wave file in a 22050Hz mixer::
+//|
+//|           import audiocore
+//|           import audiomixer
+//|           import audioio
+//|           import board
+//|
+//|           mixer = audiomixer.Mixer(voice_count=2, sample_rate=22050, channel_count=1)
+//|           a = audioio.AudioOut(board.A0)
+//|           a.play(mixer)
+//|
+//|           wav = audiocore.WaveFile("speech-8khz.wav")
+//|           mixer.voice[0].play(audiocore.Resampler(wav, sample_rate=22050, channel_count=1))
+//|         """
+//|         ...
+//|
+static mp_obj_t audioio_resampler_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_sample, ARG_sample_rate, ARG_channel_count, ARG_buffer_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_sample, MP_ARG_OBJ | MP_ARG_REQUIRED, {} },
+        { MP_QSTR_sample_rate, MP_ARG_INT | MP_ARG_KW_ONLY | MP_ARG_REQUIRED, {} },
+        { MP_QSTR_channel_count, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_ROM_NONE } },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1024} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t sample = args[ARG_sample].u_obj;
+    audiosample_base_t *source = audiosample_check(sample);
+    audiosample_check_for_deinit(source);
+    if (source->bits_per_sample != 8 && source->bits_per_sample != 16) {
+        mp_raise_ValueError(MP_ERROR_TEXT("bits_per_sample must be 8 or 16"));
+    }
+    mp_arg_validate_int_range(source->channel_count, 1, 2, MP_QSTR_channel_count);
+
+    mp_int_t sample_rate = mp_arg_validate_int_min(args[ARG_sample_rate].u_int, 1, MP_QSTR_sample_rate);
+    mp_int_t channel_count = source->channel_count;
+    if (args[ARG_channel_count].u_obj != mp_const_none) {
+        channel_count = mp_arg_validate_int_range(mp_obj_get_int(args[ARG_channel_count].u_obj), 1, 2, MP_QSTR_channel_count);
+    }
+    // Each buffer must hold at least one whole stereo frame.
+    mp_int_t buffer_size = mp_arg_validate_int_min(args[ARG_buffer_size].u_int, 4, MP_QSTR_buffer_size);
+    buffer_size &= ~(mp_int_t)3;
+
+    audioio_resampler_obj_t *self = mp_obj_malloc(audioio_resampler_obj_t, &audioio_resampler_type);
+    common_hal_audioio_resampler_construct(self, sample, sample_rate, channel_count, buffer_size);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def deinit(self) -> None:
+//|         """Deinitialises the Resampler and releases all memory resources for reuse."""
+//|         ...
+//|
+static mp_obj_t audioio_resampler_deinit(mp_obj_t self_in) {
+    audioio_resampler_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_audioio_resampler_deinit(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(audioio_resampler_deinit_obj, audioio_resampler_deinit);
+
+//|     def __enter__(self) -> Resampler:
+//|         """No-op used by Context Managers."""
+//|         ...
+//|
+//  Provided by context manager helper.
+
+//|     def __exit__(self) -> None:
+//|         """Automatically deinitializes the hardware when exiting a context. See
+//|         :ref:`lifetime-and-contextmanagers` for more info."""
+//|         ...
+//|
+//  Provided by context manager helper.
+
+//|     sample: circuitpython_typing.AudioSample
+//|     """The sample being converted. (read only)"""
+//|
+static mp_obj_t audioio_resampler_obj_get_sample(mp_obj_t self_in) {
+    audioio_resampler_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    audiosample_check_for_deinit(&self->base);
+    return common_hal_audioio_resampler_get_sample(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_resampler_get_sample_obj, audioio_resampler_obj_get_sample);
+
+MP_PROPERTY_GETTER(audioio_resampler_sample_obj,
+    (mp_obj_t)&audioio_resampler_get_sample_obj);
+
+//|     sample_rate: int
+//|     """32 bit value that dictates the rate the sample is converted to, in Hertz. Changes take
+//|     effect the next time the Resampler is played."""
+//|
+//|     bits_per_sample: int
+//|     """Bits per sample. Always 16. (read only)"""
+//|
+//|     channel_count: int
+//|     """Number of audio channels. (read only)"""
+//|
+//|
+
+static const mp_rom_map_elem_t audioio_resampler_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audioio_resampler_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&default___exit___obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_sample), MP_ROM_PTR(&audioio_resampler_sample_obj) },
+    AUDIOSAMPLE_FIELDS,
+};
+static MP_DEFINE_CONST_DICT(audioio_resampler_locals_dict, audioio_resampler_locals_dict_table);
+
+static const audiosample_p_t audioio_resampler_proto = {
+    MP_PROTO_IMPLEMENT(MP_QSTR_protocol_audiosample)
+    .reset_buffer = (audiosample_reset_buffer_fun)audioio_resampler_reset_buffer,
+    .get_buffer = (audiosample_get_buffer_fun)audioio_resampler_get_buffer,
+};
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    audioio_resampler_type,
+    MP_QSTR_Resampler,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, audioio_resampler_make_new,
+    locals_dict, &audioio_resampler_locals_dict,
+    protocol, &audioio_resampler_proto
+    );
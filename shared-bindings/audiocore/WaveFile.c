@@ -21,14 +21,26 @@
 //|     be 8 bit unsigned or 16 bit signed. If a buffer is provided, it will be used instead of allocating
 //|     an internal buffer, which can prevent memory fragmentation."""
 //|
-//|     def __init__(self, file: Union[str, typing.BinaryIO], buffer: WriteableBuffer) -> None:
+//|     def __init__(
+//|         self,
+//|         file: Union[str, typing.BinaryIO],
+//|         buffer: Optional[WriteableBuffer] = None,
+//|         *,
+//|         read_ahead: int = 2,
+//|     ) -> None:
 //|         """Load a .wav file for playback with `audioio.AudioOut` or `audiobusio.I2SOut`.
 //|
 //|         :param Union[str, typing.BinaryIO] file: The name of a wave file (preferred) or an already opened wave file
 //|         :param ~circuitpython_typing.WriteableBuffer buffer: Optional pre-allocated buffer,
-//|           that will be split in half and used for double-buffering of the data.
-//|           The buffer must be 8 to 1024 bytes long.
-//|           If not provided, two 256 byte buffers are initially allocated internally.
+//|           that will be split into ``read_ahead + 2`` blocks. Two blocks are played from while
+//|           the rest are read from the file in the background.
+//|           The buffer must be 4 to 512 bytes long for each block.
+//|           If not provided, 512 byte blocks are allocated internally, or two 256 byte blocks
+//|           when ``read_ahead`` is 0.
+//|         :param int read_ahead: How many blocks to read from the file ahead of playback, from 0 to 8.
+//|           Reading ahead keeps a slow SD card from interrupting playback. The default is 2
+//|           on boards with room for it and 0 otherwise. It must be 0 on ports whose audio outputs
+//|           take samples from an interrupt, such as `audiopwmio` on STM.
 //|
 //|         Playing a wave file from flash::
 //|
@@ -52,9 +64,17 @@
 //|         """
 //|         ...
 //|
-static mp_obj_t audioio_wavefile_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
-    mp_arg_check_num(n_args, n_kw, 1, 2, false);
-    mp_obj_t arg = args[0];
+static mp_obj_t audioio_wavefile_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_file, ARG_buffer, ARG_read_ahead };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_file, MP_ARG_OBJ | MP_ARG_REQUIRED, {} },
+        { MP_QSTR_buffer, MP_ARG_OBJ, {.u_obj = MP_ROM_NONE} },
+        { MP_QSTR_read_ahead, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = CIRCUITPY_AUDIOCORE_READ_AHEAD} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t arg = args[ARG_file].u_obj;
 
     if (mp_obj_is_str(arg)) {
         arg = mp_call_function_2(MP_OBJ_FROM_PTR(&mp_builtin_open_obj), arg, MP_ROM_QSTR(MP_QSTR_rb));
@@ -64,16 +84,18 @@ static mp_obj_t audioio_wavefile_make_new(const mp_obj_type_t *type, size_t n_ar
     if (!mp_obj_is_type(arg, &mp_type_vfs_fat_fileio)) {
         mp_raise_TypeError(MP_ERROR_TEXT("file must be a file opened in byte mode"));
     }
+    mp_int_t read_ahead = mp_arg_validate_int_range(args[ARG_read_ahead].u_int, 0, AUDIOCORE_READ_AHEAD_MAX, MP_QSTR_read_ahead);
+    size_t block_count = read_ahead + AUDIOCORE_READ_AHEAD_HELD_BLOCKS;
     uint8_t *buffer = NULL;
     size_t buffer_size = 0;
-    if (n_args >= 2) {
+    if (args[ARG_buffer].u_obj != mp_const_none) {
         mp_buffer_info_t bufinfo;
-        mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
+        mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_WRITE);
         buffer = bufinfo.buf;
-        buffer_size = mp_arg_validate_length_range(bufinfo.len, 8, 1024, MP_QSTR_buffer);
+        buffer_size = mp_arg_validate_length_range(bufinfo.len, 4 * block_count, 512 * block_count, MP_QSTR_buffer);
     }
     common_hal_audioio_wavefile_construct(self, MP_OBJ_TO_PTR(arg),
-        buffer, buffer_size);
+        buffer, buffer_size, read_ahead);
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -113,7 +135,22 @@ static MP_DEFINE_CONST_FUN_OBJ_1(audioio_wavefile_deinit_obj, audioio_wavefile_d
 //|     channel_count: int
 //|     """Number of audio channels. (read only)"""
 //|
+//|     underruns: int
+//|     """How many times playback needed data that hadn't been read ahead yet, and so had to wait
+//|     for the file. Each of these is a possible audible glitch. Always 0 when ``read_ahead`` is 0.
+//|     (read only)"""
 //|
+//|
+static mp_obj_t audioio_wavefile_obj_get_underruns(mp_obj_t self_in) {
+    audioio_wavefile_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    audiosample_check_for_deinit(&self->base);
+    return mp_obj_new_int_from_uint(common_hal_audioio_wavefile_get_underruns(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_wavefile_get_underruns_obj, audioio_wavefile_obj_get_underruns);
+
+MP_PROPERTY_GETTER(audioio_wavefile_underruns_obj,
+    (mp_obj_t)&audioio_wavefile_get_underruns_obj);
+
 
 static const mp_rom_map_elem_t audioio_wavefile_locals_dict_table[] = {
     // Methods
@@ -122,6 +159,7 @@ static const mp_rom_map_elem_t audioio_wavefile_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&default___exit___obj) },
 
     // Properties
+    { MP_ROM_QSTR(MP_QSTR_underruns), MP_ROM_PTR(&audioio_wavefile_underruns_obj) },
     AUDIOSAMPLE_FIELDS,
 };
 static MP_DEFINE_CONST_DICT(audioio_wavefile_locals_dict, audioio_wavefile_locals_dict_table);
@@ -209,7 +209,6 @@ MP_PROPERTY_GETTER(audiomp3_mp3file_rms_level_obj,
 //|     samples_decoded: int
 //|     """The number of audio samples decoded from the current file. (read only)"""
 //|
-//|
 static mp_obj_t audiomp3_mp3file_obj_get_samples_decoded(mp_obj_t self_in) {
     audiomp3_mp3file_obj_t *self = MP_OBJ_TO_PTR(self_in);
     check_for_deinit(self);
@@ -220,6 +219,21 @@ MP_DEFINE_CONST_FUN_OBJ_1(audiomp3_mp3file_get_samples_decoded_obj, audiomp3_mp3
 MP_PROPERTY_GETTER(audiomp3_mp3file_samples_decoded_obj,
     (mp_obj_t)&audiomp3_mp3file_get_samples_decoded_obj);
 
+//|     underruns: int
+//|     """How many times the decoder ran out of data read ahead from the file and played
+//|     silence instead. A larger ``buffer`` reads further ahead. (read only)"""
+//|
+//|
+static mp_obj_t audiomp3_mp3file_obj_get_underruns(mp_obj_t self_in) {
+    audiomp3_mp3file_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_audiomp3_mp3file_get_underruns(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiomp3_mp3file_get_underruns_obj, audiomp3_mp3file_obj_get_underruns);
+
+MP_PROPERTY_GETTER(audiomp3_mp3file_underruns_obj,
+    (mp_obj_t)&audiomp3_mp3file_get_underruns_obj);
+
 static const mp_rom_map_elem_t audiomp3_mp3file_locals_dict_table[] = {
     // Methods
     { MP_ROM_QSTR(MP_QSTR_open), MP_ROM_PTR(&audiomp3_mp3file_open_obj) },
@@ -232,6 +246,7 @@ static const mp_rom_map_elem_t audiomp3_mp3file_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_file), MP_ROM_PTR(&audiomp3_mp3file_file_obj) },
     { MP_ROM_QSTR(MP_QSTR_rms_level), MP_ROM_PTR(&audiomp3_mp3file_rms_level_obj) },
     { MP_ROM_QSTR(MP_QSTR_samples_decoded), MP_ROM_PTR(&audiomp3_mp3file_samples_decoded_obj) },
+    { MP_ROM_QSTR(MP_QSTR_underruns), MP_ROM_PTR(&audiomp3_mp3file_underruns_obj) },
     AUDIOSAMPLE_FIELDS,
 };
 static MP_DEFINE_CONST_DICT(audiomp3_mp3file_locals_dict, audiomp3_mp3file_locals_dict_table);
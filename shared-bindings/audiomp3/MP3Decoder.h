@@ -21,3 +21,4 @@ void common_hal_audiomp3_mp3file_set_file(audiomp3_mp3file_obj_t *self, mp_obj_t
 void common_hal_audiomp3_mp3file_deinit(audiomp3_mp3file_obj_t *self);
 float common_hal_audiomp3_mp3file_get_rms_level(audiomp3_mp3file_obj_t *self);
 uint32_t common_hal_audiomp3_mp3file_get_samples_decoded(audiomp3_mp3file_obj_t *self);
+uint32_t common_hal_audiomp3_mp3file_get_underruns(audiomp3_mp3file_obj_t *self);
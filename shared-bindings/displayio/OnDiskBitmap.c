@@ -10,6 +10,7 @@
 
 #include "py/runtime.h"
 #include "py/objproperty.h"
+#include "extmod/vfs_fat.h"
 
 #include "shared-bindings/displayio/OnDiskBitmap.h"
 
@@ -66,7 +67,7 @@ static mp_obj_t displayio_ondiskbitmap_make_new(const mp_obj_type_t *type, size_
     if (mp_obj_is_str(arg)) {
         arg = mp_call_function_2(MP_OBJ_FROM_PTR(&mp_builtin_open_obj), arg, MP_ROM_QSTR(MP_QSTR_rb));
     }
-    if (!mp_obj_is_type(arg, &mp_type_fileio)) {
+    if (!mp_obj_is_type(arg, &mp_type_vfs_fat_fileio)) {
         mp_raise_TypeError(MP_ERROR_TEXT("file must be a file opened in byte mode"));
     }
 
@@ -292,7 +292,7 @@ static mp_obj_t framebufferio_framebufferdisplay_obj_fill_row(size_t n_args, con
     size_t result_buffer_size = bufinfo.len;
 
     if (result_buffer_size >= (buffer_size * 4)) {
-        volatile uint32_t mask_length = (pixels_per_buffer / 32) + 1;
+        volatile uint32_t mask_length = DISPLAYIO_MASK_LENGTH(pixels_per_buffer);
         uint32_t mask[mask_length];
 
         for (uint16_t k = 0; k < mask_length; k++) {
@@ -22,6 +22,7 @@
 //|         colorspace: displayio.Colorspace,
 //|         loop: bool = True,
 //|         dither: bool = False,
+//|         delta: bool = False,
 //|     ) -> None:
 //|         """Construct a GifWriter object
 //|
@@ -31,11 +32,14 @@
 //|         :param colorspace: The colorspace of the image.  All frames must have the same colorspace.  The supported colorspaces are ``RGB565``, ``BGR565``, ``RGB565_SWAPPED``, ``BGR565_SWAPPED``, and ``L8`` (greyscale)
 //|         :param loop: If True, the GIF is marked for looping playback
 //|         :param dither: If True, and the image is in color, a simple ordered dither is applied.
+//|         :param delta: If True, each frame after the first only stores the rectangle that changed since
+//|           the previous frame. This makes recordings of mostly still scenes much smaller, at the cost
+//|           of keeping a ``width * height`` byte copy of the last frame.
 //|         """
 //|         ...
 //|
 static mp_obj_t gifio_gifwriter_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
-    enum { ARG_file, ARG_width, ARG_height, ARG_colorspace, ARG_loop, ARG_dither };
+    enum { ARG_file, ARG_width, ARG_height, ARG_colorspace, ARG_loop, ARG_dither, ARG_delta };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_file, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = NULL} },
         { MP_QSTR_width, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
@@ -43,6 +47,7 @@ static mp_obj_t gifio_gifwriter_make_new(const mp_obj_type_t *type, size_t n_arg
         { MP_QSTR_colorspace, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = NULL} },
         { MP_QSTR_loop, MP_ARG_BOOL, { .u_bool = true } },
         { MP_QSTR_dither, MP_ARG_BOOL, { .u_bool = false } },
+        { MP_QSTR_delta, MP_ARG_BOOL, { .u_bool = false } },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -63,6 +68,7 @@ static mp_obj_t gifio_gifwriter_make_new(const mp_obj_type_t *type, size_t n_arg
         (displayio_colorspace_t)cp_enum_value(&displayio_colorspace_type, args[ARG_colorspace].u_obj, MP_QSTR_colorspace),
         args[ARG_loop].u_bool,
         args[ARG_dither].u_bool,
+        args[ARG_delta].u_bool,
         own_file);
 
     return self;
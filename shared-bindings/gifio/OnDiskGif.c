@@ -10,6 +10,7 @@
 
 #include "py/runtime.h"
 #include "py/objproperty.h"
+#include "extmod/vfs_fat.h"
 #include "shared/runtime/context_manager_helpers.h"
 #include "shared-bindings/util.h"
 #include "shared-bindings/gifio/OnDiskGif.h"
@@ -105,7 +106,7 @@
 static mp_obj_t gifio_ondiskgif_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
     enum { ARG_filename, ARG_use_palette, NUM_ARGS };
     static const mp_arg_t allowed_args[] = {
-        { MP_QSTR_filename, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_filename, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
         { MP_QSTR_use_palette, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
     };
     MP_STATIC_ASSERT(MP_ARRAY_SIZE(allowed_args) == NUM_ARGS);
@@ -117,7 +118,7 @@ static mp_obj_t gifio_ondiskgif_make_new(const mp_obj_type_t *type, size_t n_arg
         filename = mp_call_function_2(MP_OBJ_FROM_PTR(&mp_builtin_open_obj), filename, MP_ROM_QSTR(MP_QSTR_rb));
     }
 
-    if (!mp_obj_is_type(filename, &mp_type_fileio)) {
+    if (!mp_obj_is_type(filename, &mp_type_vfs_fat_fileio)) {
         mp_raise_TypeError(MP_ERROR_TEXT("file must be a file opened in byte mode"));
     }
 
@@ -191,9 +191,67 @@ static mp_obj_t jpegio_jpegdecoder_decode(mp_uint_t n_args, const mp_obj_t *pos_
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(jpegio_jpegdecoder_decode_obj, 1, jpegio_jpegdecoder_decode);
 
+//|     def decode_to(
+//|         self,
+//|         target: Union[busdisplay.BusDisplay, framebufferio.FramebufferDisplay, Callable[[int, int, int, int, memoryview], None]],
+//|         scale: int = 0,
+//|         x: int = 0,
+//|         y: int = 0,
+//|     ) -> None:
+//|         """Decode JPEG data straight to a display, without a `displayio.Bitmap` for the whole image
+//|
+//|         The image is decoded a row of MCUs (usually 8 or 16 pixel rows) at a time and each row is
+//|         sent to *target* as soon as it is complete, so only two rows of pixels are held in RAM.
+//|         One row is filled while the other is being sent.
+//|
+//|         The target is drawn in its native orientation and its ``rotation`` is ignored. Parts of
+//|         the image that fall outside of the target are skipped. A function is treated as a target
+//|         with no right or bottom edge. Set ``auto_refresh`` to False or ``root_group`` to None
+//|         first so that a refresh doesn't draw over the image.
+//|
+//|         When *target* is a function it is called as ``target(x, y, width, height, pixels)`` for
+//|         each row. ``pixels`` is a `memoryview` of ``width * height`` pixels in the
+//|         `displayio.Colorspace.RGB565_SWAPPED` colorspace. It is only valid until the following call
+//|         returns, so copy or send it before then.
+//|
+//|         After a call to ``decode_to``, you must ``open`` a new JPEG.
+//|
+//|         :param target: a 16 bit `busdisplay.BusDisplay` or `framebufferio.FramebufferDisplay`, or a function
+//|         :param int scale: Scale factor from 0 to 3, inclusive.
+//|         :param int x: Horizontal pixel location where the upper-left corner of the image will be placed.
+//|                       May be negative to show only part of the image.
+//|         :param int y: Vertical pixel location where the upper-left corner of the image will be placed.
+//|                       May be negative to show only part of the image.
+//|         """
+//|
+//|
+static mp_obj_t jpegio_jpegdecoder_decode_to(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    jpegio_jpegdecoder_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+
+    enum { ARG_target, ARG_scale, ARG_x, ARG_y };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_target, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = mp_const_none } },
+        { MP_QSTR_scale, MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_x, MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_y, MP_ARG_INT, {.u_int = 0 } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    int scale = mp_arg_validate_int_range(args[ARG_scale].u_int, 0, 3, MP_QSTR_scale);
+    int x = mp_arg_validate_int_range(args[ARG_x].u_int, -32768, 32767, MP_QSTR_x);
+    int y = mp_arg_validate_int_range(args[ARG_y].u_int, -32768, 32767, MP_QSTR_y);
+
+    common_hal_jpegio_jpegdecoder_decode_to(self, args[ARG_target].u_obj, scale, x, y);
+
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(jpegio_jpegdecoder_decode_to_obj, 1, jpegio_jpegdecoder_decode_to);
+
 static const mp_rom_map_elem_t jpegio_jpegdecoder_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_open), MP_ROM_PTR(&jpegio_jpegdecoder_open_obj) },
     { MP_ROM_QSTR(MP_QSTR_decode), MP_ROM_PTR(&jpegio_jpegdecoder_decode_obj) },
+    { MP_ROM_QSTR(MP_QSTR_decode_to), MP_ROM_PTR(&jpegio_jpegdecoder_decode_to_obj) },
 };
 static MP_DEFINE_CONST_DICT(jpegio_jpegdecoder_locals_dict, jpegio_jpegdecoder_locals_dict_table);
 
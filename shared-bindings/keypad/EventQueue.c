@@ -67,6 +67,49 @@ static mp_obj_t keypad_eventqueue_get_into(mp_obj_t self_in, mp_obj_t event_in)
 }
 MP_DEFINE_CONST_FUN_OBJ_2(keypad_eventqueue_get_into_obj, keypad_eventqueue_get_into);
 
+//|     def get_into_array(
+//|         self, events: WriteableBuffer, timestamps: Optional[WriteableBuffer] = None
+//|     ) -> int:
+//|         """Move as many queued events as fit into ``events`` and return how many were moved.
+//|
+//|         Each event is stored as its key number, with ``0x8000`` added if the key was
+//|         pressed, so ``events`` is usually an ``array.array("H")``. If ``timestamps`` is
+//|         given, the `supervisor.ticks_ms` time of each event is stored at the same index;
+//|         an ``array.array("L")`` holds them. At most ``min(len(events), len(timestamps))``
+//|         events are moved.
+//|
+//|         This drains a burst of events from a large keyboard in one call and
+//|         allocates nothing.
+//|
+//|         :return: The number of events stored.
+//|         :rtype: int
+//|         """
+//|         ...
+//|
+static mp_obj_t keypad_eventqueue_get_into_array(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_events, ARG_timestamps };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_events, MP_ARG_REQUIRED | MP_ARG_OBJ, {} },
+        { MP_QSTR_timestamps, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    keypad_eventqueue_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t events;
+    mp_get_buffer_raise(args[ARG_events].u_obj, &events, MP_BUFFER_WRITE);
+
+    mp_buffer_info_t timestamps;
+    mp_buffer_info_t *timestamps_ptr = NULL;
+    if (args[ARG_timestamps].u_obj != mp_const_none) {
+        mp_get_buffer_raise(args[ARG_timestamps].u_obj, &timestamps, MP_BUFFER_WRITE);
+        timestamps_ptr = &timestamps;
+    }
+
+    return MP_OBJ_NEW_SMALL_INT(common_hal_keypad_eventqueue_get_into_array(self, &events, timestamps_ptr));
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(keypad_eventqueue_get_into_array_obj, 1, keypad_eventqueue_get_into_array);
+
 //|     def clear(self) -> None:
 //|         """Clear any queued key transition events. Also sets `overflowed` to ``False``."""
 //|         ...
@@ -121,6 +164,7 @@ static const mp_rom_map_elem_t keypad_eventqueue_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_clear),      MP_ROM_PTR(&keypad_eventqueue_clear_obj) },
     { MP_ROM_QSTR(MP_QSTR_get),        MP_ROM_PTR(&keypad_eventqueue_get_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_into),   MP_ROM_PTR(&keypad_eventqueue_get_into_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_into_array), MP_ROM_PTR(&keypad_eventqueue_get_into_array_obj) },
     { MP_ROM_QSTR(MP_QSTR_overflowed), MP_ROM_PTR(&keypad_eventqueue_overflowed_obj) },
 };
 
@@ -61,6 +61,10 @@ MP_PROPERTY_GETTER(keypad_generic_events_obj,
 //| For more information about working with the `keypad` module in CircuitPython,
 //| see `this Learn guide <https://learn.adafruit.com/key-pad-matrix-scanning-in-circuitpython>`_.
 //|
+//| Scanners are normally run from the 1/1024 second system tick, so an ``interval``
+//| shorter than that is rounded up to one tick. Ports with a spare hardware timer
+//| scan from its interrupt instead whenever a scanner asks for a shorter ``interval``.
+//|
 //| .. warning:: Using pull-downs with `keypad` on Raspberry Pi RP2350 A2 stepping has some limitations
 //|    due to a GPIO hardware issue that causes excessive leakage current (~120uA).
 //|    A pin can read as high even when driven or pulled low, if the input signal is high
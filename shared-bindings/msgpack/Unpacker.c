@@ -0,0 +1,156 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/msgpack/Unpacker.h"
+
+//| class Unpacker:
+//|     """Unpacks a series of objects from data that arrives in pieces.
+//|
+//|     Data is collected in a buffer that is allocated once and only grows when
+//|     a single object doesn't fit in it. Objects are unpacked once all of their
+//|     data has arrived, and anything after them is kept for the next one.
+//|
+//|     Example::
+//|
+//|         import array
+//|         import board
+//|         import busio
+//|         import msgpack
+//|
+//|         uart = busio.UART(board.TX, board.RX, timeout=0)
+//|         unpacker = msgpack.Unpacker(uart)
+//|         samples = array.array("f", [0] * 16)
+//|         while True:
+//|             if unpacker.unpack_into(samples):
+//|                 print(samples)
+//|     """
+//|
+//|     def __init__(
+//|         self,
+//|         stream: Optional[circuitpython_typing.ByteStream] = None,
+//|         *,
+//|         ext_hook: Union[Callable[[int, bytes], object], None] = None,
+//|         use_list: bool = True,
+//|         buffer_size: int = 256,
+//|     ) -> None:
+//|         """
+//|         :param ~circuitpython_typing.ByteStream stream: stream to read from when more data is
+//|           needed. Without one, data must be passed to `feed`.
+//|         :param Optional[~circuitpython_typing.Callable[[int, bytes], object]] ext_hook: function
+//|           called for objects in msgpack ext format.
+//|         :param bool use_list: return array as list or tuple (use_list=False).
+//|         :param int buffer_size: initial size of the buffer in bytes.
+//|         """
+//|         ...
+//|
+static mp_obj_t msgpack_unpacker_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_stream, ARG_ext_hook, ARG_use_list, ARG_buffer_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_stream, MP_ARG_OBJ, { .u_obj = mp_const_none } },
+        { MP_QSTR_ext_hook, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
+        { MP_QSTR_use_list, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = true } },
+        { MP_QSTR_buffer_size, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = 256 } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t hook = args[ARG_ext_hook].u_obj;
+    if (hook != mp_const_none && !mp_obj_is_callable(hook)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("ext_hook is not a function"));
+    }
+    size_t buffer_size = mp_arg_validate_int_min(args[ARG_buffer_size].u_int, 1, MP_QSTR_buffer_size);
+
+    msgpack_unpacker_obj_t *self = mp_obj_malloc(msgpack_unpacker_obj_t, &msgpack_unpacker_type);
+    common_hal_msgpack_unpacker_construct(self, args[ARG_stream].u_obj, hook, args[ARG_use_list].u_bool, buffer_size);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def feed(self, data: ReadableBuffer) -> None:
+//|         """Add data to the end of what is waiting to be unpacked."""
+//|         ...
+//|
+static mp_obj_t msgpack_unpacker_feed(mp_obj_t self_in, mp_obj_t data_in) {
+    msgpack_unpacker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(data_in, &bufinfo, MP_BUFFER_READ);
+    common_hal_msgpack_unpacker_feed(self, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(msgpack_unpacker_feed_obj, msgpack_unpacker_feed);
+
+//|     def unpack(self) -> object:
+//|         """Unpack and return the next object.
+//|
+//|         :raises EOFError: if the whole object hasn't been received yet.
+//|         :raises ValueError: if the data is invalid. The data up to and including the
+//|           first bad byte is dropped, so the objects after it can still be unpacked."""
+//|         ...
+//|
+static mp_obj_t msgpack_unpacker_unpack(mp_obj_t self_in) {
+    msgpack_unpacker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t obj;
+    if (!common_hal_msgpack_unpacker_unpack(self, &obj)) {
+        mp_raise_msg(&mp_type_EOFError, NULL);
+    }
+    return obj;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(msgpack_unpacker_unpack_obj, msgpack_unpacker_unpack);
+
+//|     def unpack_into(self, buffer: WriteableBuffer) -> Optional[int]:
+//|         """Unpack the next object into *buffer* without allocating any memory.
+//|
+//|         A str or bin object is copied into the bytes of *buffer*. An array of numbers
+//|         is stored in the elements of *buffer*, such as a bytearray, an `array.array`
+//|         or a `memoryview`, converting each number to the element type.
+//|
+//|         :return: the number of bytes or elements stored, or None if the whole object
+//|           hasn't been received yet.
+//|         :raises ValueError: if the object is another type or doesn't fit. The object is
+//|           left in place in that case, and can then be read with `unpack`."""
+//|         ...
+//|
+static mp_obj_t msgpack_unpacker_unpack_into(mp_obj_t self_in, mp_obj_t target) {
+    msgpack_unpacker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    size_t len;
+    if (!common_hal_msgpack_unpacker_unpack_into(self, target, &len)) {
+        return mp_const_none;
+    }
+    return MP_OBJ_NEW_SMALL_INT(len);
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(msgpack_unpacker_unpack_into_obj, msgpack_unpacker_unpack_into);
+
+//|     def __iter__(self) -> Iterator[object]:
+//|         """Iterate over the objects that have been fully received."""
+//|         ...
+//|
+//|
+static mp_obj_t msgpack_unpacker_iternext(mp_obj_t self_in) {
+    msgpack_unpacker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t obj;
+    if (!common_hal_msgpack_unpacker_unpack(self, &obj)) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    return obj;
+}
+
+static const mp_rom_map_elem_t msgpack_unpacker_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_feed), MP_ROM_PTR(&msgpack_unpacker_feed_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack), MP_ROM_PTR(&msgpack_unpacker_unpack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack_into), MP_ROM_PTR(&msgpack_unpacker_unpack_into_obj) },
+};
+static MP_DEFINE_CONST_DICT(msgpack_unpacker_locals_dict, msgpack_unpacker_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    msgpack_unpacker_type,
+    MP_QSTR_Unpacker,
+    MP_TYPE_FLAG_ITER_IS_ITERNEXT,
+    make_new, msgpack_unpacker_make_new,
+    iter, msgpack_unpacker_iternext,
+    locals_dict, &msgpack_unpacker_locals_dict
+    );
@@ -0,0 +1,18 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "shared-module/msgpack/Unpacker.h"
+
+extern const mp_obj_type_t msgpack_unpacker_type;
+
+void common_hal_msgpack_unpacker_construct(msgpack_unpacker_obj_t *self, mp_obj_t stream, mp_obj_t ext_hook, bool use_list, size_t buffer_size);
+void common_hal_msgpack_unpacker_feed(msgpack_unpacker_obj_t *self, const uint8_t *data, size_t len);
+// Both return false, leaving the data in place, when the next object hasn't
+// been fully received yet.
+bool common_hal_msgpack_unpacker_unpack(msgpack_unpacker_obj_t *self, mp_obj_t *obj);
+bool common_hal_msgpack_unpacker_unpack_into(msgpack_unpacker_obj_t *self, mp_obj_t target, size_t *len);
@@ -10,6 +10,7 @@
 #include "shared-bindings/msgpack/__init__.h"
 #include "shared-module/msgpack/__init__.h"
 #include "shared-bindings/msgpack/ExtType.h"
+#include "shared-bindings/msgpack/Unpacker.h"
 
 #define MP_OBJ_IS_METH(o) (mp_obj_is_obj(o) && (((mp_obj_base_t *)MP_OBJ_TO_PTR(o))->type->name == MP_QSTR_bound_method))
 
@@ -87,8 +88,8 @@
 static mp_obj_t mod_msgpack_pack(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_obj, ARG_buffer, ARG_default };
     static const mp_arg_t allowed_args[] = {
-        { MP_QSTR_obj, MP_ARG_REQUIRED | MP_ARG_OBJ },
-        { MP_QSTR_stream, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_obj, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
+        { MP_QSTR_stream, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
         { MP_QSTR_default, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
@@ -126,7 +127,7 @@ MP_DEFINE_CONST_FUN_OBJ_KW(mod_msgpack_pack_obj, 0, mod_msgpack_pack);
 static mp_obj_t mod_msgpack_unpack(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_buffer, ARG_ext_hook, ARG_use_list };
     static const mp_arg_t allowed_args[] = {
-        { MP_QSTR_stream, MP_ARG_REQUIRED | MP_ARG_OBJ, },
+        { MP_QSTR_stream, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
         { MP_QSTR_ext_hook, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
         { MP_QSTR_use_list, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = true } },
     };
@@ -142,12 +143,35 @@ static mp_obj_t mod_msgpack_unpack(size_t n_args, const mp_obj_t *pos_args, mp_m
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(mod_msgpack_unpack_obj, 0, mod_msgpack_unpack);
 
+//| def unpack_into(stream: circuitpython_typing.ByteStream, buffer: WriteableBuffer) -> int:
+//|     """Unpack one object from stream into *buffer* without allocating any memory.
+//|
+//|     A str or bin object is copied into the bytes of *buffer*. An array of numbers is
+//|     stored in the elements of *buffer*, such as a bytearray, an `array.array` or a
+//|     `memoryview`, converting each number to the element type. Use `Unpacker` to
+//|     read from streams that deliver objects in pieces.
+//|
+//|     :param ~circuitpython_typing.ByteStream stream: stream to read from
+//|     :param ~circuitpython_typing.WriteableBuffer buffer: where to store the object
+//|
+//|     :return int: the number of bytes or elements stored.
+//|     """
+//|     ...
+//|
+//|
+static mp_obj_t mod_msgpack_unpack_into(mp_obj_t stream, mp_obj_t buffer) {
+    return MP_OBJ_NEW_SMALL_INT(common_hal_msgpack_unpack_into(stream, buffer));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(mod_msgpack_unpack_into_obj, mod_msgpack_unpack_into);
+
 
 static const mp_rom_map_elem_t msgpack_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_msgpack) },
     { MP_ROM_QSTR(MP_QSTR_ExtType), MP_ROM_PTR(&mod_msgpack_exttype_type) },
     { MP_ROM_QSTR(MP_QSTR_pack), MP_ROM_PTR(&mod_msgpack_pack_obj) },
     { MP_ROM_QSTR(MP_QSTR_unpack), MP_ROM_PTR(&mod_msgpack_unpack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack_into), MP_ROM_PTR(&mod_msgpack_unpack_into_obj) },
+    { MP_ROM_QSTR(MP_QSTR_Unpacker), MP_ROM_PTR(&msgpack_unpacker_type) },
 };
 
 static MP_DEFINE_CONST_DICT(msgpack_module_globals, msgpack_module_globals_table);
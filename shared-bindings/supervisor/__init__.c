@@ -8,8 +8,10 @@
 #include "py/obj.h"
 #include "py/runtime.h"
 #include "py/objstr.h"
+#include "py/objtuple.h"
 
 #include "shared/runtime/interrupt_char.h"
+#include "supervisor/background_callback.h"
 #include "supervisor/port.h"
 #include "supervisor/shared/display.h"
 #include "supervisor/shared/reload.h"
@@ -248,6 +250,65 @@ static mp_obj_t supervisor_reset_terminal(mp_obj_t x_pixels, mp_obj_t y_pixels)
 }
 MP_DEFINE_CONST_FUN_OBJ_2(supervisor_reset_terminal_obj, supervisor_reset_terminal);
 
+#if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+//| def get_background_callback_stats(reset: bool = False) -> List[Tuple[int, ...]]:
+//|     """Return timing statistics for the work done in the background, such as refilling
+//|     audio buffers, handling USB and refreshing displays.
+//|
+//|     Each item is a tuple for one background function with the attributes ``function``
+//|     (its address), ``priority``, ``count``, ``max_us``, ``average_us``, ``max_latency_us``,
+//|     ``average_latency_us`` and ``overruns``. Latency is how long a callback waited between
+//|     being queued and being run. Overruns are runs that took longer than the budget for their
+//|     priority: 1ms for audio, 2ms for USB, 5ms by default and 20ms for displays and the web
+//|     workflow. Higher priorities run first and are: 2 for audio, 1 for USB, 0 by default,
+//|     -1 for displays and -2 for the web workflow. Times have a resolution of about 30us.
+//|
+//|     Only available on builds with ``CIRCUITPY_BACKGROUND_CALLBACK_STATS`` enabled.
+//|
+//|     :param bool reset: clear the statistics after reading them
+//|     """
+//|     ...
+//|
+//|
+static mp_obj_t supervisor_get_background_callback_stats(size_t n_args, const mp_obj_t *args) {
+    static const qstr fields[] = {
+        MP_QSTR_function,
+        MP_QSTR_priority,
+        MP_QSTR_count,
+        MP_QSTR_max_us,
+        MP_QSTR_average_us,
+        MP_QSTR_max_latency_us,
+        MP_QSTR_average_latency_us,
+        MP_QSTR_overruns,
+    };
+    background_callback_stats_t stats[BACKGROUND_CALLBACK_STATS_COUNT];
+    size_t count = background_callback_get_stats(stats, MP_ARRAY_SIZE(stats));
+    if (n_args > 0 && mp_obj_is_true(args[0])) {
+        background_callback_reset_stats();
+    }
+    mp_obj_t result = mp_obj_new_list(0, NULL);
+    for (size_t i = 0; i < count; i++) {
+        background_callback_stats_t *entry = &stats[i];
+        // Convert from 1/32768ths of a second.
+        #define TO_US(t) mp_obj_new_int_from_ull((uint64_t)(t) * 15625 / 512)
+        mp_obj_t items[] = {
+            mp_obj_new_int_from_uint((uintptr_t)entry->fun),
+            MP_OBJ_NEW_SMALL_INT(entry->priority),
+            mp_obj_new_int_from_uint(entry->count),
+            TO_US(entry->max_run),
+            TO_US(entry->total_run / entry->count),
+            TO_US(entry->max_latency),
+            TO_US(entry->total_latency / entry->count),
+            mp_obj_new_int_from_uint(entry->overruns),
+        };
+        #undef TO_US
+        mp_obj_list_append(result, mp_obj_new_attrtuple(fields, MP_ARRAY_SIZE(items), items));
+    }
+    return result;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(supervisor_get_background_callback_stats_obj, 0, 1, supervisor_get_background_callback_stats);
+#endif
+
 //| def set_usb_identification(
 //|     manufacturer: Optional[str] = None,
 //|     product: Optional[str] = None,
@@ -331,6 +392,9 @@ static const mp_rom_map_elem_t supervisor_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_set_next_code_file),  MP_ROM_PTR(&supervisor_set_next_code_file_obj) },
     { MP_ROM_QSTR(MP_QSTR_ticks_ms),  MP_ROM_PTR(&supervisor_ticks_ms_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_previous_traceback),  MP_ROM_PTR(&supervisor_get_previous_traceback_obj) },
+    #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+    { MP_ROM_QSTR(MP_QSTR_get_background_callback_stats),  MP_ROM_PTR(&supervisor_get_background_callback_stats_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_reset_terminal),  MP_ROM_PTR(&supervisor_reset_terminal_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_usb_identification),  MP_ROM_PTR(&supervisor_set_usb_identification_obj) },
     { MP_ROM_QSTR(MP_QSTR_status_bar),  MP_ROM_PTR(&shared_module_supervisor_status_bar_obj) },
@@ -24,6 +24,8 @@ typedef void (*draw_update_transform_fun)(mp_obj_t draw_protocol_self, displayio
 typedef void (*draw_finish_refresh_fun)(mp_obj_t draw_protocol_self);
 typedef void (*draw_set_dirty_fun)(mp_obj_t draw_protocol_self);
 typedef displayio_area_t *(*draw_get_refresh_areas_fun)(mp_obj_t draw_protocol_self, displayio_area_t *tail);
+// Returns true when the shape is hidden or covered by one of the occluders above it.
+typedef bool (*draw_update_occlusion_fun)(mp_obj_t draw_protocol_self, displayio_occluders_t *occluders);
 
 typedef struct _vectorio_draw_protocol_impl_t {
     draw_fill_area_fun draw_fill_area;
@@ -32,6 +34,7 @@ typedef struct _vectorio_draw_protocol_impl_t {
     draw_finish_refresh_fun draw_finish_refresh;
     draw_get_refresh_areas_fun draw_get_refresh_areas;
     draw_set_dirty_fun draw_set_dirty;
+    draw_update_occlusion_fun draw_update_occlusion;
 } vectorio_draw_protocol_impl_t;
 
 // Draw protocol
@@ -0,0 +1,146 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/obj.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/zlib/Decompress.h"
+
+//| class Decompress:
+//|     """Decompresses a stream of data that doesn't have to be in memory all at once.
+//|
+//|     Create one with `zlib.decompressobj`. The object holds the DEFLATE window (up to
+//|     33KiB for the default *wbits*) for as long as it is in use, and decompresses in
+//|     constant memory otherwise. Use `decompress_into` to avoid allocating output
+//|     buffers at all.
+//|
+//|     Example::
+//|
+//|         import zlib
+//|
+//|         d = zlib.decompressobj(31)
+//|         buf = bytearray(1024)
+//|         with open("/data.gz", "rb") as src, open("/data", "wb") as dst:
+//|             while not d.eof:
+//|                 data = d.unconsumed_tail or src.read(512)
+//|                 n = d.decompress_into(buf, data)
+//|                 if not data and not n:
+//|                     break  # the file was truncated
+//|                 dst.write(memoryview(buf)[:n])
+//|     """
+//|
+
+//|     def decompress(self, data: ReadableBuffer, max_length: int = 0) -> bytes:
+//|         """Decompress *data* and return as much of the output as is available.
+//|
+//|         Input that ends part way through the stream is kept and used with the
+//|         data passed to the next call.
+//|
+//|         :param ReadableBuffer data: the next part of the compressed stream
+//|         :param int max_length: return at most this many bytes. Input that wasn't
+//|           needed to produce them is put in `unconsumed_tail` and must be passed in
+//|           again. 0 means no limit.
+//|         """
+//|         ...
+//|
+static mp_obj_t zlib_decompress_decompress(size_t n_args, const mp_obj_t *args) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_READ);
+    mp_int_t max_length = 0;
+    if (n_args > 2) {
+        max_length = mp_arg_validate_int_min(mp_obj_get_int(args[2]), 0, MP_QSTR_max_length);
+    }
+    return common_hal_zlib_decompress_decompress(self, bufinfo.buf, bufinfo.len, max_length);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(zlib_decompress_decompress_obj, 2, 3, zlib_decompress_decompress);
+
+//|     def decompress_into(self, buf: WriteableBuffer, data: ReadableBuffer) -> int:
+//|         """Decompress *data* into *buf* and return the number of bytes written.
+//|
+//|         Nothing is allocated for the output. When *buf* fills up, the input that
+//|         wasn't needed is put in `unconsumed_tail` and must be passed in again.
+//|
+//|         :param WriteableBuffer buf: where to put the output
+//|         :param ReadableBuffer data: the next part of the compressed stream
+//|         """
+//|         ...
+//|
+static mp_obj_t zlib_decompress_decompress_into(mp_obj_t self_in, mp_obj_t buf_in, mp_obj_t data_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t buf;
+    mp_get_buffer_raise(buf_in, &buf, MP_BUFFER_WRITE);
+    mp_buffer_info_t data;
+    mp_get_buffer_raise(data_in, &data, MP_BUFFER_READ);
+    size_t written = common_hal_zlib_decompress_decompress_into(self, data.buf, data.len, buf.buf, buf.len);
+    return MP_OBJ_NEW_SMALL_INT(written);
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(zlib_decompress_decompress_into_obj, zlib_decompress_decompress_into);
+
+//|     def flush(self) -> bytes:
+//|         """Decompress what is left of `unconsumed_tail` and return the output."""
+//|         ...
+//|
+static mp_obj_t zlib_decompress_flush(mp_obj_t self_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(common_hal_zlib_decompress_get_unconsumed_tail(self), &bufinfo, MP_BUFFER_READ);
+    return common_hal_zlib_decompress_decompress(self, bufinfo.buf, bufinfo.len, 0);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(zlib_decompress_flush_obj, zlib_decompress_flush);
+
+//|     eof: bool
+//|     """True once the end of the compressed stream has been reached."""
+static mp_obj_t zlib_decompress_obj_get_eof(mp_obj_t self_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(common_hal_zlib_decompress_get_eof(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(zlib_decompress_get_eof_obj, zlib_decompress_obj_get_eof);
+
+MP_PROPERTY_GETTER(zlib_decompress_eof_obj,
+    (mp_obj_t)&zlib_decompress_get_eof_obj);
+
+//|     unused_data: bytes
+//|     """Data that was passed in after the end of the compressed stream."""
+static mp_obj_t zlib_decompress_obj_get_unused_data(mp_obj_t self_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_zlib_decompress_get_unused_data(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(zlib_decompress_get_unused_data_obj, zlib_decompress_obj_get_unused_data);
+
+MP_PROPERTY_GETTER(zlib_decompress_unused_data_obj,
+    (mp_obj_t)&zlib_decompress_get_unused_data_obj);
+
+//|     unconsumed_tail: bytes
+//|     """Input from the last call that wasn't decompressed because the output was full."""
+//|
+//|
+static mp_obj_t zlib_decompress_obj_get_unconsumed_tail(mp_obj_t self_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_zlib_decompress_get_unconsumed_tail(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(zlib_decompress_get_unconsumed_tail_obj, zlib_decompress_obj_get_unconsumed_tail);
+
+MP_PROPERTY_GETTER(zlib_decompress_unconsumed_tail_obj,
+    (mp_obj_t)&zlib_decompress_get_unconsumed_tail_obj);
+
+static const mp_rom_map_elem_t zlib_decompress_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_decompress), MP_ROM_PTR(&zlib_decompress_decompress_obj) },
+    { MP_ROM_QSTR(MP_QSTR_decompress_into), MP_ROM_PTR(&zlib_decompress_decompress_into_obj) },
+    { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&zlib_decompress_flush_obj) },
+    { MP_ROM_QSTR(MP_QSTR_eof), MP_ROM_PTR(&zlib_decompress_eof_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unused_data), MP_ROM_PTR(&zlib_decompress_unused_data_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unconsumed_tail), MP_ROM_PTR(&zlib_decompress_unconsumed_tail_obj) },
+};
+static MP_DEFINE_CONST_DICT(zlib_decompress_locals_dict, zlib_decompress_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    zlib_decompress_type,
+    MP_QSTR_Decompress,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    locals_dict, &zlib_decompress_locals_dict
+    );
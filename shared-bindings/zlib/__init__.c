@@ -18,6 +18,7 @@
 #include "py/parsenum.h"
 
 #include "shared-bindings/zlib/__init__.h"
+#include "shared-bindings/zlib/Decompress.h"
 
 //| """zlib decompression functionality
 //|
@@ -45,7 +46,9 @@
 //|
 //|     :param bytes data: data to be decompressed
 //|     :param int wbits: DEFLATE dictionary window size used during compression. See above.
-//|     :param int bufsize: ignored for compatibility with CPython only
+//|     :param int bufsize: expected size of the decompressed data. The output buffer starts at
+//|       this size and grows by half again whenever it fills up. When it is 0, gzip data
+//|       uses the size stored in its trailer and other data starts at twice its own size.
 //|     """
 //|     ...
 //|
@@ -53,16 +56,40 @@
 static mp_obj_t zlib_decompress(size_t n_args, const mp_obj_t *args) {
     mp_int_t wbits = 0;
     if (n_args > 1) {
-        wbits = MP_OBJ_SMALL_INT_VALUE(args[1]);
+        wbits = mp_obj_get_int(args[1]);
+    }
+    mp_int_t bufsize = 0;
+    if (n_args > 2) {
+        bufsize = mp_arg_validate_int_min(mp_obj_get_int(args[2]), 0, MP_QSTR_bufsize);
     }
 
-    return common_hal_zlib_decompress(args[0], wbits);
+    return common_hal_zlib_decompress(args[0], wbits, bufsize);
 }
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(zlib_decompress_obj, 1, 3, zlib_decompress);
 
+//| def decompressobj(wbits: Optional[int] = 15) -> Decompress:
+//|     """Return a `Decompress` object that decompresses a stream piece by piece, for data
+//|     that is too large to hold in memory all at once. *wbits* is the same as for
+//|     `decompress`, except that 0 uses the window size from the zlib header."""
+//|     ...
+//|
+//|
+static mp_obj_t zlib_decompressobj(size_t n_args, const mp_obj_t *args) {
+    mp_int_t wbits = 15;
+    if (n_args > 0) {
+        wbits = mp_obj_get_int(args[0]);
+    }
+    zlib_decompress_obj_t *self = mp_obj_malloc(zlib_decompress_obj_t, &zlib_decompress_type);
+    common_hal_zlib_decompress_construct(self, wbits);
+    return MP_OBJ_FROM_PTR(self);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(zlib_decompressobj_obj, 0, 1, zlib_decompressobj);
+
 static const mp_rom_map_elem_t zlib_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_zlib) },
     { MP_ROM_QSTR(MP_QSTR_decompress), MP_ROM_PTR(&zlib_decompress_obj) },
+    { MP_ROM_QSTR(MP_QSTR_decompressobj), MP_ROM_PTR(&zlib_decompressobj_obj) },
+    { MP_ROM_QSTR(MP_QSTR_Decompress), MP_ROM_PTR(&zlib_decompress_type) },
 };
 
 static MP_DEFINE_CONST_DICT(zlib_globals, zlib_globals_table);
@@ -6,4 +6,4 @@
 
 #pragma once
 
-mp_obj_t common_hal_zlib_decompress(mp_obj_t data, mp_int_t wbits);
+mp_obj_t common_hal_zlib_decompress(mp_obj_t data, mp_int_t wbits, mp_int_t bufsize);
@@ -0,0 +1,185 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "shared-bindings/audiocore/Resampler.h"
+#include "shared-bindings/audiocore/__init__.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "py/runtime.h"
+
+#define PHASE_ONE (1 << 16)
+
+void common_hal_audioio_resampler_construct(audioio_resampler_obj_t *self,
+    mp_obj_t sample, uint32_t sample_rate, uint8_t channel_count, uint32_t buffer_size) {
+    self->sample = sample;
+    self->base.sample_rate = sample_rate;
+    self->base.channel_count = channel_count;
+    self->base.bits_per_sample = 16;
+    self->base.samples_signed = true;
+    self->base.single_buffer = false;
+    self->base.max_buffer_length = buffer_size;
+
+    self->buffer_len = buffer_size;
+    self->buffer[0] = m_malloc(self->buffer_len);
+    self->buffer[1] = m_malloc(self->buffer_len);
+    self->last_buf_idx = 1;
+
+    audioio_resampler_reset_buffer(self, false, 0);
+}
+
+void common_hal_audioio_resampler_deinit(audioio_resampler_obj_t *self) {
+    audiosample_mark_deinit(&self->base);
+    self->sample = MP_OBJ_NULL;
+    self->buffer[0] = NULL;
+    self->buffer[1] = NULL;
+}
+
+mp_obj_t common_hal_audioio_resampler_get_sample(audioio_resampler_obj_t *self) {
+    return self->sample;
+}
+
+void audioio_resampler_reset_buffer(audioio_resampler_obj_t *self,
+    bool single_channel_output,
+    uint8_t channel) {
+    if (single_channel_output && channel == 1) {
+        return;
+    }
+    audiosample_base_t *source = MP_OBJ_TO_PTR(self->sample);
+    // Picked up here so that changes to either rate apply from the next play.
+    self->step = ((uint64_t)source->sample_rate << 16) / self->base.sample_rate;
+    self->phase = 0;
+    self->source_buffer = NULL;
+    self->source_length = 0;
+    self->source_done = false;
+    self->primed = false;
+    self->holding_last_frame = false;
+    self->finished = false;
+    self->read_count = 0;
+    self->left_read_count = 0;
+    self->right_read_count = 0;
+    audiosample_reset_buffer(self->sample, false, 0);
+}
+
+static inline int16_t read_source_value(const audiosample_base_t *source, const uint8_t *p) {
+    if (source->bits_per_sample == 16) {
+        int16_t value = *(const int16_t *)p;
+        return source->samples_signed ? value : (int16_t)(value ^ 0x8000);
+    }
+    int16_t value = (int16_t)(*p << 8);
+    return source->samples_signed ? value : (int16_t)(value ^ 0x8000);
+}
+
+// Reads the next frame of the source, converted to signed 16 bit with our
+// channel count. Returns false once the source has no more frames.
+static bool next_source_frame(audioio_resampler_obj_t *self, int16_t *frame) {
+    audiosample_base_t *source = MP_OBJ_TO_PTR(self->sample);
+    uint32_t bytes_per_value = source->bits_per_sample / 8;
+    uint32_t frame_size = bytes_per_value * source->channel_count;
+    while (self->source_length < frame_size) {
+        if (self->source_done) {
+            return false;
+        }
+        audioio_get_buffer_result_t result = audiosample_get_buffer(self->sample, false, 0,
+            &self->source_buffer, &self->source_length);
+        self->source_done = result != GET_BUFFER_MORE_DATA;
+        if (result == GET_BUFFER_ERROR) {
+            self->source_length = 0;
+        }
+    }
+    int16_t first = read_source_value(source, self->source_buffer);
+    if (source->channel_count == 1) {
+        frame[0] = first;
+        frame[1] = first;
+    } else {
+        int16_t second = read_source_value(source, self->source_buffer + bytes_per_value);
+        if (self->base.channel_count == 1) {
+            frame[0] = (first + second) / 2;
+        } else {
+            frame[0] = first;
+            frame[1] = second;
+        }
+    }
+    self->source_buffer += frame_size;
+    self->source_length -= frame_size;
+    return true;
+}
+
+// Linear interpolation between the two source frames either side of each
+// output frame. The fraction is reduced to 15 bits so the product of it and
+// a 17 bit difference fits in 32 bits, which keeps this to one 32x32
+// multiply per value on cores without a 64 bit multiplier.
+static uint32_t resample(audioio_resampler_obj_t *self, int16_t *out, uint32_t frames) {
+    uint8_t channel_count = self->base.channel_count;
+    uint32_t produced = 0;
+    while (produced < frames && !self->finished) {
+        int32_t fraction = self->phase >> 1;
+        for (uint8_t c = 0; c < channel_count; c++) {
+            int32_t a = self->frame_a[c];
+            int32_t b = self->frame_b[c];
+            *out++ = a + (((b - a) * fraction) >> 15);
+        }
+        produced++;
+        self->phase += self->step;
+        while (self->phase >= PHASE_ONE) {
+            self->phase -= PHASE_ONE;
+            if (self->holding_last_frame) {
+                self->finished = true;
+                break;
+            }
+            memcpy(self->frame_a, self->frame_b, sizeof(self->frame_a));
+            if (!next_source_frame(self, self->frame_b)) {
+                self->holding_last_frame = true;
+            }
+        }
+    }
+    return produced;
+}
+
+audioio_get_buffer_result_t audioio_resampler_get_buffer(audioio_resampler_obj_t *self,
+    bool single_channel_output,
+    uint8_t channel,
+    uint8_t **buffer,
+    uint32_t *buffer_length) {
+    if (!single_channel_output) {
+        channel = 0;
+    }
+
+    uint32_t channel_read_count = self->left_read_count;
+    if (channel == 1) {
+        channel_read_count = self->right_read_count;
+    }
+
+    if (self->read_count == channel_read_count) {
+        self->last_buf_idx = !self->last_buf_idx;
+        int16_t *out = self->buffer[self->last_buf_idx];
+        uint32_t frames = self->buffer_len / (sizeof(int16_t) * self->base.channel_count);
+
+        if (!self->primed) {
+            self->primed = true;
+            if (next_source_frame(self, self->frame_a)) {
+                memcpy(self->frame_b, self->frame_a, sizeof(self->frame_b));
+                self->holding_last_frame = !next_source_frame(self, self->frame_b);
+            } else {
+                self->finished = true;
+            }
+        }
+        uint32_t produced = resample(self, out, frames);
+        self->buffer_len_produced = produced * sizeof(int16_t) * self->base.channel_count;
+        self->read_count += 1;
+    }
+
+    *buffer = (uint8_t *)self->buffer[self->last_buf_idx];
+    *buffer_length = self->buffer_len_produced;
+    if (channel == 0) {
+        self->left_read_count += 1;
+    } else if (channel == 1) {
+        self->right_read_count += 1;
+        *buffer = *buffer + sizeof(int16_t);
+    }
+    return self->finished ? GET_BUFFER_DONE : GET_BUFFER_MORE_DATA;
+}
@@ -0,0 +1,50 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+#include "shared-module/audiocore/__init__.h"
+
+typedef struct {
+    audiosample_base_t base;
+    mp_obj_t sample;
+    int16_t *buffer[2];
+    uint32_t buffer_len; // in bytes
+    uint32_t buffer_len_produced; // in bytes, of the last filled buffer
+    uint8_t last_buf_idx;
+
+    // How far to advance through the source for each output frame, and how
+    // far between frame_a and frame_b the next output frame lies, in 16.16
+    // fixed point.
+    uint32_t step;
+    uint32_t phase;
+    int16_t frame_a[2];
+    int16_t frame_b[2];
+
+    uint8_t *source_buffer;
+    uint32_t source_length; // in bytes
+    bool source_done;
+    bool primed;
+    // frame_b is the last frame of the source, repeated to fill its duration.
+    bool holding_last_frame;
+    bool finished;
+
+    uint32_t read_count;
+    uint32_t left_read_count;
+    uint32_t right_read_count;
+} audioio_resampler_obj_t;
+
+// These are not available from Python because it may be called in an interrupt.
+void audioio_resampler_reset_buffer(audioio_resampler_obj_t *self,
+    bool single_channel_output,
+    uint8_t channel);
+audioio_get_buffer_result_t audioio_resampler_get_buffer(audioio_resampler_obj_t *self,
+    bool single_channel_output,
+    uint8_t channel,
+    uint8_t **buffer,
+    uint32_t *buffer_length);                                                      // length in bytes
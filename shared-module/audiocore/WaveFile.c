@@ -29,10 +29,58 @@ struct wave_format_chunk {
     uint8_t extended_guid[14];
 };
 
+static bool audioio_wavefile_read(void *self_in, uint8_t *buffer, uint32_t length, uint32_t *length_read, bool *end) {
+    audioio_wavefile_obj_t *self = self_in;
+    FIL *fp = &self->file->fp;
+    if (length >= self->bytes_remaining) {
+        length = self->bytes_remaining;
+    } else if (audiocore_read_ahead_depth(&self->read_ahead) > 0) {
+        // End the read on a sector boundary if that still leaves whole
+        // blocks. Then the following reads are of whole sectors, which the
+        // filesystem reads straight into the buffer, a cluster at a time.
+        // The blocks that are left out are read next, in the same fill.
+        // Without read ahead every block is read on its own, as before.
+        #if FF_MAX_SS == FF_MIN_SS
+        uint32_t sector_size = FF_MIN_SS;
+        #else
+        uint32_t sector_size = fp->obj.fs->ssize;
+        #endif
+        uint32_t past_sector = (f_tell(fp) + length) % sector_size;
+        uint32_t block_size = self->read_ahead.block_size;
+        if (past_sector < length && (length - past_sector) % block_size == 0) {
+            length -= past_sector;
+        }
+    }
+    UINT read;
+    if (f_read(fp, buffer, length, &read) != FR_OK || read != length) {
+        return false;
+    }
+    self->bytes_remaining -= read;
+    // Pad the last block to word align it.
+    if (self->bytes_remaining == 0 && read % sizeof(uint32_t) != 0) {
+        uint32_t pad = sizeof(uint32_t) - read % sizeof(uint32_t);
+        if (self->base.bits_per_sample == 8) {
+            memset(buffer + read, 0x80, pad);
+        } else {
+            memset(buffer + read, 0, pad);
+        }
+        read += pad;
+    }
+    *length_read = read;
+    *end = self->bytes_remaining == 0;
+    return true;
+}
+
+static void audioio_wavefile_fill(void *self_in) {
+    audioio_wavefile_obj_t *self = self_in;
+    audiocore_read_ahead_fill(&self->read_ahead);
+}
+
 void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t *self,
     pyb_file_obj_t *file,
     uint8_t *buffer,
-    size_t buffer_size) {
+    size_t buffer_size,
+    uint8_t read_ahead) {
     // Load the wave
     self->file = file;
     uint8_t chunk_header[16];
@@ -111,34 +159,34 @@ void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t *self,
     self->file_length = chunk_length;
     self->data_start = self->file->fp.fptr;
 
-    // Try to allocate two buffers, one will be loaded from file and the other
-    // DMAed to DAC.
+    // The audio output plays from two blocks while the rest are loaded from
+    // the file. Blocks of whole sectors let most of each read skip the
+    // filesystem's sector buffer.
+    uint8_t block_count = read_ahead + AUDIOCORE_READ_AHEAD_HELD_BLOCKS;
+    uint32_t block_size;
     if (buffer_size) {
-        self->len = buffer_size / 2;
-        self->buffer = buffer;
-        self->second_buffer = buffer + self->len;
+        // Keep blocks to whole 32 bit words.
+        block_size = (buffer_size / block_count) & ~(sizeof(uint32_t) - 1);
     } else {
-        self->len = 256;
-        self->buffer = m_malloc(self->len);
-        if (self->buffer == NULL) {
-            common_hal_audioio_wavefile_deinit(self);
-            m_malloc_fail(self->len);
-        }
-
-        self->second_buffer = m_malloc(self->len);
-        if (self->second_buffer == NULL) {
-            common_hal_audioio_wavefile_deinit(self);
-            m_malloc_fail(self->len);
-        }
+        block_size = read_ahead > 0 ? 512 : 256;
+        buffer = m_malloc(block_count * block_size);
     }
+    self->bytes_remaining = 0;
+    audiocore_read_ahead_init(&self->read_ahead, buffer, block_size, read_ahead,
+        audioio_wavefile_read, audioio_wavefile_fill, self);
 }
 
 void common_hal_audioio_wavefile_deinit(audioio_wavefile_obj_t *self) {
-    self->buffer = NULL;
-    self->second_buffer = NULL;
+    audiocore_read_ahead_deinit(&self->read_ahead);
+    self->buffer[0] = NULL;
+    self->buffer[1] = NULL;
     audiosample_mark_deinit(&self->base);
 }
 
+uint32_t common_hal_audioio_wavefile_get_underruns(audioio_wavefile_obj_t *self) {
+    return self->read_ahead.underruns;
+}
+
 void audioio_wavefile_reset_buffer(audioio_wavefile_obj_t *self,
     bool single_channel_output,
     uint8_t channel) {
@@ -152,6 +200,7 @@ void audioio_wavefile_reset_buffer(audioio_wavefile_obj_t *self,
     self->read_count = 0;
     self->left_read_count = 0;
     self->right_read_count = 0;
+    audiocore_read_ahead_reset(&self->read_ahead);
 }
 
 audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t *self,
@@ -170,61 +219,29 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t *
 
     bool need_more_data = self->read_count == channel_read_count;
 
-    if (self->bytes_remaining == 0 && need_more_data) {
-        *buffer = NULL;
-        *buffer_length = 0;
-        return GET_BUFFER_DONE;
-    }
-
     if (need_more_data) {
-        uint32_t num_bytes_to_load = self->len;
-        if (num_bytes_to_load > self->bytes_remaining) {
-            num_bytes_to_load = self->bytes_remaining;
-        }
-        UINT length_read;
-        if (self->buffer_index % 2 == 1) {
-            *buffer = self->second_buffer;
-        } else {
-            *buffer = self->buffer;
-        }
-        if (f_read(&self->file->fp, *buffer, num_bytes_to_load, &length_read) != FR_OK || length_read != num_bytes_to_load) {
-            return GET_BUFFER_ERROR;
-        }
-        self->bytes_remaining -= length_read;
-        // Pad the last buffer to word align it.
-        if (self->bytes_remaining == 0 && length_read % sizeof(uint32_t) != 0) {
-            uint32_t pad = length_read % sizeof(uint32_t);
-            length_read += pad;
-            if (self->base.bits_per_sample == 8) {
-                for (uint32_t i = 0; i < pad; i++) {
-                    ((uint8_t *)(*buffer))[length_read / sizeof(uint8_t) - i - 1] = 0x80;
-                }
-            } else if (self->base.bits_per_sample == 16) {
-                // We know the buffer is aligned because we allocated it onto the heap ourselves.
-                #pragma GCC diagnostic push
-                #pragma GCC diagnostic ignored "-Wcast-align"
-                ((int16_t *)(*buffer))[length_read / sizeof(int16_t) - 1] = 0;
-                #pragma GCC diagnostic pop
+        uint8_t *block;
+        uint32_t block_length = 0;
+        if (!audiocore_read_ahead_done(&self->read_ahead)) {
+            if (!audiocore_read_ahead_take(&self->read_ahead, &block, &block_length)) {
+                return GET_BUFFER_ERROR;
             }
         }
-        *buffer_length = length_read;
-        if (self->buffer_index % 2 == 1) {
-            self->second_buffer_length = length_read;
-        } else {
-            self->buffer_length = length_read;
+        if (block_length == 0) {
+            *buffer = NULL;
+            *buffer_length = 0;
+            return GET_BUFFER_DONE;
         }
         self->buffer_index += 1;
+        self->buffer[self->buffer_index % 2] = block;
+        self->buffer_length[self->buffer_index % 2] = block_length;
         self->read_count += 1;
     }
 
     uint32_t buffers_back = self->read_count - 1 - channel_read_count;
-    if ((self->buffer_index - buffers_back) % 2 == 0) {
-        *buffer = self->second_buffer;
-        *buffer_length = self->second_buffer_length;
-    } else {
-        *buffer = self->buffer;
-        *buffer_length = self->buffer_length;
-    }
+    uint16_t index = (self->buffer_index - buffers_back) % 2;
+    *buffer = self->buffer[index];
+    *buffer_length = self->buffer_length[index];
 
     if (channel == 0) {
         self->left_read_count += 1;
@@ -233,5 +250,6 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t *
         *buffer = *buffer + self->base.bits_per_sample / 8;
     }
 
-    return self->bytes_remaining == 0 ? GET_BUFFER_DONE : GET_BUFFER_MORE_DATA;
+    bool done = audiocore_read_ahead_done(&self->read_ahead);
+    return done ? GET_BUFFER_DONE : GET_BUFFER_MORE_DATA;
 }
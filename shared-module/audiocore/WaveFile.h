@@ -10,19 +10,19 @@
 #include "py/obj.h"
 
 #include "shared-module/audiocore/__init__.h"
+#include "shared-module/audiocore/read_ahead.h"
 
 typedef struct {
     audiosample_base_t base;
-    uint8_t *buffer;
-    uint32_t buffer_length;
-    uint8_t *second_buffer;
-    uint32_t second_buffer_length;
+    audiocore_read_ahead_t read_ahead;
+    // The last two blocks handed out, indexed by buffer_index.
+    uint8_t *buffer[2];
+    uint32_t buffer_length[2];
     uint32_t file_length; // In bytes
     uint16_t data_start; // Where the data values start
     uint16_t buffer_index;
-    uint32_t bytes_remaining;
+    uint32_t bytes_remaining; // Not yet read from the file
 
-    uint32_t len;
     pyb_file_obj_t *file;
 
     uint32_t read_count;
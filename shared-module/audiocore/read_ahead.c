@@ -0,0 +1,127 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "shared-module/audiocore/read_ahead.h"
+
+#include "py/misc.h"
+
+#if defined(MICROPY_UNIX_COVERAGE)
+#define background_callback_add(buf, fn, arg) ((fn)((arg)))
+#endif
+
+void audiocore_read_ahead_init(audiocore_read_ahead_t *self, uint8_t *buffer, uint32_t block_size, uint8_t depth,
+    audiocore_read_ahead_read_fun read, background_callback_fun fill, void *source) {
+    self->fill_cb.priority = BACKGROUND_CALLBACK_PRIORITY_AUDIO;
+    self->fill = fill;
+    self->read = read;
+    self->source = source;
+    self->buffer = buffer;
+    self->block_size = block_size;
+    self->block_count = depth + AUDIOCORE_READ_AHEAD_HELD_BLOCKS;
+    spsc_ring_init(&self->ready_blocks, self->ready_storage, AUDIOCORE_READ_AHEAD_RING_SIZE);
+    self->next = 0;
+    self->fill_block = 0;
+    self->exhausted = true;
+    self->error = false;
+    self->underruns = 0;
+}
+
+void audiocore_read_ahead_deinit(audiocore_read_ahead_t *self) {
+    // A fill that is still queued sees this and does nothing.
+    self->buffer = NULL;
+}
+
+// Reads until max_ready blocks are ready.
+static void read_blocks(audiocore_read_ahead_t *self, uint8_t max_ready) {
+    uint8_t ready;
+    while ((ready = audiocore_read_ahead_ready(self)) < max_ready && !self->exhausted && !self->error) {
+        uint8_t block = self->fill_block;
+        // Read all of the free blocks up to the end of the ring at once, so
+        // the filesystem can read runs of whole sectors straight into them.
+        uint8_t blocks = MIN(max_ready - ready, self->block_count - block);
+        uint32_t length_read;
+        bool end = false;
+        if (!self->read(self->source, self->buffer + block * self->block_size, blocks * self->block_size, &length_read, &end)) {
+            __atomic_store_n(&self->error, true, __ATOMIC_RELEASE);
+            return;
+        }
+        // A short read still fills the blocks in order, so the next read
+        // starts in the block after the last one that was written. Each
+        // block's length is set before its number goes into the ring.
+        end = end || length_read == 0;
+        while (length_read > 0) {
+            uint32_t length = MIN(length_read, self->block_size);
+            self->block_length[block] = length;
+            spsc_ring_write(&self->ready_blocks, &block, 1);
+            block += 1;
+            length_read -= length;
+        }
+        self->fill_block = block % self->block_count;
+        if (end) {
+            __atomic_store_n(&self->exhausted, true, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+// Waits until half of the blocks read ahead have been used, so that each fill
+// reads several blocks at once instead of one every time a block is taken.
+static void schedule_fill(audiocore_read_ahead_t *self) {
+    uint8_t ready = audiocore_read_ahead_ready(self);
+    uint8_t depth = audiocore_read_ahead_depth(self);
+    if (ready <= depth / 2 && ready < depth &&
+        !__atomic_load_n(&self->exhausted, __ATOMIC_ACQUIRE) && !__atomic_load_n(&self->error, __ATOMIC_ACQUIRE)) {
+        background_callback_add(&self->fill_cb, self->fill, self->source);
+    }
+}
+
+void audiocore_read_ahead_reset(audiocore_read_ahead_t *self) {
+    // next is kept because the audio output may still be playing the blocks
+    // before it.
+    spsc_ring_clear(&self->ready_blocks);
+    self->fill_block = self->next;
+    self->exhausted = false;
+    self->error = false;
+    read_blocks(self, 1);
+    schedule_fill(self);
+}
+
+void audiocore_read_ahead_fill(audiocore_read_ahead_t *self) {
+    if (self->buffer == NULL) {
+        return;
+    }
+    read_blocks(self, audiocore_read_ahead_depth(self));
+}
+
+bool audiocore_read_ahead_take(audiocore_read_ahead_t *self, uint8_t **buffer, uint32_t *length) {
+    // The flags are set after the blocks they follow are in the ring, so they
+    // are checked before the ring is.
+    bool exhausted = __atomic_load_n(&self->exhausted, __ATOMIC_ACQUIRE);
+    bool error = __atomic_load_n(&self->error, __ATOMIC_ACQUIRE);
+    uint8_t block;
+    bool taken = spsc_ring_read(&self->ready_blocks, &block, 1) == 1;
+    if (!taken && !exhausted && !error) {
+        // The ring has run dry, so the block is read now.
+        if (audiocore_read_ahead_depth(self) > 0) {
+            self->underruns += 1;
+        }
+        read_blocks(self, 1);
+        error = self->error;
+        taken = spsc_ring_read(&self->ready_blocks, &block, 1) == 1;
+    }
+    if (!taken) {
+        if (error) {
+            return false;
+        }
+        *buffer = NULL;
+        *length = 0;
+        return true;
+    }
+    *buffer = self->buffer + block * self->block_size;
+    *length = self->block_length[block];
+    self->next = (block + 1) % self->block_count;
+    schedule_fill(self);
+    return true;
+}
@@ -0,0 +1,113 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "supervisor/background_callback.h"
+#include "supervisor/shared/spsc_ring.h"
+
+// Reads a file backed sample into a ring of equally sized blocks ahead of
+// playback, from a background callback. The audio output holds on to the last
+// two blocks it was given, so the rest of the ring can be filled while they
+// play. get_buffer only has to wait for the file when the blocks read ahead
+// have run out, which is counted as an underrun.
+//
+// Blocks are handed from the fill to get_buffer through a spsc_ring_t of
+// block numbers, and the end of the data is only marked once its last block
+// is in the ring. So a block can be taken while a fill is part way through.
+//
+// Most audio outputs call get_buffer from background callbacks, which never
+// run during a fill. Some, such as audiopwmio on the STM port, call it from an
+// interrupt. There get_buffer can't read a block itself when the ring has run
+// dry, because a fill may be part way through a read of the same file, so
+// those ports set CIRCUITPY_AUDIOCORE_READ_AHEAD_MAX to 0. Without read ahead
+// there are no fills, and get_buffer reads every block as it always has.
+
+// The most blocks a sample may read ahead.
+#ifndef CIRCUITPY_AUDIOCORE_READ_AHEAD_MAX
+#define CIRCUITPY_AUDIOCORE_READ_AHEAD_MAX (8)
+#endif
+
+// The number of blocks read ahead when a sample doesn't ask for a number.
+#ifndef CIRCUITPY_AUDIOCORE_READ_AHEAD
+#if CIRCUITPY_FULL_BUILD && CIRCUITPY_AUDIOCORE_READ_AHEAD_MAX >= 2
+#define CIRCUITPY_AUDIOCORE_READ_AHEAD (2)
+#else
+#define CIRCUITPY_AUDIOCORE_READ_AHEAD (0)
+#endif
+#endif
+
+#define AUDIOCORE_READ_AHEAD_MAX CIRCUITPY_AUDIOCORE_READ_AHEAD_MAX
+// Blocks that the audio output may still be playing from.
+#define AUDIOCORE_READ_AHEAD_HELD_BLOCKS (2)
+// Room in the ring of ready block numbers. A power of two that fits them all.
+#define AUDIOCORE_READ_AHEAD_RING_SIZE (16)
+
+// Reads up to length bytes into buffer and sets length_read. end is set once
+// the source has no more data after this read, and a read of zero bytes
+// means the same. Returns false on error.
+typedef bool (*audiocore_read_ahead_read_fun)(void *source, uint8_t *buffer, uint32_t length, uint32_t *length_read, bool *end);
+
+typedef struct {
+    background_callback_t fill_cb;
+    // Called in the background with source, which must be the object on the
+    // GC heap that owns this. It should call audiocore_read_ahead_fill().
+    background_callback_fun fill;
+    audiocore_read_ahead_read_fun read;
+    void *source;
+
+    uint8_t *buffer;
+    uint32_t block_size;
+    uint16_t block_length[AUDIOCORE_READ_AHEAD_MAX + AUDIOCORE_READ_AHEAD_HELD_BLOCKS];
+    uint8_t block_count;
+    // Numbers of the blocks that have been read, in the order they play.
+    spsc_ring_t ready_blocks;
+    uint8_t ready_storage[AUDIOCORE_READ_AHEAD_RING_SIZE];
+    uint8_t next; // The block to hand out next. Only changed by take.
+    uint8_t fill_block; // The block to read into next. Only changed by fills.
+    // Only set by fills, and only cleared by reset.
+    bool exhausted;
+    bool error;
+
+    uint32_t underruns;
+} audiocore_read_ahead_t;
+
+// buffer must hold (depth + AUDIOCORE_READ_AHEAD_HELD_BLOCKS) blocks of
+// block_size bytes.
+void audiocore_read_ahead_init(audiocore_read_ahead_t *self, uint8_t *buffer, uint32_t block_size, uint8_t depth,
+    audiocore_read_ahead_read_fun read, background_callback_fun fill, void *source);
+void audiocore_read_ahead_deinit(audiocore_read_ahead_t *self);
+
+// Drops the blocks read ahead after the source has been rewound and reads the
+// first block again so that playback can start without waiting. Must not be
+// called during a fill.
+void audiocore_read_ahead_reset(audiocore_read_ahead_t *self);
+
+// Fills the ring. Called from the background callback.
+void audiocore_read_ahead_fill(audiocore_read_ahead_t *self);
+
+// Hands out the next block, reading it now if it isn't ready yet. length is
+// set to 0 once the source has no more data. Returns false on error.
+bool audiocore_read_ahead_take(audiocore_read_ahead_t *self, uint8_t **buffer, uint32_t *length);
+
+static inline uint8_t audiocore_read_ahead_ready(const audiocore_read_ahead_t *self) {
+    return spsc_ring_num_filled(&self->ready_blocks);
+}
+
+// True once every block of the source has been taken.
+static inline bool audiocore_read_ahead_done(const audiocore_read_ahead_t *self) {
+    // exhausted is set after the last block is in the ring, so it has to be
+    // checked first.
+    return __atomic_load_n(&self->exhausted, __ATOMIC_ACQUIRE) && audiocore_read_ahead_ready(self) == 0;
+}
+
+// How many blocks are read ahead of the ones the audio output holds.
+static inline uint8_t audiocore_read_ahead_depth(const audiocore_read_ahead_t *self) {
+    return self->block_count - AUDIOCORE_READ_AHEAD_HELD_BLOCKS;
+}
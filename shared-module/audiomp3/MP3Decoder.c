@@ -294,6 +294,8 @@ void common_hal_audiomp3_mp3file_construct(audiomp3_mp3file_obj_t *self,
     // than the two 4kB output pcm_buffer, except that the alignment allows to
     // never allocate that extra frame buffer.
 
+    self->inbuf_fill_cb.priority = BACKGROUND_CALLBACK_PRIORITY_AUDIO;
+
     if ((intptr_t)buffer & 1) {
         buffer += 1;
         buffer_size -= 1;
@@ -329,6 +331,7 @@ void common_hal_audiomp3_mp3file_construct(audiomp3_mp3file_obj_t *self,
         }
     }
     self->inbuf.read_off = self->inbuf.write_off = 0;
+    self->underruns = 0;
 
     self->decoder = MP3InitDecoder();
     if (self->decoder == NULL) {
@@ -465,6 +468,9 @@ audioio_get_buffer_result_t audiomp3_mp3file_get_buffer(audiomp3_mp3file_obj_t *
     if (!mp3file_find_sync_word(self, false)) {
         memset(buffer, 0, self->base.max_buffer_length);
         *buffer_length = 0;
+        if (!self->eof) {
+            self->underruns += 1;
+        }
         return self->eof ? GET_BUFFER_DONE : GET_BUFFER_ERROR;
     }
     int bytes_left = BYTES_LEFT(self);
@@ -484,6 +490,11 @@ audioio_get_buffer_result_t audiomp3_mp3file_get_buffer(audiomp3_mp3file_obj_t *
             self->eof = true;
             return GET_BUFFER_ERROR;
         }
+        // The background fill hasn't kept up, so this frame plays as silence.
+        // (Missing main data is normal for the first frames of a stream.)
+        if (err == ERR_MP3_INDATA_UNDERFLOW) {
+            self->underruns += 1;
+        }
     }
 
     self->samples_decoded += frame_buffer_size_bytes / sizeof(int16_t);
@@ -520,3 +531,7 @@ float common_hal_audiomp3_mp3file_get_rms_level(audiomp3_mp3file_obj_t *self) {
 uint32_t common_hal_audiomp3_mp3file_get_samples_decoded(audiomp3_mp3file_obj_t *self) {
     return self->samples_decoded;
 }
+
+uint32_t common_hal_audiomp3_mp3file_get_underruns(audiomp3_mp3file_obj_t *self) {
+    return self->underruns;
+}
@@ -39,6 +39,7 @@ typedef struct {
     int8_t other_buffer_index;
 
     uint32_t samples_decoded;
+    uint32_t underruns;
 } audiomp3_mp3file_obj_t;
 
 // These are not available from Python because it may be called in an interrupt.
@@ -216,16 +216,15 @@ void common_hal_bitmaptools_fill_region(displayio_bitmap_t *destination,
     displayio_area_canon(&area);
 
     displayio_area_t bitmap_area = { 0, 0, destination->width, destination->height, NULL };
-    displayio_area_compute_overlap(&area, &bitmap_area, &area);
+    if (!displayio_area_compute_overlap(&area, &bitmap_area, &area)) {
+        return;
+    }
 
     // update the dirty rectangle
     displayio_bitmap_set_dirty_area(destination, &area);
 
-    int16_t x, y;
-    for (x = area.x1; x < area.x2; x++) {
-        for (y = area.y1; y < area.y2; y++) {
-            displayio_bitmap_write_pixel(destination, x, y, value);
-        }
+    for (int16_t y = area.y1; y < area.y2; y++) {
+        displayio_bitmap_fill_row(destination, area.x1, y, displayio_area_width(&area), value);
     }
 }
 
@@ -1034,6 +1033,63 @@ void common_hal_bitmaptools_draw_circle(displayio_bitmap_t *destination,
     draw_circle(destination, x, y, radius, value);
 }
 
+// Number of values blit copies at once when it can't move whole rows of memory.
+#define BLIT_CHUNK_LENGTH (32)
+
+// Copies count values from row ys of source to row yd of destination a chunk at a time. Chunks go
+// right to left when reverse so overlapping copies within one bitmap work.
+static void _blit_row_values(displayio_bitmap_t *destination, displayio_bitmap_t *source,
+    int16_t xd, int16_t yd, int16_t xs, int16_t ys, uint16_t count, bool reverse,
+    uint32_t skip_source_index, bool skip_source_index_none, uint32_t skip_dest_index, bool skip_dest_index_none) {
+    uint32_t values[BLIT_CHUNK_LENGTH];
+    uint32_t dest_values[BLIT_CHUNK_LENGTH];
+    bool skip = !skip_source_index_none || !skip_dest_index_none;
+    uint16_t done = 0;
+    while (done < count) {
+        uint16_t n = MIN(count - done, BLIT_CHUNK_LENGTH);
+        uint16_t offset = reverse ? count - done - n : done;
+        displayio_bitmap_read_row(source, xs + offset, ys, values, n);
+        if (skip) {
+            // Skipped pixels keep the destination's value so the whole chunk can be written at once.
+            displayio_bitmap_read_row(destination, xd + offset, yd, dest_values, n);
+            for (uint16_t i = 0; i < n; i++) {
+                if ((!skip_source_index_none && values[i] == skip_source_index) ||
+                    (!skip_dest_index_none && dest_values[i] == skip_dest_index)) {
+                    values[i] = dest_values[i];
+                }
+            }
+        }
+        displayio_bitmap_write_row(destination, xd + offset, yd, values, n);
+        done += n;
+    }
+}
+
+// Copies count values between rows of bitmaps with the same depth whose values start at the same
+// position within a byte. memmove handles overlapping rows of the same bitmap.
+static void _blit_row_memory(displayio_bitmap_t *destination, displayio_bitmap_t *source,
+    int16_t xd, int16_t yd, int16_t xs, int16_t ys, uint16_t count) {
+    uint8_t *dest_row = (uint8_t *)(destination->data + yd * destination->stride);
+    const uint8_t *source_row = (const uint8_t *)(source->data + ys * source->stride);
+    if (destination->bits_per_value >= 8) {
+        uint8_t bytes_per_value = destination->bits_per_value / 8;
+        memmove(dest_row + xd * bytes_per_value, source_row + xs * bytes_per_value, count * bytes_per_value);
+        return;
+    }
+    // Partial bytes at either end are copied a value at a time. Read them before moving the whole
+    // bytes because the move may overwrite them.
+    uint8_t values_per_byte = 8 / destination->bits_per_value;
+    uint16_t lead = MIN((values_per_byte - (xd & destination->x_mask)) & destination->x_mask, count);
+    uint16_t whole = (count - lead) / values_per_byte;
+    uint16_t trail = count - lead - whole * values_per_byte;
+    uint32_t lead_values[8];
+    uint32_t trail_values[8];
+    displayio_bitmap_read_row(source, xs, ys, lead_values, lead);
+    displayio_bitmap_read_row(source, xs + count - trail, ys, trail_values, trail);
+    memmove(dest_row + ((xd + lead) >> destination->x_shift), source_row + ((xs + lead) >> source->x_shift), whole);
+    displayio_bitmap_write_row(destination, xd, yd, lead_values, lead);
+    displayio_bitmap_write_row(destination, xd + count - trail, yd, trail_values, trail);
+}
+
 void common_hal_bitmaptools_blit(displayio_bitmap_t *destination, displayio_bitmap_t *source, int16_t x, int16_t y,
     int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint32_t skip_source_index, bool skip_source_index_none, uint32_t skip_dest_index,
     bool skip_dest_index_none) {
@@ -1070,34 +1126,34 @@ void common_hal_bitmaptools_blit(displayio_bitmap_t *destination, displayio_bitm
         y_reverse = true;
     }
 
-    // simplest version - use internal functions for get/set pixels
-    for (int16_t i = 0; i < (x2 - x1); i++) {
-
-        const int xs_index = x_reverse ? ((x2) - i - 1) : x1 + i; // x-index into the source bitmap
-        const int xd_index = x_reverse ? ((x + (x2 - x1)) - i - 1) : x + i; // x-index into the destination bitmap
-
-        if ((xd_index >= 0) && (xd_index < destination->width)) {
-            for (int16_t j = 0; j < (y2 - y1); j++) {
-
-                const int ys_index = y_reverse ? ((y2) - j - 1) : y1 + j;  // y-index into the source bitmap
-                const int yd_index = y_reverse ? ((y + (y2 - y1)) - j - 1) : y + j; // y-index into the destination bitmap
-
-                if ((yd_index >= 0) && (yd_index < destination->height)) {
-                    uint32_t value = common_hal_displayio_bitmap_get_pixel(source, xs_index, ys_index);
-                    if (skip_dest_index_none) { // if skip_dest_index is none, then only check source skip
-                        if ((skip_source_index_none) || (value != skip_source_index)) {   // write if skip_value_none is True
-                            displayio_bitmap_write_pixel(destination, xd_index, yd_index, value);
-                        }
-                    } else { // check dest_value index against skip_dest_index and skip if they match
-                        uint32_t dest_value = common_hal_displayio_bitmap_get_pixel(destination, xd_index, yd_index);
-                        if (dest_value != skip_dest_index) {
-                            if ((skip_source_index_none) || (value != skip_source_index)) {   // write if skip_value_none is True
-                                displayio_bitmap_write_pixel(destination, xd_index, yd_index, value);
-                            }
-                        }
-                    }
-                }
-            }
+    // Clip to the destination and move the source region to match.
+    if (x < 0) {
+        x1 -= x;
+        x = 0;
+    }
+    if (y < 0) {
+        y1 -= y;
+        y = 0;
+    }
+    int16_t width = MIN(x2 - x1, destination->width - x);
+    int16_t height = MIN(y2 - y1, destination->height - y);
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    // Rows can be moved as memory when nothing is skipped and the values line up within bytes.
+    bool move_rows = skip_source_index_none && skip_dest_index_none &&
+        destination->bits_per_value == source->bits_per_value &&
+        (x & destination->x_mask) == (x1 & source->x_mask) &&
+        x1 >= 0 && y1 >= 0 && x1 + width <= source->width && y1 + height <= source->height;
+
+    for (int16_t j = 0; j < height; j++) {
+        int16_t row = y_reverse ? height - j - 1 : j;
+        if (move_rows) {
+            _blit_row_memory(destination, source, x, y + row, x1, y1 + row, width);
+        } else {
+            _blit_row_values(destination, source, x, y + row, x1, y1 + row, width, x_reverse,
+                skip_source_index, skip_source_index_none, skip_dest_index, skip_dest_index_none);
         }
     }
 }
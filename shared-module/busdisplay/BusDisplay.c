@@ -213,6 +213,22 @@ static void _send_pixels(busdisplay_busdisplay_obj_t *self, uint8_t *pixels, uin
     self->bus.send(self->bus.bus, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, pixels, length);
 }
 
+void busdisplay_busdisplay_wait_for_write(busdisplay_busdisplay_obj_t *self) {
+    while (!displayio_display_bus_is_free(&self->bus)) {
+        RUN_BACKGROUND_TASKS;
+    }
+}
+
+void busdisplay_busdisplay_write_area(busdisplay_busdisplay_obj_t *self, displayio_area_t *area, uint8_t *pixels, uint32_t length) {
+    // Wait for anything still in flight, such as a previous call's pixels, to
+    // finish before starting on the next window.
+    busdisplay_busdisplay_wait_for_write(self);
+    displayio_display_bus_set_region_to_update(&self->bus, &self->core, area);
+    displayio_display_bus_begin_transaction(&self->bus);
+    _send_pixels(self, pixels, length);
+    displayio_display_bus_end_transaction(&self->bus);
+}
+
 static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_area_t *area) {
     uint16_t buffer_size = 128; // In uint32_ts
 
@@ -257,7 +273,7 @@ static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_are
     // Allocated and shared as a uint32_t array so the compiler knows the
     // alignment everywhere.
     uint32_t buffer[buffer_size];
-    uint32_t mask_length = (pixels_per_buffer / 32) + 1;
+    uint32_t mask_length = DISPLAYIO_MASK_LENGTH(pixels_per_buffer);
     uint32_t mask[mask_length];
     uint16_t remaining_rows = displayio_area_height(&clipped);
 
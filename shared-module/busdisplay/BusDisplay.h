@@ -41,3 +41,9 @@ void busdisplay_busdisplay_background(busdisplay_busdisplay_obj_t *self);
 void release_busdisplay(busdisplay_busdisplay_obj_t *self);
 void reset_busdisplay(busdisplay_busdisplay_obj_t *self);
 void busdisplay_busdisplay_collect_ptrs(busdisplay_busdisplay_obj_t *self);
+
+// Sends already converted pixels for `area`, given in native display coordinates.
+// The bus may still be reading `pixels` after this returns, until
+// busdisplay_busdisplay_wait_for_write() does.
+void busdisplay_busdisplay_write_area(busdisplay_busdisplay_obj_t *self, displayio_area_t *area, uint8_t *pixels, uint32_t length);
+void busdisplay_busdisplay_wait_for_write(busdisplay_busdisplay_obj_t *self);
@@ -56,10 +56,9 @@ void common_hal_displayio_bitmap_construct_from_buffer(displayio_bitmap_t *self,
     self->x_mask = (1u << self->x_shift) - 1u; // Used as a modulus on the x value
     self->bitmask = (1u << bits_per_value) - 1u;
 
-    self->dirty_area.x1 = 0;
-    self->dirty_area.x2 = width;
-    self->dirty_area.y1 = 0;
-    self->dirty_area.y2 = height;
+    self->dirty_areas.count = 0;
+    displayio_area_t a = {0, 0, width, height, NULL};
+    displayio_dirty_areas_add(&self->dirty_areas, &a);
 }
 
 void common_hal_displayio_bitmap_deinit(displayio_bitmap_t *self) {
@@ -109,6 +108,147 @@ uint32_t common_hal_displayio_bitmap_get_pixel(displayio_bitmap_t *self, int16_t
     return 0;
 }
 
+void displayio_bitmap_read_row(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t *values, uint16_t count) {
+    // Values outside of the bitmap read as zero like common_hal_displayio_bitmap_get_pixel.
+    if (y < 0 || y >= self->height) {
+        memset(values, 0, count * sizeof(uint32_t));
+        return;
+    }
+    while (count > 0 && x < 0) {
+        *values++ = 0;
+        x++;
+        count--;
+    }
+    if (x + count > self->width) {
+        uint16_t outside = x >= self->width ? count : x + count - self->width;
+        memset(values + count - outside, 0, outside * sizeof(uint32_t));
+        count -= outside;
+    }
+
+    uint32_t *row = self->data + y * self->stride;
+    switch (self->bits_per_value) {
+        case 32:
+            memcpy(values, row + x, count * sizeof(uint32_t));
+            break;
+        case 16: {
+            const uint16_t *row16 = ((const uint16_t *)row) + x;
+            for (uint16_t i = 0; i < count; i++) {
+                values[i] = row16[i];
+            }
+            break;
+        }
+        case 8: {
+            const uint8_t *row8 = ((const uint8_t *)row) + x;
+            for (uint16_t i = 0; i < count; i++) {
+                values[i] = row8[i];
+            }
+            break;
+        }
+        default: {
+            // Values are packed most significant first within each byte.
+            const uint8_t *bytes = ((const uint8_t *)row) + (x >> self->x_shift);
+            uint8_t values_per_byte = 8 / self->bits_per_value;
+            uint8_t bit_position = (values_per_byte - (x & self->x_mask) - 1) * self->bits_per_value;
+            for (uint16_t i = 0; i < count; i++) {
+                values[i] = (*bytes >> bit_position) & self->bitmask;
+                if (bit_position == 0) {
+                    bit_position = 8 - self->bits_per_value;
+                    bytes++;
+                } else {
+                    bit_position -= self->bits_per_value;
+                }
+            }
+            break;
+        }
+    }
+}
+
+void displayio_bitmap_write_row(displayio_bitmap_t *self, int16_t x, int16_t y, const uint32_t *values, uint16_t count) {
+    uint32_t *row = self->data + y * self->stride;
+    switch (self->bits_per_value) {
+        case 32:
+            memcpy(row + x, values, count * sizeof(uint32_t));
+            break;
+        case 16: {
+            uint16_t *row16 = ((uint16_t *)row) + x;
+            for (uint16_t i = 0; i < count; i++) {
+                row16[i] = values[i];
+            }
+            break;
+        }
+        case 8: {
+            uint8_t *row8 = ((uint8_t *)row) + x;
+            for (uint16_t i = 0; i < count; i++) {
+                row8[i] = values[i];
+            }
+            break;
+        }
+        default: {
+            uint8_t *bytes = ((uint8_t *)row) + (x >> self->x_shift);
+            uint8_t values_per_byte = 8 / self->bits_per_value;
+            uint8_t bit_position = (values_per_byte - (x & self->x_mask) - 1) * self->bits_per_value;
+            for (uint16_t i = 0; i < count; i++) {
+                *bytes = (*bytes & ~(self->bitmask << bit_position)) | ((values[i] & self->bitmask) << bit_position);
+                if (bit_position == 0) {
+                    bit_position = 8 - self->bits_per_value;
+                    bytes++;
+                } else {
+                    bit_position -= self->bits_per_value;
+                }
+            }
+            break;
+        }
+    }
+}
+
+void displayio_bitmap_fill_row(displayio_bitmap_t *self, int16_t x, int16_t y, uint16_t count, uint32_t value) {
+    uint32_t *row = self->data + y * self->stride;
+    switch (self->bits_per_value) {
+        case 32:
+            for (uint16_t i = 0; i < count; i++) {
+                row[x + i] = value;
+            }
+            break;
+        case 16: {
+            // Rows are word aligned so at most one value comes before the first full word.
+            uint16_t *row16 = ((uint16_t *)row) + x;
+            if ((x & 1) != 0 && count > 0) {
+                *row16++ = value;
+                count--;
+            }
+            uint32_t *words = (uint32_t *)row16;
+            uint32_t pair = (value & 0xffff) * 0x10001;
+            for (; count >= 2; count -= 2) {
+                *words++ = pair;
+            }
+            if (count > 0) {
+                *((uint16_t *)words) = value;
+            }
+            break;
+        }
+        case 8:
+            memset(((uint8_t *)row) + x, value, count);
+            break;
+        default: {
+            // Finish the partial bytes at either end a value at a time and set whole bytes between.
+            uint8_t values_per_byte = 8 / self->bits_per_value;
+            while (count > 0 && (x & self->x_mask) != 0) {
+                displayio_bitmap_write_pixel(self, x++, y, value);
+                count--;
+            }
+            uint16_t byte_count = count / values_per_byte;
+            memset(((uint8_t *)row) + (x >> self->x_shift), (value & self->bitmask) * (0xff / self->bitmask), byte_count);
+            x += byte_count * values_per_byte;
+            count -= byte_count * values_per_byte;
+            while (count > 0) {
+                displayio_bitmap_write_pixel(self, x++, y, value);
+                count--;
+            }
+            break;
+        }
+    }
+}
+
 void displayio_bitmap_set_dirty_area(displayio_bitmap_t *self, const displayio_area_t *dirty_area) {
     if (self->read_only) {
         mp_raise_RuntimeError(MP_ERROR_TEXT("Read-only"));
@@ -116,9 +256,11 @@ void displayio_bitmap_set_dirty_area(displayio_bitmap_t *self, const displayio_a
 
     displayio_area_t area = *dirty_area;
     displayio_area_canon(&area);
-    displayio_area_union(&area, &self->dirty_area, &area);
     displayio_area_t bitmap_area = {0, 0, self->width, self->height, NULL};
-    displayio_area_compute_overlap(&area, &bitmap_area, &self->dirty_area);
+    displayio_area_t clipped;
+    if (displayio_area_compute_overlap(&area, &bitmap_area, &clipped)) {
+        displayio_dirty_areas_add(&self->dirty_areas, &clipped);
+    }
 }
 
 void displayio_bitmap_write_pixel(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t value) {
@@ -169,19 +311,17 @@ void common_hal_displayio_bitmap_set_pixel(displayio_bitmap_t *self, int16_t x,
 }
 
 displayio_area_t *displayio_bitmap_get_refresh_areas(displayio_bitmap_t *self, displayio_area_t *tail) {
-    if (self->dirty_area.x1 == self->dirty_area.x2 || self->read_only) {
+    if (self->read_only) {
         return tail;
     }
-    self->dirty_area.next = tail;
-    return &self->dirty_area;
+    return displayio_dirty_areas_get_refresh_areas(&self->dirty_areas, tail);
 }
 
 void displayio_bitmap_finish_refresh(displayio_bitmap_t *self) {
     if (self->read_only) {
         return;
     }
-    self->dirty_area.x1 = 0;
-    self->dirty_area.x2 = 0;
+    self->dirty_areas.count = 0;
 }
 
 void common_hal_displayio_bitmap_fill(displayio_bitmap_t *self, uint32_t value) {
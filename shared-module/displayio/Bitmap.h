@@ -21,7 +21,7 @@ typedef struct {
     uint8_t bits_per_value;
     uint8_t x_shift;
     size_t x_mask;
-    displayio_area_t dirty_area;
+    displayio_dirty_areas_t dirty_areas;
     uint16_t bitmask;
     bool read_only;
     bool data_alloc; // did bitmap allocate data or someone else
@@ -30,4 +30,12 @@ typedef struct {
 void displayio_bitmap_finish_refresh(displayio_bitmap_t *self);
 displayio_area_t *displayio_bitmap_get_refresh_areas(displayio_bitmap_t *self, displayio_area_t *tail);
 void displayio_bitmap_set_dirty_area(displayio_bitmap_t *self, const displayio_area_t *area);
+// Reads count consecutive values of row y starting at x. Faster than repeated get_pixel calls.
+void displayio_bitmap_read_row(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t *values, uint16_t count);
+// Writes count consecutive values into row y starting at x. The run must be within the bitmap and
+// the dirty area must be updated separately.
+void displayio_bitmap_write_row(displayio_bitmap_t *self, int16_t x, int16_t y, const uint32_t *values, uint16_t count);
+// Sets count consecutive pixels of row y starting at x to value, a word or byte at a time where
+// possible. Same requirements as displayio_bitmap_write_row.
+void displayio_bitmap_fill_row(displayio_bitmap_t *self, int16_t x, int16_t y, uint16_t count, uint32_t value);
 void displayio_bitmap_write_pixel(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t value);
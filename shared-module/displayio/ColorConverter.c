@@ -321,6 +321,11 @@ void displayio_convert_color(const _displayio_colorspace_t *colorspace, bool dit
     output_color->opaque = false;
 }
 
+bool displayio_convert_color_supported(const _displayio_colorspace_t *colorspace) {
+    return colorspace->depth == 16 || colorspace->tricolor || (colorspace->grayscale && colorspace->depth <= 8) ||
+           colorspace->depth == 32 || colorspace->depth == 24 || colorspace->depth == 8 || colorspace->depth == 4;
+}
+
 void displayio_colorconverter_convert(displayio_colorconverter_t *self, const _displayio_colorspace_t *colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color) {
     uint32_t pixel = input_pixel->pixel;
 
@@ -345,7 +350,35 @@ void displayio_colorconverter_convert(displayio_colorconverter_t *self, const _d
     }
 }
 
+uint32_t displayio_colorconverter_convert_colors(displayio_colorconverter_t *self, const _displayio_colorspace_t *colorspace, displayio_input_pixel_t *input_pixel, uint32_t *values, uint8_t count) {
+    uint32_t opaque = 0;
+    displayio_output_pixel_t output_color;
+    for (uint8_t i = 0; i < count; i++, input_pixel->tile_x++) {
+        uint32_t pixel = values[i];
+        if (pixel == self->transparent_color) {
+            continue;
+        }
+        // Runs of the same color are common so check the cache before converting.
+        if (!self->dither && self->cached_colorspace == colorspace && self->cached_input_pixel == pixel) {
+            values[i] = self->cached_output_color;
+            opaque |= 1u << i;
+            continue;
+        }
+        input_pixel->pixel = pixel;
+        output_color.pixel = 0;
+        output_color.opaque = true;
+        displayio_colorconverter_convert(self, colorspace, input_pixel, &output_color);
+        if (output_color.opaque) {
+            values[i] = output_color.pixel;
+            opaque |= 1u << i;
+        }
+    }
+    return opaque;
+}
 
+bool displayio_colorconverter_is_opaque(displayio_colorconverter_t *self) {
+    return self->transparent_color == NO_TRANSPARENT_COLOR;
+}
 
 // Currently no refresh logic is needed for a ColorConverter.
 bool displayio_colorconverter_needs_refresh(displayio_colorconverter_t *self) {
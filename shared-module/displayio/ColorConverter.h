@@ -25,15 +25,21 @@ typedef struct displayio_colorconverter {
     uint32_t cached_output_color;
 } displayio_colorconverter_t;
 
+// True when no input color is transparent.
+bool displayio_colorconverter_is_opaque(displayio_colorconverter_t *self);
 bool displayio_colorconverter_needs_refresh(displayio_colorconverter_t *self);
 void displayio_colorconverter_finish_refresh(displayio_colorconverter_t *self);
 void displayio_colorconverter_convert(displayio_colorconverter_t *self, const _displayio_colorspace_t *colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color);
+// Run version of convert. See displayio_palette_get_colors for the contract.
+uint32_t displayio_colorconverter_convert_colors(displayio_colorconverter_t *self, const _displayio_colorspace_t *colorspace, displayio_input_pixel_t *input_pixel, uint32_t *values, uint8_t count);
 
 uint32_t displayio_colorconverter_dither_noise_1(uint32_t n);
 uint32_t displayio_colorconverter_dither_noise_2(uint32_t x, uint32_t y);
 
 // Convert version that doesn't require a colorconverter object.
 void displayio_convert_color(const _displayio_colorspace_t *colorspace, bool dither, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color);
+// False when displayio_convert_color() reports every color as transparent in colorspace.
+bool displayio_convert_color_supported(const _displayio_colorspace_t *colorspace);
 
 uint16_t displayio_colorconverter_compute_rgb565(uint32_t color_rgb888);
 uint8_t displayio_colorconverter_compute_rgb332(uint32_t color_rgb888);
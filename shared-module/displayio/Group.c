@@ -364,12 +364,13 @@ void displayio_group_construct(displayio_group_t *self, mp_obj_list_t *members,
     self->scale = scale;
     self->in_group = false;
     self->readonly = false;
+    self->occluded = false;
 }
 
 bool displayio_group_fill_area(displayio_group_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
     // Track if any of the layers finishes filling in the given area. We can ignore any remaining
     // layers at that point.
-    if (self->hidden == false) {
+    if (self->hidden == false && self->occluded == false) {
         for (int32_t i = self->members->len - 1; i >= 0; i--) {
             mp_obj_t layer;
             #if CIRCUITPY_VECTORIO
@@ -403,8 +404,42 @@ bool displayio_group_fill_area(displayio_group_t *self, const _displayio_colorsp
     return false;
 }
 
+bool displayio_group_update_occlusion(displayio_group_t *self, displayio_occluders_t *occluders) {
+    if (self->hidden) {
+        return true;
+    }
+    bool occluded = true;
+    for (int32_t i = self->members->len - 1; i >= 0; i--) {
+        mp_obj_t layer;
+        #if CIRCUITPY_VECTORIO
+        const vectorio_draw_protocol_t *draw_protocol = mp_proto_get(MP_QSTR_protocol_draw, self->members->items[i]);
+        if (draw_protocol != NULL) {
+            layer = draw_protocol->draw_get_protocol_self(self->members->items[i]);
+            occluded = draw_protocol->draw_protocol_impl->draw_update_occlusion(layer, occluders) && occluded;
+            continue;
+        }
+        #endif
+        layer = mp_obj_cast_to_native_base(
+            self->members->items[i], &displayio_tilegrid_type);
+        if (layer != MP_OBJ_NULL) {
+            occluded = displayio_tilegrid_update_occlusion(layer, occluders) && occluded;
+            continue;
+        }
+        layer = mp_obj_cast_to_native_base(
+            self->members->items[i], &displayio_group_type);
+        if (layer != MP_OBJ_NULL) {
+            occluded = displayio_group_update_occlusion(layer, occluders) && occluded;
+            continue;
+        }
+    }
+    self->occluded = occluded;
+    return occluded;
+}
+
 void displayio_group_finish_refresh(displayio_group_t *self) {
     self->item_removed = false;
+    // Occlusion is only known during a refresh.
+    self->occluded = false;
     for (int32_t i = self->members->len - 1; i >= 0; i--) {
         mp_obj_t layer;
         #if CIRCUITPY_VECTORIO
@@ -27,7 +27,8 @@ typedef struct {
     bool hidden : 1;
     bool hidden_by_parent : 1;
     bool readonly : 1;
-    uint8_t padding : 3;
+    bool occluded : 1;
+    uint8_t padding : 2;
 } displayio_group_t;
 
 void displayio_group_construct(displayio_group_t *self, mp_obj_list_t *members, uint32_t scale, mp_int_t x, mp_int_t y);
@@ -35,5 +36,8 @@ void displayio_group_set_hidden_by_parent(displayio_group_t *self, bool hidden);
 bool displayio_group_get_previous_area(displayio_group_t *group, displayio_area_t *area);
 bool displayio_group_fill_area(displayio_group_t *group, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer);
 void displayio_group_update_transform(displayio_group_t *group, const displayio_buffer_transform_t *parent_transform);
+// Walks the layers from the top down marking the ones covered by opaque layers above them so they can
+// be skipped when filling. Returns true when none of the group will be drawn.
+bool displayio_group_update_occlusion(displayio_group_t *self, displayio_occluders_t *occluders);
 void displayio_group_finish_refresh(displayio_group_t *self);
 displayio_area_t *displayio_group_get_refresh_areas(displayio_group_t *self, displayio_area_t *tail);
@@ -12,6 +12,7 @@ void common_hal_displayio_palette_construct(displayio_palette_t *self, uint16_t
     self->color_count = color_count;
     self->colors = (_displayio_color_t *)m_malloc(color_count * sizeof(_displayio_color_t));
     self->dither = dither;
+    self->opaque_checked = false;
 }
 
 void common_hal_displayio_palette_set_dither(displayio_palette_t *self, bool dither) {
@@ -24,11 +25,13 @@ bool common_hal_displayio_palette_get_dither(displayio_palette_t *self) {
 
 void common_hal_displayio_palette_make_opaque(displayio_palette_t *self, uint32_t palette_index) {
     self->colors[palette_index].transparent = false;
+    self->opaque_checked = false;
     self->needs_refresh = true;
 }
 
 void common_hal_displayio_palette_make_transparent(displayio_palette_t *self, uint32_t palette_index) {
     self->colors[palette_index].transparent = true;
+    self->opaque_checked = false;
     self->needs_refresh = true;
 }
 
@@ -83,6 +86,49 @@ void displayio_palette_get_color(displayio_palette_t *self, const _displayio_col
     }
 }
 
+uint32_t displayio_palette_get_colors(displayio_palette_t *self, const _displayio_colorspace_t *colorspace, displayio_input_pixel_t *input_pixel, uint32_t *values, uint8_t count) {
+    uint32_t opaque = 0;
+    displayio_output_pixel_t output_color;
+    for (uint8_t i = 0; i < count; i++, input_pixel->tile_x++) {
+        uint32_t palette_index = values[i];
+        // Inline the cache check from displayio_palette_get_color since it is by far the common case.
+        if (!self->dither && palette_index < self->color_count) {
+            _displayio_color_t *color = &self->colors[palette_index];
+            if (!color->transparent &&
+                color->cached_colorspace == colorspace &&
+                color->cached_colorspace_grayscale_bit == colorspace->grayscale_bit &&
+                color->cached_colorspace_grayscale == colorspace->grayscale) {
+                values[i] = color->cached_color;
+                opaque |= 1u << i;
+                continue;
+            }
+        }
+        input_pixel->pixel = palette_index;
+        output_color.pixel = 0;
+        output_color.opaque = true;
+        displayio_palette_get_color(self, colorspace, input_pixel, &output_color);
+        if (output_color.opaque) {
+            values[i] = output_color.pixel;
+            opaque |= 1u << i;
+        }
+    }
+    return opaque;
+}
+
+bool displayio_palette_is_opaque(displayio_palette_t *self) {
+    if (!self->opaque_checked) {
+        self->all_opaque = true;
+        for (uint32_t i = 0; i < self->color_count; i++) {
+            if (self->colors[i].transparent) {
+                self->all_opaque = false;
+                break;
+            }
+        }
+        self->opaque_checked = true;
+    }
+    return self->all_opaque;
+}
+
 bool displayio_palette_needs_refresh(displayio_palette_t *self) {
     return self->needs_refresh;
 }
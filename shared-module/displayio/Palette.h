@@ -55,10 +55,16 @@ typedef struct displayio_palette {
     uint32_t color_count;
     bool needs_refresh;
     bool dither;
+    bool opaque_checked; // all_opaque is only valid when this is set.
+    bool all_opaque;
 } displayio_palette_t;
 
 
 void displayio_palette_get_color(displayio_palette_t *palette, const _displayio_colorspace_t *colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color);
-;
+// Converts up to 32 horizontally adjacent palette indices in place. input_pixel describes the first
+// one and its tile_x is advanced for each value. Bit i of the result is set when values[i] is opaque.
+uint32_t displayio_palette_get_colors(displayio_palette_t *palette, const _displayio_colorspace_t *colorspace, displayio_input_pixel_t *input_pixel, uint32_t *values, uint8_t count);
+// True when no color is transparent. The result is cached until transparency changes.
+bool displayio_palette_is_opaque(displayio_palette_t *palette);
 bool displayio_palette_needs_refresh(displayio_palette_t *self);
 void displayio_palette_finish_refresh(displayio_palette_t *self);
@@ -6,6 +6,8 @@
 
 #include "shared-bindings/displayio/TileGrid.h"
 
+#include <string.h>
+
 #include "py/runtime.h"
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/ColorConverter.h"
@@ -47,6 +49,8 @@ void common_hal_displayio_tilegrid_construct(displayio_tilegrid_t *self, mp_obj_
     self->pixel_shader = pixel_shader;
     self->in_group = false;
     self->hidden = false;
+    self->occluded = false;
+    self->dirty_areas.count = 0;
     self->hidden_by_parent = false;
     self->previous_area.x1 = 0xffff;
     self->previous_area.x2 = self->previous_area.x1;
@@ -254,29 +258,21 @@ void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t
         return;
     }
     tiles[y * self->width_in_tiles + x] = tile_index;
-    displayio_area_t temp_area;
-    displayio_area_t *tile_area;
-    if (!self->partial_change) {
-        tile_area = &self->dirty_area;
-    } else {
-        tile_area = &temp_area;
-    }
+    displayio_area_t tile_area;
     int16_t tx = (x - self->top_left_x) % self->width_in_tiles;
     if (tx < 0) {
         tx += self->width_in_tiles;
     }
-    tile_area->x1 = tx * self->tile_width;
-    tile_area->x2 = tile_area->x1 + self->tile_width;
+    tile_area.x1 = tx * self->tile_width;
+    tile_area.x2 = tile_area.x1 + self->tile_width;
     int16_t ty = (y - self->top_left_y) % self->height_in_tiles;
     if (ty < 0) {
         ty += self->height_in_tiles;
     }
-    tile_area->y1 = ty * self->tile_height;
-    tile_area->y2 = tile_area->y1 + self->tile_height;
+    tile_area.y1 = ty * self->tile_height;
+    tile_area.y2 = tile_area.y1 + self->tile_height;
 
-    if (self->partial_change) {
-        displayio_area_union(&self->dirty_area, &temp_area, &self->dirty_area);
-    }
+    displayio_dirty_areas_add(&self->dirty_areas, &tile_area);
 
     self->partial_change = true;
 }
@@ -361,6 +357,144 @@ void common_hal_displayio_tilegrid_set_top_left(displayio_tilegrid_t *self, uint
     self->full_change = true;
 }
 
+// Pixels are read from the bitmap and shaded in runs of up to this many values. It matches the
+// width of the opaque bitmask returned by the pixel shaders.
+#define TILEGRID_RUN_LENGTH (32)
+
+// Per-fill state shared by the run store kernels.
+typedef struct {
+    const _displayio_colorspace_t *colorspace;
+    const displayio_area_t *area;
+    uint32_t *mask;
+    uint32_t *set_count; // The number of mask bits set.
+    uint32_t *buffer;
+    int16_t x_stride;
+    uint16_t scale;
+    bool check_mask; // False when no pixel of the current row has been set yet.
+    bool mark_mask; // False when the mask is updated for the whole overlap at once.
+} displayio_tilegrid_target_t;
+
+// Stores count output pixels starting at buffer offset. Each value is used for scale pixels with the
+// first one already phase pixels in. Returns false if an unmasked pixel was transparent.
+typedef bool (*displayio_tilegrid_store_run_t)(const displayio_tilegrid_target_t *target, uint32_t offset,
+    uint16_t count, uint16_t phase, const uint32_t *values, uint32_t opaque);
+
+// Handles depths of whole bytes that fit in a buffer element. Kept inline so that the 16 and 8 bit
+// kernels below each get a copy with the store resolved.
+static inline bool _store_run_bytes(const displayio_tilegrid_target_t *target, uint32_t offset,
+    uint16_t count, uint16_t phase, const uint32_t *values, uint32_t opaque, uint8_t bytes_per_pixel) {
+    uint32_t *mask = target->mask;
+    bool covered = true;
+    uint32_t newly_set = 0;
+    uint8_t i = 0;
+    for (uint16_t n = 0; n < count; n++, offset += target->x_stride) {
+        uint32_t bit = 1u << (offset % 32);
+        // Skip pixels that have already been set.
+        if (!target->check_mask || (mask[offset / 32] & bit) == 0) {
+            if ((opaque & (1u << i)) != 0) {
+                if (target->mark_mask) {
+                    mask[offset / 32] |= bit;
+                    newly_set++;
+                }
+                if (bytes_per_pixel == 2) {
+                    ((uint16_t *)target->buffer)[offset] = values[i];
+                } else {
+                    ((uint8_t *)target->buffer)[offset] = values[i];
+                }
+            } else {
+                covered = false;
+            }
+        }
+        if (++phase == target->scale) {
+            phase = 0;
+            i++;
+        }
+    }
+    *target->set_count += newly_set;
+    return covered;
+}
+
+static bool _store_run_16(const displayio_tilegrid_target_t *target, uint32_t offset,
+    uint16_t count, uint16_t phase, const uint32_t *values, uint32_t opaque) {
+    return _store_run_bytes(target, offset, count, phase, values, opaque, 2);
+}
+
+static bool _store_run_8(const displayio_tilegrid_target_t *target, uint32_t offset,
+    uint16_t count, uint16_t phase, const uint32_t *values, uint32_t opaque) {
+    return _store_run_bytes(target, offset, count, phase, values, opaque, 1);
+}
+
+// Handles 32, 24 and sub-byte depths.
+static bool _store_run(const displayio_tilegrid_target_t *target, uint32_t offset,
+    uint16_t count, uint16_t phase, const uint32_t *values, uint32_t opaque) {
+    const _displayio_colorspace_t *colorspace = target->colorspace;
+    uint32_t *mask = target->mask;
+    bool covered = true;
+    uint32_t newly_set = 0;
+    uint8_t i = 0;
+    for (uint16_t n = 0; n < count; n++, offset += target->x_stride) {
+        uint32_t bit = 1u << (offset % 32);
+        if (!target->check_mask || (mask[offset / 32] & bit) == 0) {
+            if ((opaque & (1u << i)) == 0) {
+                covered = false;
+            } else {
+                if (target->mark_mask) {
+                    mask[offset / 32] |= bit;
+                    newly_set++;
+                }
+                uint32_t pixel = values[i];
+                if (colorspace->depth == 32) {
+                    *(((uint32_t *)target->buffer) + offset) = pixel;
+                } else if (colorspace->depth == 24) {
+                    memcpy(((uint8_t *)target->buffer) + offset * 3, &pixel, 3);
+                } else if (colorspace->depth < 8) {
+                    uint8_t pixels_per_byte = 8 / colorspace->depth;
+                    uint32_t pixel_offset = offset;
+
+                    // Reorder the offsets to pack multiple rows into a byte (meaning they share a column).
+                    if (!colorspace->pixels_in_byte_share_row) {
+                        uint16_t width = displayio_area_width(target->area);
+                        uint16_t row = offset / width;
+                        uint16_t col = offset % width;
+                        // Dividing by pixels_per_byte does truncated division even if we multiply it back out.
+                        pixel_offset = col * pixels_per_byte + (row / pixels_per_byte) * pixels_per_byte * width + row % pixels_per_byte;
+                    }
+                    uint8_t shift = (pixel_offset % pixels_per_byte) * colorspace->depth;
+                    if (colorspace->reverse_pixels_in_byte) {
+                        // Reverse the shift by subtracting it from the leftmost shift.
+                        shift = (pixels_per_byte - 1) * colorspace->depth - shift;
+                    }
+                    ((uint8_t *)target->buffer)[pixel_offset / pixels_per_byte] |= pixel << shift;
+                }
+            }
+        }
+        if (++phase == target->scale) {
+            phase = 0;
+            i++;
+        }
+    }
+    *target->set_count += newly_set;
+    return covered;
+}
+
+// When the pixel shader can't produce a transparent pixel, every pixel of our area ends up set by us
+// or a layer above. Palettes also need every bitmap value to be a valid index.
+static bool _is_opaque(displayio_tilegrid_t *self) {
+    if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
+        displayio_palette_t *palette = MP_OBJ_TO_PTR(self->pixel_shader);
+        if (!mp_obj_is_type(self->bitmap, &displayio_bitmap_type)) {
+            return false;
+        }
+        displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(self->bitmap);
+        return bitmap->bits_per_value < 16 &&
+               (1u << bitmap->bits_per_value) <= palette->color_count &&
+               displayio_palette_is_opaque(palette);
+    } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
+        return displayio_colorconverter_is_opaque(self->pixel_shader);
+    }
+    return true;
+}
+
 bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
     const _displayio_colorspace_t *colorspace, const displayio_area_t *area,
     uint32_t *mask, uint32_t *buffer) {
@@ -374,7 +508,7 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
     }
 
     bool hidden = self->hidden || self->hidden_by_parent;
-    if (hidden) {
+    if (hidden || self->occluded) {
         return false;
     }
 
@@ -409,11 +543,6 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
     // layers at that point.
     bool full_coverage = displayio_area_equal(area, &overlap);
 
-    // TODO(tannewt): Skip coverage tracking if all pixels outside the overlap have already been
-    // set and our palette is all opaque.
-
-    // TODO(tannewt): Check to see if the pixel_shader has any transparency. If it doesn't then we
-    // can either return full coverage or bulk update the mask.
     displayio_area_t transformed;
     displayio_area_transform_within(flip_x != (self->absolute_transform->dx < 0), flip_y != (self->absolute_transform->dy < 0), self->transpose_xy != self->absolute_transform->transpose_xy,
         &overlap,
@@ -448,92 +577,136 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
         y_shift = temp_shift;
     }
 
+    displayio_tilegrid_target_t target = {
+        .colorspace = colorspace,
+        .area = area,
+        .mask = mask,
+        .set_count = displayio_mask_set_count(mask, area),
+        .buffer = buffer,
+        .x_stride = x_stride,
+        .scale = self->absolute_transform->scale,
+        .check_mask = true,
+        .mark_mask = true,
+    };
+
+    // Pick the kernels once per fill instead of re-checking types for every pixel.
+    displayio_bitmap_t *bitmap = NULL;
+    bool ondisk_bitmap = mp_obj_is_type(self->bitmap, &displayio_ondiskbitmap_type);
+    if (mp_obj_is_type(self->bitmap, &displayio_bitmap_type)) {
+        bitmap = MP_OBJ_TO_PTR(self->bitmap);
+    }
+    displayio_palette_t *palette = NULL;
+    displayio_colorconverter_t *colorconverter = NULL;
+    if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
+        palette = MP_OBJ_TO_PTR(self->pixel_shader);
+    } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
+        colorconverter = MP_OBJ_TO_PTR(self->pixel_shader);
+    }
+
+    // Opaque layers skip the transparency tracking and update the mask for the whole overlap at once
+    // when we're done. Shaders report every pixel as transparent in colorspaces they can't convert to.
+    bool opaque = _is_opaque(self) && (self->pixel_shader == mp_const_none || displayio_convert_color_supported(colorspace));
+    target.mark_mask = !opaque;
+
+    displayio_tilegrid_store_run_t store_run = _store_run;
+    if (colorspace->depth == 16) {
+        store_run = _store_run_16;
+    } else if (colorspace->depth == 8) {
+        store_run = _store_run_8;
+    }
+
+    uint32_t values[TILEGRID_RUN_LENGTH];
     displayio_input_pixel_t input_pixel;
-    displayio_output_pixel_t output_pixel;
 
     for (input_pixel.y = start_y; input_pixel.y < end_y; ++input_pixel.y) {
-        int16_t row_start = start + (input_pixel.y - start_y + y_shift) * y_stride; // in pixels
-        int16_t local_y = input_pixel.y / self->absolute_transform->scale;
-        for (input_pixel.x = start_x; input_pixel.x < end_x; ++input_pixel.x) {
-            // Compute the destination pixel in the buffer and mask based on the transformations.
-            int16_t offset = row_start + (input_pixel.x - start_x + x_shift) * x_stride; // in pixels
-
-            // This is super useful for debugging out of range accesses. Uncomment to use.
-            // if (offset < 0 || offset >= (int32_t) displayio_area_size(area)) {
-            //     asm("bkpt");
-            // }
-
-            // Check the mask first to see if the pixel has already been set.
-            if ((mask[offset / 32] & (1 << (offset % 32))) != 0) {
-                continue;
-            }
-            int16_t local_x = input_pixel.x / self->absolute_transform->scale;
-            uint16_t tile_location = ((local_y / self->tile_height + self->top_left_y) % self->height_in_tiles) * self->width_in_tiles + (local_x / self->tile_width + self->top_left_x) % self->width_in_tiles;
-            input_pixel.tile = tiles[tile_location];
-            input_pixel.tile_x = (input_pixel.tile % self->bitmap_width_in_tiles) * self->tile_width + local_x % self->tile_width;
-            input_pixel.tile_y = (input_pixel.tile / self->bitmap_width_in_tiles) * self->tile_height + local_y % self->tile_height;
+        int32_t offset = start + (input_pixel.y - start_y + y_shift) * y_stride + x_shift * x_stride; // in pixels
+        uint16_t local_y = input_pixel.y / target.scale;
+        uint16_t tile_row = ((local_y / self->tile_height + self->top_left_y) % self->height_in_tiles) * self->width_in_tiles;
+        uint16_t y_in_tile = local_y % self->tile_height;
+
+        // Rows that map to contiguous pixels can skip the per-pixel mask test when no layer above
+        // has set any of them.
+        if (x_stride == 1 || x_stride == -1) {
+            uint32_t row_first = x_stride == 1 ? offset : offset - (end_x - start_x - 1);
+            target.check_mask = !displayio_mask_range_is_clear(mask, row_first, end_x - start_x);
+        }
 
-            output_pixel.pixel = 0;
-            input_pixel.pixel = 0;
+        input_pixel.x = start_x;
+        while (input_pixel.x < end_x) {
+            // Each run stays within one tile so the tile lookup happens once for all of its pixels.
+            uint16_t local_x = input_pixel.x / target.scale;
+            uint16_t phase = input_pixel.x % target.scale;
+            uint16_t x_in_tile = local_x % self->tile_width;
+            input_pixel.tile = tiles[tile_row + (local_x / self->tile_width + self->top_left_x) % self->width_in_tiles];
+            input_pixel.tile_x = (input_pixel.tile % self->bitmap_width_in_tiles) * self->tile_width + x_in_tile;
+            input_pixel.tile_y = (input_pixel.tile / self->bitmap_width_in_tiles) * self->tile_height + y_in_tile;
+
+            uint16_t value_count = MIN(self->tile_width - x_in_tile, TILEGRID_RUN_LENGTH);
+            uint16_t count = value_count * target.scale - phase;
+            if (count > end_x - input_pixel.x) {
+                count = end_x - input_pixel.x;
+                value_count = (phase + count + target.scale - 1) / target.scale;
+            }
 
             // We always want to read bitmap pixels by row first and then transpose into the destination
             // buffer because most bitmaps are row associated.
-            if (mp_obj_is_type(self->bitmap, &displayio_bitmap_type)) {
-                input_pixel.pixel = common_hal_displayio_bitmap_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
-            } else if (mp_obj_is_type(self->bitmap, &displayio_ondiskbitmap_type)) {
-                input_pixel.pixel = common_hal_displayio_ondiskbitmap_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
+            if (bitmap != NULL) {
+                displayio_bitmap_read_row(bitmap, input_pixel.tile_x, input_pixel.tile_y, values, value_count);
+            } else if (ondisk_bitmap) {
+                for (uint16_t i = 0; i < value_count; i++) {
+                    values[i] = common_hal_displayio_ondiskbitmap_get_pixel(self->bitmap, input_pixel.tile_x + i, input_pixel.tile_y);
+                }
+            } else {
+                memset(values, 0, value_count * sizeof(uint32_t));
             }
 
-            output_pixel.opaque = true;
-            if (self->pixel_shader == mp_const_none) {
-                output_pixel.pixel = input_pixel.pixel;
-            } else if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
-                displayio_palette_get_color(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
-            } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
-                displayio_colorconverter_convert(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
+            uint32_t value_opaque;
+            if (palette != NULL) {
+                value_opaque = displayio_palette_get_colors(palette, colorspace, &input_pixel, values, value_count);
+            } else if (colorconverter != NULL) {
+                value_opaque = displayio_colorconverter_convert_colors(colorconverter, colorspace, &input_pixel, values, value_count);
+            } else {
+                if (self->pixel_shader != mp_const_none) {
+                    memset(values, 0, value_count * sizeof(uint32_t));
+                }
+                value_opaque = 0xffffffff;
             }
-            if (!output_pixel.opaque) {
+
+            if (!store_run(&target, offset, count, phase, values, value_opaque)) {
                 // A pixel is transparent so we haven't fully covered the area ourselves.
                 full_coverage = false;
-            } else {
-                mask[offset / 32] |= 1 << (offset % 32);
-                if (colorspace->depth == 16) {
-                    *(((uint16_t *)buffer) + offset) = output_pixel.pixel;
-                } else if (colorspace->depth == 32) {
-                    *(((uint32_t *)buffer) + offset) = output_pixel.pixel;
-                } else if (colorspace->depth == 24) {
-                    memcpy(((uint8_t *)buffer) + offset * 3, &output_pixel.pixel, 3);
-                } else if (colorspace->depth == 8) {
-                    *(((uint8_t *)buffer) + offset) = output_pixel.pixel;
-                } else if (colorspace->depth < 8) {
-                    uint8_t pixels_per_byte = 8 / colorspace->depth;
-
-                    // Reorder the offsets to pack multiple rows into a byte (meaning they share a column).
-                    if (!colorspace->pixels_in_byte_share_row) {
-                        uint16_t width = displayio_area_width(area);
-                        uint16_t row = offset / width;
-                        uint16_t col = offset % width;
-                        // Dividing by pixels_per_byte does truncated division even if we multiply it back out.
-                        offset = col * pixels_per_byte + (row / pixels_per_byte) * pixels_per_byte * width + row % pixels_per_byte;
-                        // Also useful for validating that the bitpacking worked correctly.
-                        // if (offset > displayio_area_size(area)) {
-                        //     asm("bkpt");
-                        // }
-                    }
-                    uint8_t shift = (offset % pixels_per_byte) * colorspace->depth;
-                    if (colorspace->reverse_pixels_in_byte) {
-                        // Reverse the shift by subtracting it from the leftmost shift.
-                        shift = (pixels_per_byte - 1) * colorspace->depth - shift;
-                    }
-                    ((uint8_t *)buffer)[offset / pixels_per_byte] |= output_pixel.pixel << shift;
-                }
             }
+            offset += count * x_stride;
+            input_pixel.x += count;
         }
     }
-    return full_coverage;
+
+    if (opaque) {
+        displayio_area_mask_set(area, &overlap, mask);
+    }
+    // Other layers can be skipped once every pixel of the area has been set, even when we only
+    // covered part of it.
+    return full_coverage || *target.set_count == displayio_area_size(area);
+}
+
+bool displayio_tilegrid_update_occlusion(displayio_tilegrid_t *self, displayio_occluders_t *occluders) {
+    uint8_t *tiles = self->tiles;
+    if (self->inline_tiles) {
+        tiles = (uint8_t *)&self->tiles;
+    }
+    if (self->hidden || self->hidden_by_parent || tiles == NULL) {
+        return true;
+    }
+    self->occluded = displayio_occluders_cover(occluders, &self->current_area);
+    if (!self->occluded && _is_opaque(self)) {
+        displayio_occluders_add(occluders, &self->current_area);
+    }
+    return self->occluded;
 }
 
 void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self) {
+    // Occlusion is only known during a refresh.
+    self->occluded = false;
     bool first_draw = self->previous_area.x1 == self->previous_area.x2;
     bool hidden = self->hidden || self->hidden_by_parent;
     if (!first_draw && hidden) {
@@ -545,6 +718,7 @@ void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self) {
     self->moved = false;
     self->full_change = false;
     self->partial_change = false;
+    self->dirty_areas.count = 0;
     if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
         displayio_palette_finish_refresh(self->pixel_shader);
     } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
@@ -560,6 +734,50 @@ void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self) {
     // That way they won't change during a refresh and tear.
 }
 
+// Converts a dirty area relative to our pixels into absolute screen coordinates.
+static void _transform_dirty_area(displayio_tilegrid_t *self, displayio_area_t *dirty_area) {
+    int16_t x = self->x;
+    int16_t y = self->y;
+    if (self->absolute_transform->transpose_xy) {
+        int16_t temp = y;
+        y = x;
+        x = temp;
+    }
+    int16_t x1 = dirty_area->x1;
+    int16_t x2 = dirty_area->x2;
+    if (self->flip_x) {
+        x1 = self->pixel_width - x1;
+        x2 = self->pixel_width - x2;
+    }
+    int16_t y1 = dirty_area->y1;
+    int16_t y2 = dirty_area->y2;
+    if (self->flip_y) {
+        y1 = self->pixel_height - y1;
+        y2 = self->pixel_height - y2;
+    }
+    if (self->transpose_xy != self->absolute_transform->transpose_xy) {
+        int16_t temp1 = y1, temp2 = y2;
+        y1 = x1;
+        x1 = temp1;
+        y2 = x2;
+        x2 = temp2;
+    }
+    dirty_area->x1 = self->absolute_transform->x + self->absolute_transform->dx * (x + x1);
+    dirty_area->y1 = self->absolute_transform->y + self->absolute_transform->dy * (y + y1);
+    dirty_area->x2 = self->absolute_transform->x + self->absolute_transform->dx * (x + x2);
+    dirty_area->y2 = self->absolute_transform->y + self->absolute_transform->dy * (y + y2);
+    if (dirty_area->y2 < dirty_area->y1) {
+        int16_t temp = dirty_area->y2;
+        dirty_area->y2 = dirty_area->y1;
+        dirty_area->y1 = temp;
+    }
+    if (dirty_area->x2 < dirty_area->x1) {
+        int16_t temp = dirty_area->x2;
+        dirty_area->x2 = dirty_area->x1;
+        dirty_area->x1 = temp;
+    }
+}
+
 displayio_area_t *displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *self, displayio_area_t *tail) {
     bool first_draw = self->previous_area.x1 == self->previous_area.x2;
     bool hidden = self->hidden || self->hidden_by_parent;
@@ -573,10 +791,12 @@ displayio_area_t *displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *sel
             return tail;
         }
     } else if (self->moved && !first_draw) {
-        displayio_area_union(&self->previous_area, &self->current_area, &self->dirty_area);
-        if (displayio_area_size(&self->dirty_area) <= 2U * self->pixel_width * self->pixel_height) {
-            self->dirty_area.next = tail;
-            return &self->dirty_area;
+        displayio_area_t *dirty_area = &self->dirty_areas.areas[0];
+        displayio_area_union(&self->previous_area, &self->current_area, dirty_area);
+        if (displayio_area_size(dirty_area) <= 2U * self->pixel_width * self->pixel_height) {
+            self->dirty_areas.count = 1;
+            dirty_area->next = tail;
+            return dirty_area;
         }
         self->previous_area.next = tail;
         self->current_area.next = &self->previous_area;
@@ -588,9 +808,11 @@ displayio_area_t *displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *sel
         displayio_area_t *refresh_area = displayio_bitmap_get_refresh_areas(self->bitmap, tail);
         if (refresh_area != tail) {
             // Special case a TileGrid that shows a full bitmap and use its
-            // dirty area. Copy it to ours so we can transform it.
+            // dirty areas. Copy them to ours so we can transform them.
             if (self->tiles_in_bitmap == 1) {
-                displayio_area_copy(refresh_area, &self->dirty_area);
+                for (const displayio_area_t *a = refresh_area; a != tail; a = a->next) {
+                    displayio_dirty_areas_add(&self->dirty_areas, a);
+                }
                 self->partial_change = true;
             } else {
                 self->full_change = true;
@@ -609,49 +831,10 @@ displayio_area_t *displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *sel
     }
 
     if (self->partial_change) {
-        int16_t x = self->x;
-        int16_t y = self->y;
-        if (self->absolute_transform->transpose_xy) {
-            int16_t temp = y;
-            y = x;
-            x = temp;
+        for (uint8_t i = 0; i < self->dirty_areas.count; i++) {
+            _transform_dirty_area(self, &self->dirty_areas.areas[i]);
         }
-        int16_t x1 = self->dirty_area.x1;
-        int16_t x2 = self->dirty_area.x2;
-        if (self->flip_x) {
-            x1 = self->pixel_width - x1;
-            x2 = self->pixel_width - x2;
-        }
-        int16_t y1 = self->dirty_area.y1;
-        int16_t y2 = self->dirty_area.y2;
-        if (self->flip_y) {
-            y1 = self->pixel_height - y1;
-            y2 = self->pixel_height - y2;
-        }
-        if (self->transpose_xy != self->absolute_transform->transpose_xy) {
-            int16_t temp1 = y1, temp2 = y2;
-            y1 = x1;
-            x1 = temp1;
-            y2 = x2;
-            x2 = temp2;
-        }
-        self->dirty_area.x1 = self->absolute_transform->x + self->absolute_transform->dx * (x + x1);
-        self->dirty_area.y1 = self->absolute_transform->y + self->absolute_transform->dy * (y + y1);
-        self->dirty_area.x2 = self->absolute_transform->x + self->absolute_transform->dx * (x + x2);
-        self->dirty_area.y2 = self->absolute_transform->y + self->absolute_transform->dy * (y + y2);
-        if (self->dirty_area.y2 < self->dirty_area.y1) {
-            int16_t temp = self->dirty_area.y2;
-            self->dirty_area.y2 = self->dirty_area.y1;
-            self->dirty_area.y1 = temp;
-        }
-        if (self->dirty_area.x2 < self->dirty_area.x1) {
-            int16_t temp = self->dirty_area.x2;
-            self->dirty_area.x2 = self->dirty_area.x1;
-            self->dirty_area.x1 = temp;
-        }
-
-        self->dirty_area.next = tail;
-        return &self->dirty_area;
+        return displayio_dirty_areas_get_refresh_areas(&self->dirty_areas, tail);
     }
     return tail;
 }
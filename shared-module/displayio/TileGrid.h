@@ -32,7 +32,7 @@ typedef struct {
     uint16_t top_left_y;
     uint8_t *tiles;
     const displayio_buffer_transform_t *absolute_transform;
-    displayio_area_t dirty_area; // Stored as a relative area until the refresh area is fetched.
+    displayio_dirty_areas_t dirty_areas; // Stored as relative areas until the refresh areas are fetched.
     displayio_area_t previous_area; // Stored as an absolute area.
     displayio_area_t current_area; // Stored as an absolute area so it applies across frames.
     bool partial_change : 1;
@@ -46,7 +46,8 @@ typedef struct {
     bool hidden : 1;
     bool hidden_by_parent : 1;
     bool rendered_hidden : 1;
-    uint8_t padding : 6;
+    bool occluded : 1;
+    uint8_t padding : 5;
 } displayio_tilegrid_t;
 
 void displayio_tilegrid_set_hidden_by_parent(displayio_tilegrid_t *self, bool hidden);
@@ -64,6 +65,9 @@ void displayio_tilegrid_update_transform(displayio_tilegrid_t *group, const disp
 // Fills in area with the maximum bounds of all related pixels in the last rendered frame. Returns
 // false if the tilegrid wasn't rendered in the last frame.
 bool displayio_tilegrid_get_previous_area(displayio_tilegrid_t *self, displayio_area_t *area);
+// Marks the tilegrid occluded when it is within one of the occluders and adds it to them when it is
+// opaque. Returns true when it won't be drawn.
+bool displayio_tilegrid_update_occlusion(displayio_tilegrid_t *self, displayio_occluders_t *occluders);
 void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self);
 
 bool displayio_tilegrid_get_rendered_hidden(displayio_tilegrid_t *self);
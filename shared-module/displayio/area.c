@@ -139,3 +139,152 @@ void displayio_area_transform_within(bool mirror_x, bool mirror_y, bool transpos
         transformed->x1 = whole->x1 + (y1 - whole->y1);
     }
 }
+
+// Returns the bits of one mask word that fall within [start, end). start and end must be within
+// the same word or end on the next word boundary.
+static uint32_t _mask_word_bits(uint32_t start, uint32_t end) {
+    uint32_t count = end - start;
+    if (count == 32) {
+        return 0xffffffff;
+    }
+    return ((1u << count) - 1) << (start % 32);
+}
+
+uint32_t displayio_mask_set_range(uint32_t *mask, uint32_t start, uint32_t count) {
+    uint32_t end = start + count;
+    uint32_t newly_set = 0;
+    while (start < end) {
+        uint32_t word_end = MIN((start / 32 + 1) * 32, end);
+        uint32_t bits = _mask_word_bits(start, word_end);
+        newly_set += __builtin_popcount(bits & ~mask[start / 32]);
+        mask[start / 32] |= bits;
+        start = word_end;
+    }
+    return newly_set;
+}
+
+bool displayio_mask_range_is_clear(const uint32_t *mask, uint32_t start, uint32_t count) {
+    uint32_t end = start + count;
+    while (start < end) {
+        uint32_t word_end = MIN((start / 32 + 1) * 32, end);
+        if ((mask[start / 32] & _mask_word_bits(start, word_end)) != 0) {
+            return false;
+        }
+        start = word_end;
+    }
+    return true;
+}
+
+void displayio_area_mask_set(const displayio_area_t *area, const displayio_area_t *subarea, uint32_t *mask) {
+    uint16_t width = displayio_area_width(area);
+    uint16_t subarea_width = displayio_area_width(subarea);
+    uint32_t newly_set = 0;
+    for (int16_t y = subarea->y1; y < subarea->y2; y++) {
+        newly_set += displayio_mask_set_range(mask, (y - area->y1) * width + (subarea->x1 - area->x1), subarea_width);
+    }
+    *displayio_mask_set_count(mask, area) += newly_set;
+}
+
+bool displayio_occluders_cover(const displayio_occluders_t *self, const displayio_area_t *area) {
+    for (uint8_t i = 0; i < self->count; i++) {
+        const displayio_area_t *occluder = &self->areas[i];
+        if (occluder->x1 <= area->x1 && area->x2 <= occluder->x2 &&
+            occluder->y1 <= area->y1 && area->y2 <= occluder->y2) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void displayio_occluders_add(displayio_occluders_t *self, const displayio_area_t *area) {
+    if (displayio_area_empty(area)) {
+        return;
+    }
+    uint8_t index = self->count;
+    if (index == DISPLAYIO_OCCLUDER_COUNT) {
+        // Full, so replace the smallest area if the new one is larger. Larger areas are more likely
+        // to hide something below them.
+        index = 0;
+        for (uint8_t i = 1; i < DISPLAYIO_OCCLUDER_COUNT; i++) {
+            if (displayio_area_size(&self->areas[i]) < displayio_area_size(&self->areas[index])) {
+                index = i;
+            }
+        }
+        if (displayio_area_size(area) <= displayio_area_size(&self->areas[index])) {
+            return;
+        }
+    } else {
+        self->count++;
+    }
+    displayio_area_copy(area, &self->areas[index]);
+}
+
+// Pixels redrawn by the union of a and b that neither of them needs.
+static int32_t _merge_waste(const displayio_area_t *a, const displayio_area_t *b) {
+    displayio_area_t u;
+    displayio_area_union(a, b, &u);
+    displayio_area_t overlap;
+    uint32_t overlap_size = 0;
+    if (displayio_area_compute_overlap(a, b, &overlap)) {
+        overlap_size = displayio_area_size(&overlap);
+    }
+    return (int32_t)displayio_area_size(&u) - displayio_area_size(a) - displayio_area_size(b) + overlap_size;
+}
+
+void displayio_dirty_areas_add(displayio_dirty_areas_t *self, const displayio_area_t *area) {
+    if (displayio_area_empty(area)) {
+        return;
+    }
+    displayio_area_t pending;
+    displayio_area_copy(area, &pending);
+    // Merge into any area when the pixels wasted are fewer than the smaller of the two has. The
+    // union may now be worth merging with others so start over after each merge.
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (uint8_t i = 0; i < self->count; i++) {
+            uint32_t smaller = MIN(displayio_area_size(&self->areas[i]), displayio_area_size(&pending));
+            if (_merge_waste(&self->areas[i], &pending) <= (int32_t)smaller) {
+                displayio_area_union(&self->areas[i], &pending, &pending);
+                self->count--;
+                displayio_area_copy(&self->areas[self->count], &self->areas[i]);
+                merged = true;
+                break;
+            }
+        }
+    }
+    if (self->count < DISPLAYIO_DIRTY_AREA_COUNT) {
+        displayio_area_copy(&pending, &self->areas[self->count]);
+        self->count++;
+        return;
+    }
+    // Out of space so merge the pair that wastes the fewest pixels. Index count is the pending area.
+    uint8_t best_i = 0;
+    uint8_t best_j = 1;
+    int32_t best_waste = INT32_MAX;
+    for (uint8_t i = 0; i < self->count; i++) {
+        for (uint8_t j = i + 1; j <= self->count; j++) {
+            const displayio_area_t *b = j == self->count ? &pending : &self->areas[j];
+            int32_t waste = _merge_waste(&self->areas[i], b);
+            if (waste < best_waste) {
+                best_waste = waste;
+                best_i = i;
+                best_j = j;
+            }
+        }
+    }
+    if (best_j == self->count) {
+        displayio_area_union(&self->areas[best_i], &pending, &self->areas[best_i]);
+    } else {
+        displayio_area_union(&self->areas[best_i], &self->areas[best_j], &self->areas[best_i]);
+        displayio_area_copy(&pending, &self->areas[best_j]);
+    }
+}
+
+displayio_area_t *displayio_dirty_areas_get_refresh_areas(displayio_dirty_areas_t *self, displayio_area_t *tail) {
+    for (uint8_t i = 0; i < self->count; i++) {
+        self->areas[i].next = tail;
+        tail = &self->areas[i];
+    }
+    return tail;
+}
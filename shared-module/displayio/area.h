@@ -55,3 +55,44 @@ void displayio_area_transform_within(bool mirror_x, bool mirror_y, bool transpos
     const displayio_area_t *original,
     const displayio_area_t *whole,
     displayio_area_t *transformed);
+
+// Masks track which pixels of an area's buffer have been set, one bit per pixel in row order.
+// A fill mask has a bit per pixel of the area, set once a layer has drawn the pixel, followed by a
+// count of the bits set. Layers that count the bits they set let others know the whole area has been
+// drawn without scanning the mask. Masks must be zeroed before a fill.
+#define DISPLAYIO_MASK_LENGTH(pixels) ((pixels) / 32 + 2)
+
+static inline uint32_t *displayio_mask_set_count(uint32_t *mask, const displayio_area_t *area) {
+    return &mask[displayio_area_size(area) / 32 + 1];
+}
+
+// Returns how many of the bits weren't set already.
+uint32_t displayio_mask_set_range(uint32_t *mask, uint32_t start, uint32_t count);
+bool displayio_mask_range_is_clear(const uint32_t *mask, uint32_t start, uint32_t count);
+// Sets the mask bits of subarea, which must be within area, and adds the newly set ones to the count.
+void displayio_area_mask_set(const displayio_area_t *area, const displayio_area_t *subarea, uint32_t *mask);
+
+// Opaque areas found while walking the layers from the top down at the start of a refresh. Any
+// layer completely within one of them can't be seen and is skipped while filling areas.
+#define DISPLAYIO_OCCLUDER_COUNT (8)
+
+typedef struct {
+    displayio_area_t areas[DISPLAYIO_OCCLUDER_COUNT];
+    uint8_t count;
+} displayio_occluders_t;
+
+bool displayio_occluders_cover(const displayio_occluders_t *self, const displayio_area_t *area);
+void displayio_occluders_add(displayio_occluders_t *self, const displayio_area_t *area);
+
+// A few separate areas that changed since the last refresh. Adding an area merges it with others
+// when redrawing the union costs little, so far apart changes don't redraw everything between them.
+#define DISPLAYIO_DIRTY_AREA_COUNT (4)
+
+typedef struct {
+    displayio_area_t areas[DISPLAYIO_DIRTY_AREA_COUNT];
+    uint8_t count;
+} displayio_dirty_areas_t;
+
+void displayio_dirty_areas_add(displayio_dirty_areas_t *self, const displayio_area_t *area);
+// Links the dirty areas in front of tail and returns the new head.
+displayio_area_t *displayio_dirty_areas_get_refresh_areas(displayio_dirty_areas_t *self, displayio_area_t *tail);
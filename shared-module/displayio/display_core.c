@@ -146,6 +146,11 @@ bool displayio_display_core_start_refresh(displayio_display_core_t *self) {
     }
     self->refresh_in_progress = true;
     self->last_refresh = supervisor_ticks_ms64();
+    if (self->current_group != NULL) {
+        // Find the layers hidden behind opaque ones so filling areas can skip them.
+        displayio_occluders_t occluders = { .count = 0 };
+        displayio_group_update_occlusion(self->current_group, &occluders);
+    }
     return true;
 }
 
@@ -287,7 +287,7 @@ static bool epaperdisplay_epaperdisplay_refresh_area(epaperdisplay_epaperdisplay
     // Allocated and shared as a uint32_t array so the compiler knows the
     // alignment everywhere.
     uint32_t buffer[buffer_size];
-    volatile uint32_t mask_length = (pixels_per_buffer / 32) + 1;
+    volatile uint32_t mask_length = DISPLAYIO_MASK_LENGTH(pixels_per_buffer);
     uint32_t mask[mask_length];
 
     uint8_t passes = 1;
@@ -162,7 +162,7 @@ static bool _refresh_area(framebufferio_framebufferdisplay_obj_t *self, const di
     // Allocated and shared as a uint32_t array so the compiler knows the
     // alignment everywhere.
     uint32_t buffer[buffer_size];
-    uint32_t mask_length = (pixels_per_buffer / 32) + 1;
+    uint32_t mask_length = DISPLAYIO_MASK_LENGTH(pixels_per_buffer);
     uint32_t mask[mask_length];
     uint16_t remaining_rows = displayio_area_height(&clipped);
 
@@ -16,7 +16,23 @@
 #include "shared-bindings/displayio/ColorConverter.h"
 #include "shared-bindings/util.h"
 
-#define BLOCK_SIZE (126) // (2^7) - 2 // (DO NOT CHANGE!)
+// The palette has 128 entries, so pixels are 7-bit LZW symbols.
+#define MIN_CODE_SIZE (7)
+#define CLEAR_CODE (1 << MIN_CODE_SIZE)
+#define END_CODE (CLEAR_CODE + 1)
+#define FIRST_CODE (CLEAR_CODE + 2)
+#define MAX_CODE (4095)
+
+// Open addressed table from (prefix code, pixel) to the code for the string
+// made of both. It's a prime a little over MAX_CODE so that probes visit every
+// slot. Each slot holds the key above the code, or HASH_EMPTY.
+#define HASH_SIZE (5003)
+#define HASH_EMPTY (0xffffffff)
+
+// Output is gathered in whole data sub-blocks and written out when fewer than
+// this many bytes are free.
+#define BUFFER_SIZE (4096)
+#define SUB_BLOCK_SIZE (255)
 
 static void handle_error(gifio_gifwriter_t *self) {
     if (self->error != 0) {
@@ -36,9 +52,13 @@ static void flush_data(gifio_gifwriter_t *self) {
     }
 }
 
-// These "write" calls _MUST_ have enough buffer space available!  This is
-// ensured by allocating the proper buffer size in construct.
+// The buffer is written out first if the data doesn't fit, so these must not
+// be used while a data sub-block is open.
 static void write_data(gifio_gifwriter_t *self, const void *data, size_t size) {
+    assert(self->block_len == 0);
+    if (self->cur + size > self->size) {
+        flush_data(self);
+    }
     assert(self->cur + size <= self->size);
     memcpy(self->data + self->cur, data, size);
     self->cur += size;
@@ -48,15 +68,105 @@ static void write_byte(gifio_gifwriter_t *self, uint8_t value) {
     write_data(self, &value, sizeof(value));
 }
 
-static void write_long(gifio_gifwriter_t *self, uint32_t value) {
+static void write_word(gifio_gifwriter_t *self, uint16_t value) {
     write_data(self, &value, sizeof(value));
 }
 
-static void write_word(gifio_gifwriter_t *self, uint16_t value) {
-    write_data(self, &value, sizeof(value));
+// Appends a byte of image data, starting a new sub-block when needed.
+static void put_image_byte(gifio_gifwriter_t *self, uint8_t value) {
+    if (self->block_len == 0) {
+        if (self->cur + 1 + SUB_BLOCK_SIZE > self->size) {
+            flush_data(self);
+        }
+        self->block_start = self->cur++;
+    }
+    self->data[self->cur++] = value;
+    if (++self->block_len == SUB_BLOCK_SIZE) {
+        self->data[self->block_start] = SUB_BLOCK_SIZE;
+        self->block_len = 0;
+    }
+}
+
+static void put_code(gifio_gifwriter_t *self, int code) {
+    self->bits |= (uint32_t)code << self->bit_count;
+    self->bit_count += self->code_size;
+    while (self->bit_count >= 8) {
+        put_image_byte(self, self->bits & 0xff);
+        self->bits >>= 8;
+        self->bit_count -= 8;
+    }
+}
+
+static void reset_codes(gifio_gifwriter_t *self) {
+    memset(self->hash, 0xff, HASH_SIZE * sizeof(self->hash[0]));
+    self->next_code = FIRST_CODE;
+    self->code_size = MIN_CODE_SIZE + 1;
 }
 
-void shared_module_gifio_gifwriter_construct(gifio_gifwriter_t *self, mp_obj_t *file, int width, int height, displayio_colorspace_t colorspace, bool loop, bool dither, bool own_file) {
+// Emits `code` and widens later codes once the decoder will have assigned
+// every code of the current width.
+static void emit_code(gifio_gifwriter_t *self, int code) {
+    put_code(self, code);
+    if (self->next_code >= (1 << self->code_size) && self->code_size < 12) {
+        self->code_size++;
+    }
+}
+
+static void begin_image_data(gifio_gifwriter_t *self) {
+    write_byte(self, MIN_CODE_SIZE);
+    self->bits = 0;
+    self->bit_count = 0;
+    self->code_size = MIN_CODE_SIZE + 1;
+    put_code(self, CLEAR_CODE);
+    reset_codes(self);
+    self->prefix = -1;
+}
+
+// Adds the next pixel to the LZW string being built, emitting the longest
+// known string once it can't be extended any further.
+static inline void add_pixel(gifio_gifwriter_t *self, uint8_t pixel) {
+    if (self->prefix < 0) {
+        self->prefix = pixel;
+        return;
+    }
+    uint32_t key = ((uint32_t)self->prefix << MIN_CODE_SIZE) | pixel;
+    uint32_t *hash = self->hash;
+    int i = (pixel << 5) ^ self->prefix;
+    int step = i == 0 ? 1 : HASH_SIZE - i;
+    while (hash[i] != HASH_EMPTY) {
+        if ((hash[i] >> 12) == key) {
+            self->prefix = hash[i] & 0xfff;
+            return;
+        }
+        i -= step;
+        if (i < 0) {
+            i += HASH_SIZE;
+        }
+    }
+    emit_code(self, self->prefix);
+    self->prefix = pixel;
+    if (self->next_code >= MAX_CODE) {
+        emit_code(self, CLEAR_CODE);
+        reset_codes(self);
+    } else {
+        hash[i] = (key << 12) | self->next_code++;
+    }
+}
+
+static void end_image_data(gifio_gifwriter_t *self) {
+    emit_code(self, self->prefix);
+    emit_code(self, END_CODE);
+    if (self->bit_count > 0) {
+        put_image_byte(self, self->bits & 0xff);
+    }
+    if (self->block_len != 0) {
+        self->data[self->block_start] = self->block_len;
+        self->block_len = 0;
+    }
+    write_byte(self, 0); // block terminator
+}
+
+void shared_module_gifio_gifwriter_construct(gifio_gifwriter_t *self, mp_obj_t *file, int width, int height, displayio_colorspace_t colorspace, bool loop, bool dither, bool delta, bool own_file) {
     self->file = file;
     self->file_proto = mp_get_stream_raise(file, MP_STREAM_OP_WRITE | MP_STREAM_OP_IOCTL);
     if (self->file_proto->is_text) {
@@ -68,11 +178,15 @@ void shared_module_gifio_gifwriter_construct(gifio_gifwriter_t *self, mp_obj_t *
     self->dither = dither;
     self->own_file = own_file;
 
-    size_t nblocks = (width * height + 125) / 126;
-    self->size = nblocks * 128 + 4;
+    self->size = BUFFER_SIZE;
     self->data = m_malloc(self->size);
     self->cur = 0;
+    self->block_len = 0;
     self->error = 0;
+    self->hash = m_malloc(HASH_SIZE * sizeof(self->hash[0]));
+    // The previous frame, as palette indices, to compare the next one with.
+    self->previous = delta ? m_malloc(width * height) : NULL;
+    self->have_previous = false;
 
     write_data(self, "GIF89a", 6);
     write_word(self, width);
@@ -154,96 +268,110 @@ static const uint8_t g_bayer[4][4] = {
     {31, 14, 26, 10}
 };
 
-void shared_module_gifio_gifwriter_add_frame(gifio_gifwriter_t *self, const mp_buffer_info_t *bufinfo, int16_t delay) {
-    if (delay) {
-        write_data(self, (uint8_t []) {'!', 0xF9, 0x04, 0x04}, 4);
-        write_word(self, delay);
-        write_word(self, 0); // end
+// Converts the pixel at (x, y) to its palette index.
+static inline uint8_t pixel_index(gifio_gifwriter_t *self, const void *buf, int x, int y) {
+    int i = y * self->width + x;
+    if (self->colorspace == DISPLAYIO_COLORSPACE_L8) {
+        return ((const uint8_t *)buf)[i] >> 1;
     }
+    int pixel = ((const uint16_t *)buf)[i];
+    if (self->byteswap) {
+        pixel = __builtin_bswap16(pixel);
+    }
+    if (!self->dither) {
+        int red = (pixel >> (11 + (5 - 2))) & 0x3;
+        int green = (pixel >> (5 + (6 - 3))) & 0x7;
+        int blue = (pixel >> (0 + (5 - 2))) & 0x3;
+        return (red << 5) | (green << 2) | blue;
+    }
+    int red = (pixel >> 8) & 0xf8;
+    int green = (pixel >> 3) & 0xfc;
+    int blue = (pixel << 3) & 0xf8;
 
-    write_byte(self, 0x2C);
-    write_long(self, 0);
-    write_word(self, self->width);
-    write_word(self, self->height);
-    write_data(self, (uint8_t []) {0x00, 0x07}, 2); // 7-bits
-
-    int pixel_count = self->width * self->height;
-    int blocks = (pixel_count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    red = MAX(0, red - rb_bayer[x % 4][y % 4]);
+    green = MAX(0, green - g_bayer[x % 4][(y + 2) % 4]);
+    blue = MAX(0, blue - rb_bayer[(x + 2) % 4][y % 4]);
 
-    uint8_t *data = self->data + self->cur;
+    return ((red >> 1) & 0x60) | ((green >> 3) & 0x1c) | (blue >> 6);
+}
 
-    if (self->colorspace == DISPLAYIO_COLORSPACE_L8) {
-        mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(pixel_count - 1), false);
-
-        uint8_t *pixels = bufinfo->buf;
-        for (int i = 0; i < blocks; i++) {
-            assert(pixel_count >= 0);
-            int block_size = MIN(BLOCK_SIZE, pixel_count);
-            pixel_count -= block_size;
-            *data++ = 1 + block_size;
-            *data++ = 0x80;
-            for (int j = 0; j < block_size; j++) {
-                *data++ = (*pixels++) >> 1;
+// Finds the smallest rectangle holding every pixel that differs from the
+// previous frame and stores the new frame. Returns false if nothing changed.
+static bool changed_area(gifio_gifwriter_t *self, const void *buf, int *left, int *top, int *right, int *bottom) {
+    int x0 = self->width, y0 = self->height, x1 = -1, y1 = -1;
+    uint8_t *previous = self->previous;
+    for (int y = 0; y < self->height; y++) {
+        for (int x = 0; x < self->width; x++) {
+            uint8_t index = pixel_index(self, buf, x, y);
+            if (*previous != index) {
+                *previous = index;
+                x0 = MIN(x0, x);
+                x1 = MAX(x1, x);
+                y0 = MIN(y0, y);
+                y1 = y;
             }
+            previous++;
         }
-    } else if (!self->dither) {
-        mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(2 * pixel_count - 1), false);
-
-        uint16_t *pixels = bufinfo->buf;
-        for (int i = 0; i < blocks; i++) {
-            int block_size = MIN(BLOCK_SIZE, pixel_count);
-            pixel_count -= block_size;
-
-            *data++ = 1 + block_size;
-            *data++ = 0x80;
-            for (int j = 0; j < block_size; j++) {
-                int pixel = *pixels++;
-                if (self->byteswap) {
-                    pixel = __builtin_bswap16(pixel);
+    }
+    *left = x0;
+    *top = y0;
+    *right = x1 + 1;
+    *bottom = y1 + 1;
+    return x1 >= 0;
+}
+
+void shared_module_gifio_gifwriter_add_frame(gifio_gifwriter_t *self, const mp_buffer_info_t *bufinfo, int16_t delay) {
+    int pixel_count = self->width * self->height;
+    int bytes_per_pixel = self->colorspace == DISPLAYIO_COLORSPACE_L8 ? 1 : 2;
+    mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(bytes_per_pixel * pixel_count - 1), false);
+
+    // With delta frames only the area that changed is stored. The previous
+    // frame is left in place underneath it.
+    int left = 0, top = 0, right = self->width, bottom = self->height;
+    if (self->previous) {
+        if (!self->have_previous) {
+            for (int y = 0; y < self->height; y++) {
+                for (int x = 0; x < self->width; x++) {
+                    self->previous[y * self->width + x] = pixel_index(self, bufinfo->buf, x, y);
                 }
-                int red = (pixel >> (11 + (5 - 2))) & 0x3;
-                int green = (pixel >> (5 + (6 - 3))) & 0x7;
-                int blue = (pixel >> (0 + (5 - 2))) & 0x3;
-                *data++ = (red << 5) | (green << 2) | blue;
             }
+            self->have_previous = true;
+        } else if (!changed_area(self, bufinfo->buf, &left, &top, &right, &bottom)) {
+            // A frame still has to be written for its delay, so repeat a
+            // single pixel.
+            left = top = 0;
+            right = bottom = 1;
         }
-    } else {
-        mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(2 * pixel_count - 1), false);
-
-        uint16_t *pixels = bufinfo->buf;
-        int x = 0, y = 0;
-        for (int i = 0; i < blocks; i++) {
-            int block_size = MIN(BLOCK_SIZE, pixel_count);
-            pixel_count -= block_size;
-
-            *data++ = 1 + block_size;
-            *data++ = 0x80;
-            for (int j = 0; j < block_size; j++) {
-                int pixel = *pixels++;
-                if (self->byteswap) {
-                    pixel = __builtin_bswap16(pixel);
-                }
-                int red = (pixel >> 8) & 0xf8;
-                int green = (pixel >> 3) & 0xfc;
-                int blue = (pixel << 3) & 0xf8;
-
-                red = MAX(0, red - rb_bayer[x % 4][y % 4]);
-                green = MAX(0, green - g_bayer[x % 4][(y + 2) % 4]);
-                blue = MAX(0, blue - rb_bayer[(x + 2) % 4][y % 4]);
-                x++;
-                if (x == self->width) {
-                    x = 0;
-                    y++;
-                }
+    }
 
-                *data++ = ((red >> 1) & 0x60) | ((green >> 3) & 0x1c) | (blue >> 6);
+    if (delay) {
+        write_data(self, (uint8_t []) {'!', 0xF9, 0x04, 0x04}, 4);
+        write_word(self, delay);
+        write_word(self, 0); // end
+    }
+
+    write_byte(self, 0x2C);
+    write_word(self, left);
+    write_word(self, top);
+    write_word(self, right - left);
+    write_word(self, bottom - top);
+    write_byte(self, 0x00); // no local color table, not interlaced
+
+    begin_image_data(self);
+    for (int y = top; y < bottom; y++) {
+        if (self->previous) {
+            const uint8_t *row = self->previous + y * self->width;
+            for (int x = left; x < right; x++) {
+                add_pixel(self, row[x]);
+            }
+        } else {
+            for (int x = left; x < right; x++) {
+                add_pixel(self, pixel_index(self, bufinfo->buf, x, y));
             }
         }
     }
+    end_image_data(self);
 
-    self->cur = data - self->data;
-
-    write_data(self, (uint8_t []) {0x01, 0x81, 0x00}, 3); // end code
     flush_data(self);
     handle_error(self);
 }
@@ -19,6 +19,18 @@ typedef struct gifio_gifwriter {
     int error;
     uint8_t *data;
     size_t cur, size;
+    // LZW encoder state
+    uint32_t *hash;
+    uint32_t bits;
+    int bit_count;
+    int code_size;
+    int next_code;
+    int prefix;
+    size_t block_start;
+    int block_len;
+    // Palette indices of the last frame, when writing delta frames
+    uint8_t *previous;
+    bool have_previous;
     bool own_file;
     bool byteswap;
     bool dither;
@@ -8,8 +8,16 @@
 
 #include "shared-bindings/jpegio/JpegDecoder.h"
 #include "shared-bindings/bitmaptools/__init__.h"
+#include "shared-module/displayio/display_core.h"
 #include "shared-module/jpegio/JpegDecoder.h"
 
+#if CIRCUITPY_BUSDISPLAY
+#include "shared-bindings/busdisplay/BusDisplay.h"
+#endif
+#if CIRCUITPY_FRAMEBUFFERIO
+#include "shared-bindings/framebufferio/FramebufferDisplay.h"
+#endif
+
 typedef size_t (*input_func)(JDEC *jd, uint8_t *dest, size_t len);
 
 // Given a pointer `ptr` to the field `field_name` inside a structure of type `type`,
@@ -54,6 +62,9 @@ static void check_jresult(JRESULT j) {
 
 void common_hal_jpegio_jpegdecoder_construct(jpegio_jpegdecoder_obj_t *self) {
     self->data_obj = MP_OBJ_NULL;
+    self->target = MP_OBJ_NULL;
+    self->strip[0] = self->strip[1] = NULL;
+    self->dirty_rows = NULL;
 }
 
 void common_hal_jpegio_jpegdecoder_close(jpegio_jpegdecoder_obj_t *self) {
@@ -210,3 +221,208 @@ void common_hal_jpegio_jpegdecoder_decode_into(
         check_jresult(result);
     }
 }
+
+// Places the decoded rectangle at self->x, self->y and clips it to the part of
+// the target being drawn. Returns false if none of it is visible.
+static bool clip_to_target(jpegio_jpegdecoder_obj_t *self, const JRECT *rect, displayio_area_t *placed, displayio_area_t *visible) {
+    placed->x1 = rect->left + self->x;
+    placed->y1 = rect->top + self->y;
+    placed->x2 = rect->right + 1 + self->x;
+    placed->y2 = rect->bottom + 1 + self->y;
+    return displayio_area_compute_overlap(placed, &self->target_area, visible);
+}
+
+static void copy_pixels(jpegio_jpegdecoder_obj_t *self, uint16_t *dest, const uint16_t *src, size_t count) {
+    if (self->swap_bytes) {
+        for (size_t i = 0; i < count; i++) {
+            dest[i] = __builtin_bswap16(src[i]);
+        }
+    } else {
+        memcpy(dest, src, count * sizeof(uint16_t));
+    }
+}
+
+// Hands the strip that is being filled to the target and switches to the other
+// strip. A bus that sends in the background can still be using the first strip
+// while the next row of MCUs is decoded into the second.
+static void send_strip(jpegio_jpegdecoder_obj_t *self) {
+    if (!self->strip_pending) {
+        return;
+    }
+    self->strip_pending = false;
+    displayio_area_t *area = &self->strip_area;
+    uint16_t *pixels = self->strip[self->strip_index];
+    size_t count = displayio_area_size(area);
+    self->strip_index ^= 1;
+
+    #if CIRCUITPY_BUSDISPLAY
+    if (mp_obj_is_type(self->target, &busdisplay_busdisplay_type)) {
+        busdisplay_busdisplay_obj_t *display = MP_OBJ_TO_PTR(self->target);
+        busdisplay_busdisplay_write_area(display, area, (uint8_t *)pixels, count * sizeof(uint16_t));
+        return;
+    }
+    #endif
+
+    mp_obj_t args[] = {
+        MP_OBJ_NEW_SMALL_INT(area->x1),
+        MP_OBJ_NEW_SMALL_INT(area->y1),
+        MP_OBJ_NEW_SMALL_INT(displayio_area_width(area)),
+        MP_OBJ_NEW_SMALL_INT(displayio_area_height(area)),
+        mp_obj_new_memoryview('B', count * sizeof(uint16_t), pixels),
+    };
+    mp_call_function_n_kw(self->target, MP_ARRAY_SIZE(args), 0, args);
+}
+
+static int strip_output(JDEC *jd, void *data, JRECT *rect) {
+    jpegio_jpegdecoder_obj_t *self = CONTAINER_OF(jd, jpegio_jpegdecoder_obj_t, decoder);
+    displayio_area_t placed, visible;
+    if (!clip_to_target(self, rect, &placed, &visible)) {
+        // Nothing further down can be visible either once we're past the bottom.
+        return placed.y1 >= self->target_area.y2 ? DECODER_INTERRUPT : DECODER_CONTINUE;
+    }
+
+    // Every MCU in a row has the same top and bottom, so a new top starts a new strip.
+    if (!self->strip_pending || self->strip_area.y1 != visible.y1) {
+        send_strip(self);
+        self->strip_area.y1 = visible.y1;
+        self->strip_area.y2 = visible.y2;
+        self->strip_pending = true;
+    }
+
+    int src_width = placed.x2 - placed.x1;
+    int strip_width = displayio_area_width(&self->strip_area);
+    int width = displayio_area_width(&visible);
+    const uint16_t *src = (const uint16_t *)data + (visible.y1 - placed.y1) * src_width + (visible.x1 - placed.x1);
+    uint16_t *dest = self->strip[self->strip_index] + (visible.x1 - self->strip_area.x1);
+    for (int y = visible.y1; y < visible.y2; y++) {
+        copy_pixels(self, dest, src, width);
+        src += src_width;
+        dest += strip_width;
+    }
+    return DECODER_CONTINUE;
+}
+
+#if CIRCUITPY_FRAMEBUFFERIO
+// A framebuffer is already in RAM so MCUs are copied straight into it.
+static int framebuffer_output(JDEC *jd, void *data, JRECT *rect) {
+    jpegio_jpegdecoder_obj_t *self = CONTAINER_OF(jd, jpegio_jpegdecoder_obj_t, decoder);
+    displayio_area_t placed, visible;
+    if (!clip_to_target(self, rect, &placed, &visible)) {
+        return placed.y1 >= self->target_area.y2 ? DECODER_INTERRUPT : DECODER_CONTINUE;
+    }
+
+    framebufferio_framebufferdisplay_obj_t *display = MP_OBJ_TO_PTR(self->target);
+    uint8_t *buf = (uint8_t *)display->bufinfo.buf + display->first_pixel_offset;
+    int src_width = placed.x2 - placed.x1;
+    int width = displayio_area_width(&visible);
+    const uint16_t *src = (const uint16_t *)data + (visible.y1 - placed.y1) * src_width + (visible.x1 - placed.x1);
+    for (int y = visible.y1; y < visible.y2; y++) {
+        uint16_t *dest = (uint16_t *)(buf + y * display->row_stride) + visible.x1;
+        copy_pixels(self, dest, src, width);
+        self->dirty_rows[y / 8] |= (1 << (y & 7));
+        src += src_width;
+    }
+    return DECODER_CONTINUE;
+}
+#endif
+
+void common_hal_jpegio_jpegdecoder_decode_to(jpegio_jpegdecoder_obj_t *self, mp_obj_t target, int scale, int16_t x, int16_t y) {
+    if (self->data_obj == MP_OBJ_NULL) {
+        mp_raise_RuntimeError_varg(MP_ERROR_TEXT("%q() without %q()"), MP_QSTR_decode_to, MP_QSTR_open);
+    }
+
+    // Displays are drawn in their native orientation, whatever their rotation.
+    // A callback is treated like a display with no right or bottom edge.
+    displayio_display_core_t *core = NULL;
+    #if CIRCUITPY_BUSDISPLAY
+    if (mp_obj_is_type(target, &busdisplay_busdisplay_type)) {
+        core = &((busdisplay_busdisplay_obj_t *)MP_OBJ_TO_PTR(target))->core;
+    }
+    #endif
+    #if CIRCUITPY_FRAMEBUFFERIO
+    framebufferio_framebufferdisplay_obj_t *framebuffer_display = NULL;
+    if (mp_obj_is_type(target, &framebufferio_framebufferdisplay_type)) {
+        framebuffer_display = MP_OBJ_TO_PTR(target);
+        core = &framebuffer_display->core;
+    }
+    #endif
+    if (core == NULL && !mp_obj_is_callable(target)) {
+        mp_raise_TypeError_varg(MP_ERROR_TEXT("unsupported %q type"), MP_QSTR_target);
+    }
+
+    int scaled_width = (self->decoder.width + (1 << scale) - 1) >> scale;
+    int scaled_height = (self->decoder.height + (1 << scale) - 1) >> scale;
+    displayio_area_t image = {
+        .x1 = x,
+        .y1 = y,
+        .x2 = x + scaled_width,
+        .y2 = y + scaled_height,
+    };
+    displayio_area_t bounds = {
+        .x1 = 0,
+        .y1 = 0,
+        .x2 = INT16_MAX,
+        .y2 = INT16_MAX,
+    };
+    self->swap_bytes = false;
+    if (core != NULL) {
+        if (core->colorspace.depth != 16 || core->colorspace.grayscale) {
+            mp_raise_ValueError(MP_ERROR_TEXT("Display must have a 16 bit colorspace."));
+        }
+        bounds = core->area;
+        // The decoder produces RGB565 with the high byte first.
+        self->swap_bytes = !core->colorspace.reverse_bytes_in_word;
+    }
+    if (!displayio_area_compute_overlap(&image, &bounds, &self->target_area)) {
+        common_hal_jpegio_jpegdecoder_close(self);
+        return;
+    }
+
+    self->target = target;
+    self->x = x;
+    self->y = y;
+    JRESULT result;
+    #if CIRCUITPY_FRAMEBUFFERIO
+    if (framebuffer_display != NULL) {
+        framebuffer_display->framebuffer_protocol->get_bufinfo(framebuffer_display->framebuffer, &framebuffer_display->bufinfo);
+        if (!framebuffer_display->bufinfo.buf) {
+            common_hal_jpegio_jpegdecoder_close(self);
+            return;
+        }
+        uint8_t dirty_rows[(core->area.y2 + 7) / 8];
+        memset(dirty_rows, 0, sizeof(dirty_rows));
+        self->dirty_rows = dirty_rows;
+        result = jd_decomp(&self->decoder, framebuffer_output, scale);
+        self->dirty_rows = NULL;
+        framebuffer_display->framebuffer_protocol->swapbuffers(framebuffer_display->framebuffer, dirty_rows);
+    } else
+    #endif
+    {
+        // A strip holds one row of MCUs, clipped to the target.
+        self->strip_area.x1 = self->target_area.x1;
+        self->strip_area.x2 = self->target_area.x2;
+        self->strip_alloc = displayio_area_width(&self->target_area) * ((self->decoder.msy * 8) >> scale);
+        self->strip[0] = m_new(uint16_t, self->strip_alloc);
+        self->strip[1] = m_new(uint16_t, self->strip_alloc);
+        self->strip_index = 0;
+        self->strip_pending = false;
+        result = jd_decomp(&self->decoder, strip_output, scale);
+        if (result == JDR_OK || result == JDR_INTR) {
+            send_strip(self);
+        }
+        #if CIRCUITPY_BUSDISPLAY
+        // The last strip can still be on its way to the display.
+        if (mp_obj_is_type(target, &busdisplay_busdisplay_type)) {
+            busdisplay_busdisplay_wait_for_write(MP_OBJ_TO_PTR(target));
+        }
+        #endif
+        m_del(uint16_t, self->strip[0], self->strip_alloc);
+        m_del(uint16_t, self->strip[1], self->strip_alloc);
+        self->strip[0] = self->strip[1] = NULL;
+    }
+    self->target = MP_OBJ_NULL;
+    common_hal_jpegio_jpegdecoder_close(self);
+    if (result != JDR_INTR) {
+        check_jresult(result);
+    }
+}
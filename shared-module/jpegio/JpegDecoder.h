@@ -9,6 +9,7 @@
 #include "py/obj.h"
 #include "lib/tjpgd/src/tjpgd.h"
 #include "shared-module/displayio/Bitmap.h"
+#include "shared-module/displayio/area.h"
 
 #define TJPGD_WORKSPACE_SIZE 3500
 
@@ -19,9 +20,20 @@ typedef struct jpegio_jpegdecoder_obj {
     mp_obj_t data_obj;
     mp_buffer_info_t bufinfo;
     displayio_bitmap_t *dest;
-    uint16_t x, y;
+    int16_t x, y;
     bitmaptools_rect_t lim;
     uint32_t skip_source_index, skip_dest_index;
     bool skip_source_index_none, skip_dest_index_none;
     uint8_t scale;
+    // Used by decode_to. Decoded MCUs are gathered into one of two strips
+    // holding a row of MCUs each while the other strip is being sent.
+    mp_obj_t target;
+    uint16_t *strip[2];
+    size_t strip_alloc; // in pixels, per strip
+    displayio_area_t strip_area;
+    displayio_area_t target_area;
+    uint8_t *dirty_rows;
+    uint8_t strip_index;
+    bool strip_pending;
+    bool swap_bytes;
 } jpegio_jpegdecoder_obj_t;
@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include "py/binary.h"
 #include "shared-bindings/keypad/Event.h"
 #include "shared-bindings/keypad/EventQueue.h"
 #include "shared-bindings/supervisor/__init__.h"
@@ -13,26 +14,70 @@
 #define EVENT_PRESSED (1 << 15)
 #define EVENT_KEY_NUM_MASK ((1 << 15) - 1)
 
+// Each event is committed to the ring as a whole, so the reader never sees
+// half of one. The size is a power of two so that an event never straddles
+// the end of the ring.
+typedef struct {
+    uint16_t encoded;
+    mp_obj_t timestamp;
+} queued_event_t;
+
 void common_hal_keypad_eventqueue_construct(keypad_eventqueue_obj_t *self, size_t max_events) {
-    // Event queue is 16-bit values.
-    ringbuf_alloc(&self->encoded_events, max_events * (sizeof(uint16_t) + sizeof(mp_obj_t)));
+    MP_STATIC_ASSERT((sizeof(queued_event_t) & (sizeof(queued_event_t) - 1)) == 0);
+    uint32_t capacity = sizeof(queued_event_t);
+    while (capacity < max_events * sizeof(queued_event_t)) {
+        capacity <<= 1;
+    }
+    spsc_ring_init(&self->encoded_events, m_malloc(capacity), capacity);
+    self->max_events = max_events;
     self->overflowed = false;
     self->event_handler = NULL;
 }
 
+static const queued_event_t *peek_event(keypad_eventqueue_obj_t *self) {
+    const uint8_t *span;
+    if (spsc_ring_read_span(&self->encoded_events, &span) < sizeof(queued_event_t)) {
+        return NULL;
+    }
+    return (const queued_event_t *)span;
+}
+
 bool common_hal_keypad_eventqueue_get_into(keypad_eventqueue_obj_t *self, keypad_event_obj_t *event) {
-    int encoded_event = ringbuf_get16(&self->encoded_events);
-    if (encoded_event == -1) {
+    const queued_event_t *queued = peek_event(self);
+    if (queued == NULL) {
         return false;
     }
+    uint16_t encoded_event = queued->encoded;
+    mp_obj_t ticks = queued->timestamp;
+    spsc_ring_commit_read(&self->encoded_events, sizeof(queued_event_t));
 
-    mp_obj_t ticks;
-    ringbuf_get_n(&self->encoded_events, (uint8_t *)&ticks, sizeof(ticks));
     // "Construct" using the existing event.
     common_hal_keypad_event_construct(event, encoded_event & EVENT_KEY_NUM_MASK, encoded_event & EVENT_PRESSED, ticks);
     return true;
 }
 
+size_t common_hal_keypad_eventqueue_get_into_array(keypad_eventqueue_obj_t *self, mp_buffer_info_t *events, mp_buffer_info_t *timestamps) {
+    size_t max_count = events->len / mp_binary_get_size('@', events->typecode, NULL);
+    if (timestamps != NULL) {
+        max_count = MIN(max_count, timestamps->len / mp_binary_get_size('@', timestamps->typecode, NULL));
+    }
+
+    size_t count = 0;
+    while (count < max_count) {
+        const queued_event_t *queued = peek_event(self);
+        if (queued == NULL) {
+            break;
+        }
+        mp_binary_set_val_array_from_int(events->typecode, events->buf, count, queued->encoded);
+        if (timestamps != NULL) {
+            mp_binary_set_val_array_from_int(timestamps->typecode, timestamps->buf, count, mp_obj_get_int(queued->timestamp));
+        }
+        spsc_ring_commit_read(&self->encoded_events, sizeof(queued_event_t));
+        count++;
+    }
+    return count;
+}
+
 mp_obj_t common_hal_keypad_eventqueue_get(keypad_eventqueue_obj_t *self) {
     keypad_event_obj_t *event = mp_obj_malloc(keypad_event_obj_t, &keypad_event_type);
     bool result = common_hal_keypad_eventqueue_get_into(self, event);
@@ -58,12 +103,12 @@ void common_hal_keypad_eventqueue_set_overflowed(keypad_eventqueue_obj_t *self,
 }
 
 void common_hal_keypad_eventqueue_clear(keypad_eventqueue_obj_t *self) {
-    ringbuf_clear(&self->encoded_events);
+    spsc_ring_clear(&self->encoded_events);
     common_hal_keypad_eventqueue_set_overflowed(self, false);
 }
 
 size_t common_hal_keypad_eventqueue_get_length(keypad_eventqueue_obj_t *self) {
-    return ringbuf_num_filled(&self->encoded_events);
+    return spsc_ring_num_filled(&self->encoded_events) / sizeof(queued_event_t);
 }
 
 void common_hal_keypad_eventqueue_set_event_handler(keypad_eventqueue_obj_t *self, void (*event_handler)(keypad_eventqueue_obj_t *)) {
@@ -71,18 +116,21 @@ void common_hal_keypad_eventqueue_set_event_handler(keypad_eventqueue_obj_t *sel
 }
 
 bool keypad_eventqueue_record(keypad_eventqueue_obj_t *self, mp_uint_t key_number, bool pressed, mp_obj_t timestamp) {
-    if (ringbuf_num_empty(&self->encoded_events) == 0) {
+    uint8_t *span;
+    if (common_hal_keypad_eventqueue_get_length(self) >= self->max_events ||
+        spsc_ring_write_span(&self->encoded_events, &span) < sizeof(queued_event_t)) {
         // Queue is full. Set the overflow flag. The caller will decide what else to do.
         common_hal_keypad_eventqueue_set_overflowed(self, true);
         return false;
     }
 
-    uint16_t encoded_event = key_number & EVENT_KEY_NUM_MASK;
+    queued_event_t *queued = (queued_event_t *)span;
+    queued->encoded = key_number & EVENT_KEY_NUM_MASK;
     if (pressed) {
-        encoded_event |= EVENT_PRESSED;
+        queued->encoded |= EVENT_PRESSED;
     }
-    ringbuf_put16(&self->encoded_events, encoded_event);
-    ringbuf_put_n(&self->encoded_events, (uint8_t *)&timestamp, sizeof(mp_obj_t));
+    queued->timestamp = timestamp;
+    spsc_ring_commit_write(&self->encoded_events, sizeof(queued_event_t));
 
     if (self->event_handler) {
         self->event_handler(self);
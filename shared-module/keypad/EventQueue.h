@@ -7,13 +7,15 @@
 #pragma once
 
 #include "py/obj.h"
-#include "py/ringbuf.h"
+#include "supervisor/shared/spsc_ring.h"
 
 typedef struct _keypad_eventqueue_obj_t keypad_eventqueue_obj_t;
 
 struct _keypad_eventqueue_obj_t {
     mp_obj_base_t base;
-    ringbuf_t encoded_events;
+    // Filled by the scanner, possibly from an interrupt, and drained by the VM.
+    spsc_ring_t encoded_events;
+    size_t max_events;
     bool overflowed;
     void (*event_handler)(keypad_eventqueue_obj_t *);
 };
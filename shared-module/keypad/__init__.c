@@ -5,20 +5,58 @@
 // SPDX-License-Identifier: MIT
 
 #include <string.h>
+#include "py/mpstate.h"
 #include "shared-bindings/keypad/__init__.h"
 #include "shared-bindings/keypad/EventQueue.h"
-#include "shared-bindings/keypad/Keys.h"
-#include "shared-bindings/keypad/KeyMatrix.h"
-#include "shared-bindings/keypad/ShiftRegisterKeys.h"
 #include "shared-bindings/supervisor/__init__.h"
 #include "supervisor/port.h"
 #include "supervisor/shared/lock.h"
 #include "supervisor/shared/tick.h"
 
+// Scan times are kept in subticks (1/32768 s) so that intervals shorter than
+// a tick can be honored when a port scans from a timer interrupt.
+#define SUBTICKS_PER_TICK (32)
+
 supervisor_lock_t keypad_scanners_linked_list_lock;
+static uint32_t keypad_timer_interval_us;
 static void keypad_scan_now(keypad_scanner_obj_t *self, uint64_t now);
 static void keypad_scan_maybe(keypad_scanner_obj_t *self, uint64_t now);
 
+static uint64_t keypad_now(void) {
+    uint8_t subticks;
+    uint64_t ticks = port_get_raw_ticks(&subticks);
+    return ticks * SUBTICKS_PER_TICK + subticks;
+}
+
+// Ask the port for a scan timer if any scanner wants to be scanned more often
+// than once a tick. Call with the scanner list locked.
+static void keypad_update_timer(void) {
+    mp_uint_t shortest = SUBTICKS_PER_TICK;
+    keypad_scanner_obj_t *scanner = MP_STATE_VM(keypad_scanners_linked_list);
+    while (scanner) {
+        if (scanner->interval_subticks > 0 && scanner->interval_subticks < shortest) {
+            shortest = scanner->interval_subticks;
+        }
+        scanner = scanner->next;
+    }
+
+    uint32_t interval_us = 0;
+    if (shortest < SUBTICKS_PER_TICK) {
+        interval_us = shortest * 1000000 / (SUBTICKS_PER_TICK * 1024);
+    }
+    if (interval_us == keypad_timer_interval_us) {
+        return;
+    }
+    if (keypad_timer_interval_us != 0) {
+        port_keypad_timer_stop();
+    }
+    keypad_timer_interval_us = 0;
+    // Ports without a timer leave the scanning to the tick.
+    if (interval_us != 0 && port_keypad_timer_start(interval_us)) {
+        keypad_timer_interval_us = interval_us;
+    }
+}
+
 void keypad_tick(void) {
     // Fast path. Return immediately there are no scanners.
     if (!MP_STATE_VM(keypad_scanners_linked_list)) {
@@ -27,7 +65,7 @@ void keypad_tick(void) {
 
     // Skip scanning if someone else has the lock. Don't wait for the lock.
     if (supervisor_try_lock(&keypad_scanners_linked_list_lock)) {
-        uint64_t now = port_get_raw_ticks(NULL);
+        uint64_t now = keypad_now();
         mp_obj_t scanner = MP_STATE_VM(keypad_scanners_linked_list);
         while (scanner) {
             keypad_scan_maybe(scanner, now);
@@ -54,6 +92,7 @@ void keypad_register_scanner(keypad_scanner_obj_t *scanner) {
     supervisor_acquire_lock(&keypad_scanners_linked_list_lock);
     scanner->next = MP_STATE_VM(keypad_scanners_linked_list);
     MP_STATE_VM(keypad_scanners_linked_list) = scanner;
+    keypad_update_timer();
     supervisor_release_lock(&keypad_scanners_linked_list_lock);
 
     // One more request for ticks.
@@ -82,6 +121,7 @@ void keypad_deregister_scanner(keypad_scanner_obj_t *scanner) {
             current = current->next;
         }
     }
+    keypad_update_timer();
     supervisor_release_lock(&keypad_scanners_linked_list_lock);
 }
 
@@ -89,7 +129,7 @@ void keypad_construct_common(keypad_scanner_obj_t *self, mp_float_t interval, si
     size_t key_count = common_hal_keypad_generic_get_key_count(self);
     self->debounce_counter = (int8_t *)m_malloc(sizeof(int8_t) * key_count);
 
-    self->interval_ticks = (mp_uint_t)(interval * 1024);   // interval * 1000 * (1024/1000)
+    self->interval_subticks = (mp_uint_t)(interval * SUBTICKS_PER_TICK * 1024);
 
     keypad_eventqueue_obj_t *events = mp_obj_malloc(keypad_eventqueue_obj_t, &keypad_eventqueue_type);
     common_hal_keypad_eventqueue_construct(events, max_events);
@@ -101,19 +141,26 @@ void keypad_construct_common(keypad_scanner_obj_t *self, mp_float_t interval, si
 
     // Add self to the list of active keypad scanners.
     keypad_register_scanner(self);
-    keypad_scan_now(self, port_get_raw_ticks(NULL));
+    keypad_scan_now(self, keypad_now());
 }
 
 static void keypad_scan_now(keypad_scanner_obj_t *self, uint64_t now) {
-    self->next_scan_ticks = now + self->interval_ticks;
+    self->next_scan_subticks = now + self->interval_subticks;
     self->funcs->scan_now(self, supervisor_ticks_ms());
 }
 
 static void keypad_scan_maybe(keypad_scanner_obj_t *self, uint64_t now) {
-    if (now < self->next_scan_ticks) {
+    // Allow for the scan timer firing a subtick early.
+    if (now + 1 < self->next_scan_subticks) {
         return;
     }
-    keypad_scan_now(self, now);
+    // Keep to the original schedule so that short intervals don't drift,
+    // unless a whole interval has been missed.
+    self->next_scan_subticks += self->interval_subticks;
+    if (self->next_scan_subticks <= now) {
+        self->next_scan_subticks = now + self->interval_subticks;
+    }
+    self->funcs->scan_now(self, supervisor_ticks_ms());
 }
 
 bool keypad_debounce(keypad_scanner_obj_t *self, mp_uint_t key_number, bool current) {
@@ -141,7 +188,7 @@ void common_hal_keypad_generic_reset(void *self_in) {
     keypad_scanner_obj_t *self = self_in;
     size_t key_count = common_hal_keypad_generic_get_key_count(self);
     memset(self->debounce_counter, -self->debounce_threshold, key_count);
-    keypad_scan_now(self, port_get_raw_ticks(NULL));
+    keypad_scan_now(self, keypad_now());
 }
 
 void common_hal_keypad_deinit_core(void *self_in) {
@@ -21,10 +21,10 @@ typedef struct _keypad_scanner_funcs_t {
     mp_obj_base_t base; \
     struct _keypad_scanner_obj_t *next; \
     keypad_scanner_funcs_t *funcs; \
-    uint64_t next_scan_ticks; \
+    uint64_t next_scan_subticks; \
     int8_t *debounce_counter; \
     struct _keypad_eventqueue_obj_t *events; \
-    mp_uint_t interval_ticks; \
+    mp_uint_t interval_subticks; \
     uint8_t debounce_threshold; \
     bool never_reset
 
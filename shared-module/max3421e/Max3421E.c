@@ -24,7 +24,7 @@ max3421e_max3421e_obj_t *_active;
 
 // Use CP's background callbacks to run the "interrupt" handler. The GPIO ISR
 // stack is too small to do the SPI transactions that the interrupt handler does.
-static background_callback_t tuh_callback;
+static background_callback_t tuh_callback = { .priority = BACKGROUND_CALLBACK_PRIORITY_USB };
 
 void common_hal_max3421e_max3421e_construct(max3421e_max3421e_obj_t *self,
     busio_spi_obj_t *spi, const mcu_pin_obj_t *chip_select,
@@ -0,0 +1,125 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/mperrno.h"
+#include "py/runtime.h"
+#include "py/stream.h"
+
+#include "shared-bindings/msgpack/Unpacker.h"
+#include "shared-module/msgpack/__init__.h"
+
+void common_hal_msgpack_unpacker_construct(msgpack_unpacker_obj_t *self, mp_obj_t stream, mp_obj_t ext_hook, bool use_list, size_t buffer_size) {
+    if (stream != mp_const_none) {
+        mp_get_stream_raise(stream, MP_STREAM_OP_READ);
+    }
+    self->stream = stream;
+    self->ext_hook = ext_hook;
+    self->use_list = use_list;
+    self->alloc = MAX(buffer_size, 16);
+    self->buf = m_new(uint8_t, self->alloc);
+    self->start = 0;
+    self->end = 0;
+}
+
+// Makes room for at least `len` more bytes after the unpacked data, moving
+// it to the start of the buffer and then growing the buffer if needed.
+static void make_room(msgpack_unpacker_obj_t *self, size_t len) {
+    if (self->alloc - self->end >= len) {
+        return;
+    }
+    size_t used = self->end - self->start;
+    memmove(self->buf, self->buf + self->start, used);
+    self->start = 0;
+    self->end = used;
+    if (self->alloc - used < len) {
+        size_t new_alloc = MAX(self->alloc * 2, used + len);
+        self->buf = m_renew(uint8_t, self->buf, self->alloc, new_alloc);
+        self->alloc = new_alloc;
+    }
+}
+
+void common_hal_msgpack_unpacker_feed(msgpack_unpacker_obj_t *self, const uint8_t *data, size_t len) {
+    make_room(self, len);
+    memcpy(self->buf + self->end, data, len);
+    self->end += len;
+}
+
+// Reads what the stream has into the free space. Returns false when the
+// stream had nothing more.
+static bool read_stream(msgpack_unpacker_obj_t *self) {
+    if (self->stream == mp_const_none) {
+        return false;
+    }
+    // Only grow the buffer when an object doesn't fit in it at all.
+    if (self->end == self->alloc) {
+        make_room(self, self->start > 0 ? self->start : self->alloc);
+    }
+    const mp_stream_p_t *stream_p = mp_get_stream(self->stream);
+    int errcode = 0;
+    mp_uint_t ret = stream_p->read(self->stream, self->buf + self->end, self->alloc - self->end, &errcode);
+    if (ret == MP_STREAM_ERROR) {
+        if (mp_is_nonblocking_error(errcode)) {
+            return false;
+        }
+        mp_raise_OSError(errcode);
+    }
+    self->end += ret;
+    return ret > 0;
+}
+
+static void consume(msgpack_unpacker_obj_t *self, size_t size) {
+    self->start += size;
+    if (self->start == self->end) {
+        self->start = 0;
+        self->end = 0;
+    }
+}
+
+// Returns the size of the next object, reading more from the stream until it
+// is complete, or 0 when it isn't complete yet. Data that can't be unpacked is
+// dropped, so that it doesn't stop every later object from being unpacked.
+static size_t next_object_size(msgpack_unpacker_obj_t *self) {
+    while (true) {
+        bool valid;
+        size_t size = shared_module_msgpack_object_size(self->buf + self->start, self->end - self->start, &valid);
+        if (!valid) {
+            consume(self, size);
+            mp_raise_ValueError(MP_ERROR_TEXT("Invalid format"));
+        }
+        if (size > 0) {
+            return size;
+        }
+        if (!read_stream(self)) {
+            return 0;
+        }
+    }
+}
+
+bool common_hal_msgpack_unpacker_unpack(msgpack_unpacker_obj_t *self, mp_obj_t *obj) {
+    size_t size = next_object_size(self);
+    if (size == 0) {
+        return false;
+    }
+    // Move past the object first so that bad data can't stop every later
+    // object from being unpacked.
+    const uint8_t *data = self->buf + self->start;
+    consume(self, size);
+    *obj = shared_module_msgpack_unpack_buffer(data, size, self->ext_hook, self->use_list);
+    return true;
+}
+
+bool common_hal_msgpack_unpacker_unpack_into(msgpack_unpacker_obj_t *self, mp_obj_t target, size_t *len) {
+    size_t size = next_object_size(self);
+    if (size == 0) {
+        return false;
+    }
+    // The object is kept if it doesn't fit, so it can be unpacked another way.
+    *len = shared_module_msgpack_unpack_buffer_into(self->buf + self->start, size, target);
+    consume(self, size);
+    return true;
+}
@@ -0,0 +1,21 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+typedef struct {
+    mp_obj_base_t base;
+    mp_obj_t stream;
+    mp_obj_t ext_hook;
+    // Data received but not unpacked yet is buf[start:end].
+    uint8_t *buf;
+    size_t alloc;
+    size_t start;
+    size_t end;
+    bool use_list;
+} msgpack_unpacker_obj_t;
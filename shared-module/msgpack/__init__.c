@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "py/obj.h"
 #include "py/binary.h"
@@ -28,21 +29,38 @@ typedef struct _msgpack_stream_t {
     mp_uint_t (*read)(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode);
     mp_uint_t (*write)(mp_obj_t obj, const void *buf, mp_uint_t size, int *errcode);
     int errcode;
+    // When set, data is read from this buffer instead of the stream.
+    const uint8_t *data;
+    size_t data_len;
 } msgpack_stream_t;
 
 static msgpack_stream_t get_stream(mp_obj_t stream_obj, int flags) {
     const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, flags);
-    msgpack_stream_t s = {stream_obj, stream_p->read, stream_p->write, 0};
+    msgpack_stream_t s = {stream_obj, stream_p->read, stream_p->write, 0, NULL, 0};
+    return s;
+}
+
+static msgpack_stream_t get_buffer_stream(const uint8_t *data, size_t len) {
+    msgpack_stream_t s = {MP_OBJ_NULL, NULL, NULL, 0, data, len};
     return s;
 }
 
 ////////////////////////////////////////////////////////////////
 // readers
 
-static void read(msgpack_stream_t *s, void *buf, mp_uint_t size) {
+static void read_bytes(msgpack_stream_t *s, void *buf, mp_uint_t size) {
     if (size == 0) {
         return;
     }
+    if (s->data != NULL) {
+        if (size > s->data_len) {
+            mp_raise_msg(&mp_type_EOFError, NULL);
+        }
+        memcpy(buf, s->data, size);
+        s->data += size;
+        s->data_len -= size;
+        return;
+    }
     mp_uint_t ret = s->read(s->stream_obj, buf, size, &s->errcode);
     if (s->errcode != 0) {
         mp_raise_OSError(s->errcode);
@@ -57,13 +75,13 @@ static void read(msgpack_stream_t *s, void *buf, mp_uint_t size) {
 
 static uint8_t read1(msgpack_stream_t *s) {
     uint8_t res = 0;
-    read(s, &res, 1);
+    read_bytes(s, &res, 1);
     return res;
 }
 
 static uint16_t read2(msgpack_stream_t *s) {
     uint16_t res = 0;
-    read(s, &res, 2);
+    read_bytes(s, &res, 2);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap16(res);
@@ -73,7 +91,7 @@ static uint16_t read2(msgpack_stream_t *s) {
 
 static uint32_t read4(msgpack_stream_t *s) {
     uint32_t res = 0;
-    read(s, &res, 4);
+    read_bytes(s, &res, 4);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap32(res);
@@ -83,7 +101,7 @@ static uint32_t read4(msgpack_stream_t *s) {
 
 static uint64_t read8(msgpack_stream_t *s) {
     uint64_t res = 0;
-    read(s, &res, 8);
+    read_bytes(s, &res, 8);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap64(res);
@@ -110,7 +128,7 @@ static size_t read_size(msgpack_stream_t *s, uint8_t len_index) {
 ////////////////////////////////////////////////////////////////
 // writers
 
-static void write(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
+static void write_bytes(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
     mp_uint_t ret = s->write(s->stream_obj, buf, size, &s->errcode);
     if (s->errcode != 0) {
         mp_raise_OSError(s->errcode);
@@ -121,7 +139,7 @@ static void write(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
 }
 
 static void write1(msgpack_stream_t *s, uint8_t obj) {
-    write(s, &obj, 1);
+    write_bytes(s, &obj, 1);
 }
 
 static void write2(msgpack_stream_t *s, uint16_t obj) {
@@ -129,7 +147,7 @@ static void write2(msgpack_stream_t *s, uint16_t obj) {
     if (*(char *)&n == 1) {
         obj = __builtin_bswap16(obj);
     }
-    write(s, &obj, 2);
+    write_bytes(s, &obj, 2);
 }
 
 static void write4(msgpack_stream_t *s, uint32_t obj) {
@@ -137,7 +155,7 @@ static void write4(msgpack_stream_t *s, uint32_t obj) {
     if (*(char *)&n == 1) {
         obj = __builtin_bswap32(obj);
     }
-    write(s, &obj, 4);
+    write_bytes(s, &obj, 4);
 }
 
 // compute and write msgpack size code (array structures)
@@ -192,7 +210,7 @@ static void pack_int(msgpack_stream_t *s, int32_t x) {
 static void pack_bin(msgpack_stream_t *s, const uint8_t *data, size_t len) {
     write_size(s, 0xc4, len);
     if (len > 0) {
-        write(s, data, len);
+        write_bytes(s, data, len);
     }
 }
 
@@ -212,7 +230,7 @@ static void pack_ext(msgpack_stream_t *s, int8_t code, const uint8_t *data, size
     }
     write1(s, code);    // type byte
     if (len > 0) {
-        write(s, data, len);
+        write_bytes(s, data, len);
     }
 }
 
@@ -223,7 +241,7 @@ static void pack_str(msgpack_stream_t *s, const char *str, size_t len) {
         write_size(s, 0xd9, len);
     }
     if (len > 0) {
-        write(s, str, len);
+        write_bytes(s, str, len);
     }
 }
 
@@ -293,11 +311,12 @@ static void pack(mp_obj_t obj, msgpack_stream_t *s, mp_obj_t default_handler) {
             pack(next->value, s, default_handler);
         }
     } else if (mp_obj_is_float(obj)) {
-        union Float { mp_float_t f;
+        // float 32 whatever the precision of mp_float_t
+        union Float { float f;
                       uint32_t u;
         };
         union Float data;
-        data.f = mp_obj_float_get(obj);
+        data.f = (float)mp_obj_float_get(obj);
         write1(s, 0xca);
         write4(s, data.u);
     } else if (obj == mp_const_none) {
@@ -342,19 +361,22 @@ static mp_obj_t unpack_array_elements(msgpack_stream_t *s, size_t size, mp_obj_t
     }
 }
 
-static mp_obj_t unpack_bytes(msgpack_stream_t *s, size_t size) {
-    vstr_t vstr;
-    vstr_init_len(&vstr, size);
-    byte *p = (byte *)vstr.buf;
+static void read_chunked(msgpack_stream_t *s, byte *p, size_t size) {
     // read in chunks: (some drivers - e.g. UART) limit the
     // maximum number of bytes that can be read at once
-    // read(s, p, size);
+    // read_bytes(s, p, size);
     while (size > 0) {
         int n = size > 256 ? 256 : size;
-        read(s, p, n);
+        read_bytes(s, p, n);
         size -= n;
         p += n;
     }
+}
+
+static mp_obj_t unpack_bytes(msgpack_stream_t *s, size_t size) {
+    vstr_t vstr;
+    vstr_init_len(&vstr, size);
+    read_chunked(s, (byte *)vstr.buf, size);
     return mp_obj_new_bytes_from_vstr(&vstr);
 }
 
@@ -382,7 +404,7 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
         size_t len = code & 0b11111;
         // allocate on stack; len < 32
         char str[len];
-        read(s, &str, len);
+        read_bytes(s, &str, len);
         return mp_obj_new_str(str, len);
     }
     if ((code & 0b11110000) == 0b10010000) {
@@ -394,7 +416,9 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
         size_t len = code & 0b1111;
         mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(len));
         for (size_t i = 0; i < len; i++) {
-            mp_obj_dict_store(d, unpack(s, ext_hook, use_list), unpack(s, ext_hook, use_list));
+            // The key comes first, so it can't be unpacked in the argument list.
+            mp_obj_t key = unpack(s, ext_hook, use_list);
+            mp_obj_dict_store(d, key, unpack(s, ext_hook, use_list));
         }
         return MP_OBJ_FROM_PTR(d);
     }
@@ -429,7 +453,7 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
             return mp_obj_new_int_from_ll((int64_t)read8(s));
         case 0xca: { // float
             union Float {
-                mp_float_t f;
+                float f;
                 uint32_t u;
             };
             union Float data;
@@ -453,7 +477,7 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
             vstr_t vstr;
             vstr_init_len(&vstr, size);
             byte *p = (byte *)vstr.buf;
-            read(s, p, size);
+            read_bytes(s, p, size);
             return mp_obj_new_str_from_vstr(&vstr);
         }
         case 0xde:
@@ -462,7 +486,9 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
             size_t len = read_size(s, code - 0xde + 1);
             mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(len));
             for (size_t i = 0; i < len; i++) {
-                mp_obj_dict_store(d, unpack(s, ext_hook, use_list), unpack(s, ext_hook, use_list));
+                // The key comes first, so it can't be unpacked in the argument list.
+                mp_obj_t key = unpack(s, ext_hook, use_list);
+                mp_obj_dict_store(d, key, unpack(s, ext_hook, use_list));
             }
             return MP_OBJ_FROM_PTR(d);
         }
@@ -493,6 +519,231 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
     }
 }
 
+////////////////////////////////////////////////////////////////
+// unpacking into existing buffers
+
+// Stores one array element without creating an object for it.
+static void unpack_number_into(msgpack_stream_t *s, char typecode, void *p, size_t index) {
+    uint8_t code = read1(s);
+    long long i = 0;
+    double f = 0;
+    bool is_float = false;
+    if (((code & 0b10000000) == 0) || ((code & 0b11100000) == 0b11100000)) {
+        i = (int8_t)code;
+    } else {
+        switch (code) {
+            case 0xc2: // false
+            case 0xc3: // true
+                i = code - 0xc2;
+                break;
+            case 0xcc:
+                i = (uint8_t)read1(s);
+                break;
+            case 0xd0:
+                i = (int8_t)read1(s);
+                break;
+            case 0xcd:
+                i = (uint16_t)read2(s);
+                break;
+            case 0xd1:
+                i = (int16_t)read2(s);
+                break;
+            case 0xce:
+                i = (uint32_t)read4(s);
+                break;
+            case 0xd2:
+                i = (int32_t)read4(s);
+                break;
+            case 0xcf:
+            case 0xd3:
+                i = (long long)read8(s);
+                break;
+            case 0xca: {
+                union {
+                    float f;
+                    uint32_t u;
+                } data;
+                data.u = read4(s);
+                f = data.f;
+                is_float = true;
+                break;
+            }
+            case 0xcb: {
+                union {
+                    double d;
+                    uint64_t u;
+                } data;
+                data.u = read8(s);
+                f = data.d;
+                is_float = true;
+                break;
+            }
+            default:
+                mp_raise_ValueError(MP_ERROR_TEXT("Invalid format"));
+        }
+    }
+
+    switch (typecode) {
+        #if MICROPY_PY_BUILTINS_FLOAT
+        case 'f':
+            ((float *)p)[index] = is_float ? (float)f : (float)i;
+            return;
+        case 'd':
+            ((double *)p)[index] = is_float ? f : (double)i;
+            return;
+        #endif
+        case 'q':
+        case 'Q':
+            if (!is_float) {
+                ((long long *)p)[index] = i;
+                return;
+            }
+            break;
+        default:
+            if (!is_float) {
+                mp_binary_set_val_array_from_int(typecode, p, index, i);
+                return;
+            }
+            break;
+    }
+    mp_raise_ValueError(MP_ERROR_TEXT("Invalid format"));
+}
+
+// Unpacks a str or bin into the bytes of `target`, or an array of numbers
+// into its elements. Returns the number of bytes or elements stored.
+static size_t unpack_into(msgpack_stream_t *s, mp_obj_t target) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(target, &bufinfo, MP_BUFFER_WRITE);
+
+    uint8_t code = read1(s);
+    size_t len;
+    if ((code & 0b11100000) == 0b10100000) {
+        len = code & 0b11111;
+    } else if (code >= 0xc4 && code <= 0xc6) {
+        len = read_size(s, code - 0xc4);
+    } else if (code >= 0xd9 && code <= 0xdb) {
+        len = read_size(s, code - 0xd9);
+    } else {
+        if ((code & 0b11110000) == 0b10010000) {
+            len = code & 0b1111;
+        } else if (code == 0xdc || code == 0xdd) {
+            len = read_size(s, code - 0xdc + 1);
+        } else {
+            mp_raise_ValueError(MP_ERROR_TEXT("Invalid format"));
+        }
+        size_t item_size = mp_binary_get_size('@', bufinfo.typecode, NULL);
+        if (item_size == 0) {
+            mp_raise_ValueError(MP_ERROR_TEXT("Invalid format"));
+        }
+        if (len > bufinfo.len / item_size) {
+            mp_raise_ValueError(MP_ERROR_TEXT("buffer too small"));
+        }
+        for (size_t i = 0; i < len; i++) {
+            unpack_number_into(s, bufinfo.typecode, bufinfo.buf, i);
+        }
+        return len;
+    }
+
+    if (len > bufinfo.len) {
+        mp_raise_ValueError(MP_ERROR_TEXT("buffer too small"));
+    }
+    read_chunked(s, bufinfo.buf, len);
+    return len;
+}
+
+////////////////////////////////////////////////////////////////
+// framing
+
+static size_t big_endian(const uint8_t *p, size_t len) {
+    size_t res = 0;
+    for (size_t i = 0; i < len; i++) {
+        res = (res << 8) | p[i];
+    }
+    return res;
+}
+
+size_t shared_module_msgpack_object_size(const uint8_t *data, size_t len, bool *valid) {
+    // Walks the headers without building anything, counting the objects that
+    // are still to come in the containers seen so far.
+    size_t pos = 0;
+    size_t remaining = 1;
+    *valid = true;
+    while (remaining > 0) {
+        if (pos >= len) {
+            return 0;
+        }
+        uint8_t code = data[pos];
+        // Header length, payload length and number of contained objects.
+        size_t header = 1;
+        size_t payload = 0;
+        size_t items = 0;
+        if (((code & 0b10000000) == 0) || ((code & 0b11100000) == 0b11100000)) {
+            // fixint
+        } else if ((code & 0b11100000) == 0b10100000) {
+            payload = code & 0b11111;
+        } else if ((code & 0b11110000) == 0b10010000) {
+            items = code & 0b1111;
+        } else if ((code & 0b11110000) == 0b10000000) {
+            items = 2 * (code & 0b1111);
+        } else {
+            static const uint8_t sizes[] = {
+                // c0 - c9: nil, (never used), false, true, bin 8/16/32, ext 8/16/32
+                0, 0xff, 0, 0, 1, 2, 4, 1, 2, 4,
+                // ca - d3: float 32/64, uint 8/16/32/64, int 8/16/32/64
+                4, 8, 1, 2, 4, 8, 1, 2, 4, 8,
+                // d4 - d8: fixext 1/2/4/8/16
+                1 + 1, 1 + 2, 1 + 4, 1 + 8, 1 + 16,
+                // d9 - df: str 8/16/32, array 16/32, map 16/32
+                1, 2, 4, 2, 4, 2, 4,
+            };
+            uint8_t size = sizes[code - 0xc0];
+            if (size == 0xff) {
+                *valid = false;
+                return pos + 1;
+            }
+            if ((code >= 0xc4 && code <= 0xc9) || (code >= 0xd9 && code <= 0xdf)) {
+                // The size is the length of a length or count that follows.
+                if (pos + 1 + size > len) {
+                    return 0;
+                }
+                size_t n = big_endian(data + pos + 1, size);
+                if (n > len) {
+                    // Every byte or object takes at least a byte.
+                    return 0;
+                }
+                header += size;
+                if (code >= 0xdc) {
+                    items = code >= 0xde ? 2 * n : n;
+                } else {
+                    payload = n;
+                    if (code >= 0xc7 && code <= 0xc9) {
+                        // ext type byte
+                        payload++;
+                    }
+                }
+            } else {
+                payload = size;
+            }
+        }
+        if (payload > len - pos - header) {
+            return 0;
+        }
+        pos += header + payload;
+        remaining += items - 1;
+    }
+    return pos;
+}
+
+mp_obj_t shared_module_msgpack_unpack_buffer(const uint8_t *data, size_t len, mp_obj_t ext_hook, bool use_list) {
+    msgpack_stream_t stream = get_buffer_stream(data, len);
+    return unpack(&stream, ext_hook, use_list);
+}
+
+size_t shared_module_msgpack_unpack_buffer_into(const uint8_t *data, size_t len, mp_obj_t target) {
+    msgpack_stream_t stream = get_buffer_stream(data, len);
+    return unpack_into(&stream, target);
+}
+
 void common_hal_msgpack_pack(mp_obj_t obj, mp_obj_t stream_obj, mp_obj_t default_handler) {
     msgpack_stream_t stream = get_stream(stream_obj, MP_STREAM_OP_WRITE);
     pack(obj, &stream, default_handler);
@@ -502,3 +753,8 @@ mp_obj_t common_hal_msgpack_unpack(mp_obj_t stream_obj, mp_obj_t ext_hook, bool
     msgpack_stream_t stream = get_stream(stream_obj, MP_STREAM_OP_READ);
     return unpack(&stream, ext_hook, use_list);
 }
+
+size_t common_hal_msgpack_unpack_into(mp_obj_t stream_obj, mp_obj_t target) {
+    msgpack_stream_t stream = get_stream(stream_obj, MP_STREAM_OP_READ);
+    return unpack_into(&stream, target);
+}
@@ -9,3 +9,11 @@
 
 void common_hal_msgpack_pack(mp_obj_t obj, mp_obj_t stream_obj, mp_obj_t default_handler);
 mp_obj_t common_hal_msgpack_unpack(mp_obj_t stream_obj, mp_obj_t ext_hook, bool use_list);
+size_t common_hal_msgpack_unpack_into(mp_obj_t stream_obj, mp_obj_t target);
+
+// Returns the length of the object at the start of `data`, or 0 if it isn't
+// all there yet. An object holding the reserved type byte can't be unpacked;
+// `valid` is then cleared and the length runs up to and including that byte.
+size_t shared_module_msgpack_object_size(const uint8_t *data, size_t len, bool *valid);
+mp_obj_t shared_module_msgpack_unpack_buffer(const uint8_t *data, size_t len, mp_obj_t ext_hook, bool use_list);
+size_t shared_module_msgpack_unpack_buffer_into(const uint8_t *data, size_t len, mp_obj_t target);
@@ -152,7 +152,18 @@ int16_t synthio_mix_down_sample(int32_t sample, int32_t scale) {
     return sample;
 }
 
-static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *out_buffer32, int16_t dur, int16_t loudness[2]) {
+// Oscillator settings of one voice for the current block, worked out before any samples are made.
+typedef struct {
+    const int16_t *waveform;
+    uint32_t dds_rate;
+    uint32_t offset;
+    uint32_t lim;
+} synthio_oscillator_t;
+
+// Evaluates the note's block-rate controls (pitch, bend, panning, ring) into osc and ring. Returns
+// false when the note can't be played, such as when it is above nyquist. ring->dds_rate is 0 when
+// there is nothing to ring modulate by.
+static bool synth_note_prepare(synthio_synth_t *synth, int chan, int16_t dur, int16_t loudness[2], synthio_oscillator_t *osc, synthio_oscillator_t *ring) {
     mp_obj_t note_obj = synth->span.note_obj[chan];
 
     int32_t sample_rate = synth->base.sample_rate;
@@ -201,62 +212,127 @@ static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *ou
         }
     }
 
-    uint32_t offset = waveform_start << SYNTHIO_FREQUENCY_SHIFT;
-    uint32_t lim = waveform_length << SYNTHIO_FREQUENCY_SHIFT;
-    uint32_t accum = synth->accum[chan];
+    osc->waveform = waveform;
+    osc->dds_rate = dds_rate;
+    osc->offset = waveform_start << SYNTHIO_FREQUENCY_SHIFT;
+    osc->lim = waveform_length << SYNTHIO_FREQUENCY_SHIFT;
 
-    if (dds_rate > lim / 2) {
+    if (dds_rate > osc->lim / 2) {
         // beyond nyquist, can't play note
         return false;
     }
 
     // can happen if note waveform gets set mid-note, but the expensive modulo is usually avoided
-    if (accum > lim) {
-        accum = accum % lim + offset;
+    if (synth->accum[chan] > osc->lim) {
+        synth->accum[chan] = synth->accum[chan] % osc->lim + osc->offset;
     }
 
+    ring->waveform = ring_waveform;
+    ring->dds_rate = ring_dds_rate;
+    ring->offset = ring_waveform_start << SYNTHIO_FREQUENCY_SHIFT;
+    ring->lim = ring_waveform_length << SYNTHIO_FREQUENCY_SHIFT;
+    if (ring_dds_rate > osc->lim / 2) {
+        // beyond nyquist, can't play ring (but can still play the main sound)
+        ring->dds_rate = 0;
+    }
+    if (ring->dds_rate && synth->ring_accum[chan] > ring->lim) {
+        synth->ring_accum[chan] = synth->ring_accum[chan] % ring->lim + ring->offset;
+    }
+    return true;
+}
+
+// Adds (sample * loudness) >> 16 to acc, in one instruction where the DSP extension is available
+// (Cortex-M4, M7 and M33). Filtered samples can exceed 16 bits, so the product needs all 48 bits as it
+// has with SMLAWB.
+__attribute__((always_inline))
+static inline int32_t synth_mac(int32_t acc, int32_t sample, int16_t loudness) {
+    #if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+    asm ("smlawb %0, %1, %2, %3" : "=r" (acc) : "r" (sample), "r" (loudness), "r" (acc));
+    return acc;
+    #else
+    return acc + (int32_t)(((int64_t)sample * loudness) >> 16);
+    #endif
+}
+
+// Steps the oscillator's accumulator and returns the next waveform sample.
+__attribute__((always_inline))
+static inline int16_t synth_oscillator_next(const synthio_oscillator_t *osc, uint32_t *accum) {
+    *accum += osc->dds_rate;
+    // because dds_rate is low enough, the subtraction is guaranteed to go back into range, no expensive modulo needed
+    if (*accum > osc->lim) {
+        *accum = *accum - osc->lim + osc->offset;
+    }
+    int16_t idx = *accum >> SYNTHIO_FREQUENCY_SHIFT;
+    return osc->waveform[idx];
+}
+
+// Renders one voice into out_buffer32 so it can be ring modulated and filtered before mixing.
+static void synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *out_buffer32, int16_t dur, const synthio_oscillator_t *osc, const synthio_oscillator_t *ring) {
     // first, fill with waveform
+    uint32_t accum = synth->accum[chan];
     for (uint16_t i = 0; i < dur; i++) {
-        accum += dds_rate;
-        // because dds_rate is low enough, the subtraction is guaranteed to go back into range, no expensive modulo needed
-        if (accum > lim) {
-            accum = accum - lim + offset;
-        }
-        int16_t idx = accum >> SYNTHIO_FREQUENCY_SHIFT;
-        out_buffer32[i] = waveform[idx];
+        out_buffer32[i] = synth_oscillator_next(osc, &accum);
     }
     synth->accum[chan] = accum;
 
-    if (ring_dds_rate) {
-        if (ring_dds_rate > lim / 2) {
-            // beyond nyquist, can't play ring (but did synth main sound so
-            // return true)
-            return true;
-        }
-
+    if (ring->dds_rate) {
         // now modulate by ring and accumulate
         accum = synth->ring_accum[chan];
-        offset = ring_waveform_start << SYNTHIO_FREQUENCY_SHIFT;
-        lim = ring_waveform_length << SYNTHIO_FREQUENCY_SHIFT;
-
-        // can happen if note waveform gets set mid-note, but the expensive modulo is usually avoided
-        if (accum > lim) {
-            accum = accum % lim + offset;
+        for (uint16_t i = 0; i < dur; i++) {
+            int16_t wi = (synth_oscillator_next(ring, &accum) * out_buffer32[i]) / 32768;
+            out_buffer32[i] = wi;
         }
+        synth->ring_accum[chan] = accum;
+    }
+}
 
+// Generates voices without ring modulation or a filter straight into the mix. Voices go two at a
+// time so each output sample is loaded and stored once per pair instead of once per voice.
+static void synth_mix_voices(synthio_synth_t *synth, int32_t *out_buffer32, uint16_t dur, uint8_t count,
+    const uint8_t *chans, const synthio_oscillator_t *osc, int16_t (*loudness)[2]) {
+    bool stereo = synth->base.channel_count == 2;
+    uint8_t v = 0;
+    for (; v + 1 < count; v += 2) {
+        const synthio_oscillator_t *osc0 = &osc[v], *osc1 = &osc[v + 1];
+        uint32_t accum0 = synth->accum[chans[v]], accum1 = synth->accum[chans[v + 1]];
+        int32_t *out = out_buffer32;
+        if (stereo) {
+            int16_t left0 = loudness[v][0], right0 = loudness[v][1];
+            int16_t left1 = loudness[v + 1][0], right1 = loudness[v + 1][1];
+            for (uint16_t i = 0; i < dur; i++) {
+                int32_t sample0 = synth_oscillator_next(osc0, &accum0);
+                int32_t sample1 = synth_oscillator_next(osc1, &accum1);
+                out[0] = synth_mac(synth_mac(out[0], sample0, left0), sample1, left1);
+                out[1] = synth_mac(synth_mac(out[1], sample0, right0), sample1, right1);
+                out += 2;
+            }
+        } else {
+            int16_t loudness0 = loudness[v][0], loudness1 = loudness[v + 1][0];
+            for (uint16_t i = 0; i < dur; i++) {
+                int32_t sample0 = synth_oscillator_next(osc0, &accum0);
+                int32_t sample1 = synth_oscillator_next(osc1, &accum1);
+                *out = synth_mac(synth_mac(*out, sample0, loudness0), sample1, loudness1);
+                out++;
+            }
+        }
+        synth->accum[chans[v]] = accum0;
+        synth->accum[chans[v + 1]] = accum1;
+    }
+    if (v < count) {
+        const synthio_oscillator_t *osc0 = &osc[v];
+        uint32_t accum0 = synth->accum[chans[v]];
+        int32_t *out = out_buffer32;
         for (uint16_t i = 0; i < dur; i++) {
-            accum += ring_dds_rate;
-            // because dds_rate is low enough, the subtraction is guaranteed to go back into range, no expensive modulo needed
-            if (accum > lim) {
-                accum = accum - lim + offset;
+            int32_t sample0 = synth_oscillator_next(osc0, &accum0);
+            *out = synth_mac(*out, sample0, loudness[v][0]);
+            out++;
+            if (stereo) {
+                *out = synth_mac(*out, sample0, loudness[v][1]);
+                out++;
             }
-            int16_t idx = accum >> SYNTHIO_FREQUENCY_SHIFT;
-            int16_t wi = (ring_waveform[idx] * out_buffer32[i]) / 32768;
-            out_buffer32[i] = wi;
         }
-        synth->ring_accum[chan] = accum;
+        synth->accum[chans[v]] = accum0;
     }
-    return true;
 }
 
 static mp_obj_t synthio_synth_get_note_filter(mp_obj_t note_obj) {
@@ -273,12 +349,15 @@ static mp_obj_t synthio_synth_get_note_filter(mp_obj_t note_obj) {
 static void sum_with_loudness(int32_t *out_buffer32, int32_t *tmp_buffer32, int16_t loudness[2], size_t dur, int synth_chan) {
     if (synth_chan == 1) {
         for (size_t i = 0; i < dur; i++) {
-            *out_buffer32++ += (*tmp_buffer32++ *loudness[0]) >> 16;
+            *out_buffer32 = synth_mac(*out_buffer32, *tmp_buffer32++, loudness[0]);
+            out_buffer32++;
         }
     } else {
         for (size_t i = 0; i < dur; i++) {
-            *out_buffer32++ += (*tmp_buffer32 * loudness[0]) >> 16;
-            *out_buffer32++ += (*tmp_buffer32++ *loudness[1]) >> 16;
+            *out_buffer32 = synth_mac(*out_buffer32, *tmp_buffer32, loudness[0]);
+            out_buffer32++;
+            *out_buffer32 = synth_mac(*out_buffer32, *tmp_buffer32++, loudness[1]);
+            out_buffer32++;
         }
     }
 }
@@ -304,6 +383,12 @@ void synthio_synth_synthesize(synthio_synth_t *synth, uint8_t **bufptr, uint32_t
     int32_t tmp_buffer32[SYNTHIO_MAX_DUR];
     memset(out_buffer32, 0, synth->base.channel_count * dur * sizeof(int32_t));
 
+    // Voices without ring modulation or a filter are gathered up and mixed together at the end.
+    uint8_t simple_count = 0;
+    uint8_t simple_chans[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+    synthio_oscillator_t simple_osc[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+    int16_t simple_loudness[CIRCUITPY_SYNTHIO_MAX_CHANNELS][2];
+
     for (int chan = 0; chan < CIRCUITPY_SYNTHIO_MAX_CHANNELS; chan++) {
         mp_obj_t note_obj = synth->span.note_obj[chan];
         if (note_obj == SYNTHIO_SILENCE) {
@@ -318,13 +403,25 @@ void synthio_synth_synthesize(synthio_synth_t *synth, uint8_t **bufptr, uint32_t
 
         int16_t loudness[2] = {synth->envelope_state[chan].level, synth->envelope_state[chan].level};
 
-        if (!synth_note_into_buffer(synth, chan, tmp_buffer32, dur, loudness)) {
+        synthio_oscillator_t osc, ring;
+        if (!synth_note_prepare(synth, chan, dur, loudness, &osc, &ring)) {
             // for some other reason, such as being above nyquist, note
             // couldn't be synthed, so don't filter or sum it in
             continue;
         }
 
         mp_obj_t filter_obj = synthio_synth_get_note_filter(note_obj);
+        if (filter_obj == mp_const_none && ring.dds_rate == 0) {
+            simple_chans[simple_count] = chan;
+            simple_osc[simple_count] = osc;
+            simple_loudness[simple_count][0] = loudness[0];
+            simple_loudness[simple_count][1] = loudness[1];
+            simple_count++;
+            continue;
+        }
+
+        synth_note_into_buffer(synth, chan, tmp_buffer32, dur, &osc, &ring);
+
         if (filter_obj != mp_const_none) {
             synthio_note_obj_t *note = MP_OBJ_TO_PTR(note_obj);
             if (mp_obj_is_type(filter_obj, &synthio_block_biquad_type_obj)) {
@@ -337,6 +434,8 @@ void synthio_synth_synthesize(synthio_synth_t *synth, uint8_t **bufptr, uint32_t
         sum_with_loudness(out_buffer32, tmp_buffer32, loudness, dur, synth->base.channel_count);
     }
 
+    synth_mix_voices(synth, out_buffer32, dur, simple_count, simple_chans, simple_osc, simple_loudness);
+
     int16_t *out_buffer16 = (int16_t *)(void *)synth->buffers[synth->buffer_index];
 
     // mix down audio
@@ -140,7 +140,7 @@ size_t usb_video_add_descriptor(uint8_t *descriptor_buf, descriptor_counts_t *de
     return sizeof(usb_video_descriptor);
 }
 
-background_callback_t usb_video_cb;
+background_callback_t usb_video_cb = { .priority = BACKGROUND_CALLBACK_PRIORITY_USB };
 
 static void usb_video_cb_fun(void *unused) {
     (void)unused;
@@ -226,6 +226,7 @@ void common_hal_vectorio_vector_shape_construct(vectorio_vector_shape_t *self,
     self->ephemeral_dirty_area.x1 = self->ephemeral_dirty_area.x2; // Cheat to set area to 0
     self->ephemeral_dirty_area.next = NULL;
     self->current_area_dirty = true;
+    self->occluded = false;
     _get_screen_area(self, &self->current_area);
 }
 
@@ -337,7 +338,7 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
     uint64_t pixel_time = 0;
     #endif
 
-    if (self->hidden) {
+    if (self->hidden || self->occluded) {
         return false;
     }
 
@@ -374,6 +375,7 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
     self->ishape.get_area(self->ishape.shape, &shape_area);
 
     uint16_t mask_start_px = line_dirty_offset_px;
+    uint32_t newly_set = 0;
     for (input_pixel.y = overlap.y1; input_pixel.y < overlap.y2; ++input_pixel.y) {
         mask_start_px += column_dirty_offset_px;
         for (input_pixel.x = overlap.x1; input_pixel.x < overlap.x2; ++input_pixel.x) {
@@ -429,6 +431,7 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
                 }
 
                 *mask_doubleword |= 1u << mask_bit;
+                newly_set++;
                 if (colorspace->depth == 16) {
                     VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %04x 16", output_pixel.pixel);
                     *(((uint16_t *)buffer) + pixel_index) = output_pixel.pixel;
@@ -457,6 +460,7 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
         }
         mask_start_px += linestride_px - column_dirty_offset_px;
     }
+    *displayio_mask_set_count(mask, area) += newly_set;
     #ifdef VECTORIO_PERF
     uint64_t end = common_hal_time_monotonic_ns();
     uint32_t pixels = (overlap.x2 - overlap.x1) * (overlap.y2 - overlap.y1);
@@ -474,7 +478,17 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
 }
 
 
+bool vectorio_vector_shape_update_occlusion(vectorio_vector_shape_t *self, displayio_occluders_t *occluders) {
+    if (self->hidden) {
+        return true;
+    }
+    self->occluded = displayio_occluders_cover(occluders, &self->current_area);
+    return self->occluded;
+}
+
 void vectorio_vector_shape_finish_refresh(vectorio_vector_shape_t *self) {
+    // Occlusion is only known during a refresh.
+    self->occluded = false;
     if (displayio_area_empty(&self->ephemeral_dirty_area) && !self->current_area_dirty) {
         return;
     }
@@ -43,6 +43,7 @@ typedef struct {
     displayio_area_t current_area;
     bool current_area_dirty;
     bool hidden;
+    bool occluded;
 } vectorio_vector_shape_t;
 
 displayio_area_t *vectorio_vector_shape_get_refresh_areas(vectorio_vector_shape_t *self, displayio_area_t *tail);
@@ -56,3 +57,6 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
 // false if the vector shape wasn't rendered in the last frame.
 bool vectorio_vector_shape_get_previous_area(vectorio_vector_shape_t *self, displayio_area_t *out_area);
 void vectorio_vector_shape_finish_refresh(vectorio_vector_shape_t *self);
+
+// Shapes only ever get occluded. They don't occlude others because they rarely fill their area.
+bool vectorio_vector_shape_update_occlusion(vectorio_vector_shape_t *self, displayio_occluders_t *occluders);
@@ -0,0 +1,252 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/runtime.h"
+
+#include "shared-bindings/zlib/Decompress.h"
+
+// Output is produced in chunks of at most this many bytes. Before each chunk
+// the decoder state is saved so that the chunk can be redone once more input
+// arrives if the input runs out part way through it.
+#define CHUNK_SIZE (1024)
+
+enum {
+    STAGE_HEADER,
+    STAGE_DATA,
+    STAGE_TRAILER,
+    STAGE_DONE,
+};
+
+enum {
+    STATUS_NEED_INPUT,
+    STATUS_OUTPUT_FULL,
+    STATUS_EOF,
+};
+
+void common_hal_zlib_decompress_construct(zlib_decompress_obj_t *self, mp_int_t wbits) {
+    mp_int_t window_bits = wbits;
+    if (window_bits < 0) {
+        window_bits = -window_bits;
+    } else if (window_bits >= 16) {
+        window_bits -= 16;
+    }
+    if (window_bits == 0) {
+        window_bits = 15;
+    }
+    if (window_bits < 8 || window_bits > 15) {
+        mp_arg_error_invalid(MP_QSTR_wbits);
+    }
+
+    // The dictionary holds a chunk more than the window. The oldest bytes can
+    // then be overwritten by a chunk that has to be redone without losing any
+    // byte the stream may still refer back to.
+    self->window_len = (1 << window_bits) + CHUNK_SIZE;
+    self->window = m_new(uint8_t, self->window_len);
+    memset(&self->decomp, 0, sizeof(self->decomp));
+    uzlib_uncompress_init(&self->decomp, self->window, self->window_len);
+    self->pending = NULL;
+    self->pending_len = 0;
+    self->pending_alloc = 0;
+    self->unused_data = mp_const_empty_bytes;
+    self->unconsumed_tail = mp_const_empty_bytes;
+    self->wbits = wbits;
+    self->stage = STAGE_HEADER;
+}
+
+// Decompresses as much of `in` into `out` as the input and output allow.
+static int decompress_chunks(zlib_decompress_obj_t *self, const uint8_t *in, size_t in_len, uint8_t *out, size_t out_len, size_t *consumed, size_t *written) {
+    TINF_DATA *d = &self->decomp;
+    d->source = in;
+    d->source_limit = in + in_len;
+    *written = 0;
+    int status = STATUS_NEED_INPUT;
+
+    if (self->stage == STAGE_HEADER) {
+        self->saved = *d;
+        int st = TINF_OK;
+        if (self->wbits >= 16) {
+            st = uzlib_gzip_parse_header(d);
+        } else if (self->wbits >= 0) {
+            st = uzlib_zlib_parse_header(d);
+        }
+        if (d->eof) {
+            *d = self->saved;
+            *consumed = 0;
+            return STATUS_NEED_INPUT;
+        }
+        if (st < 0) {
+            mp_raise_type_arg(&mp_type_ValueError, MP_OBJ_NEW_SMALL_INT(st));
+        }
+        self->stage = STAGE_DATA;
+    }
+
+    while (self->stage == STAGE_DATA) {
+        size_t space = out_len - *written;
+        if (space == 0) {
+            status = STATUS_OUTPUT_FULL;
+            break;
+        }
+        self->saved = *d;
+        uint8_t *start = out + *written;
+        d->dest = start;
+        d->dest_limit = start + MIN(space, CHUNK_SIZE);
+        int st = uzlib_uncompress(d);
+        if (d->eof) {
+            *d = self->saved;
+            break;
+        }
+        if (st < 0) {
+            mp_raise_type_arg(&mp_type_ValueError, MP_OBJ_NEW_SMALL_INT(st));
+        }
+        size_t n = d->dest - start;
+        if (d->checksum_type == TINF_CHKSUM_ADLER) {
+            d->checksum = uzlib_adler32(start, n, d->checksum);
+        } else if (d->checksum_type == TINF_CHKSUM_CRC) {
+            d->checksum = uzlib_crc32(start, n, d->checksum);
+        }
+        *written += n;
+        if (st == TINF_DONE) {
+            self->stage = STAGE_TRAILER;
+        }
+    }
+
+    if (self->stage == STAGE_TRAILER) {
+        // The trailer starts on the byte after the last block.
+        const uint8_t *trailer = d->source;
+        size_t available = d->source_limit - trailer;
+        if (d->checksum_type == TINF_CHKSUM_ADLER && available >= 4) {
+            uint32_t adler = (trailer[0] << 24) | (trailer[1] << 16) | (trailer[2] << 8) | trailer[3];
+            if (adler != d->checksum) {
+                mp_raise_type_arg(&mp_type_ValueError, MP_OBJ_NEW_SMALL_INT(TINF_CHKSUM_ERROR));
+            }
+            d->source += 4;
+            self->stage = STAGE_DONE;
+        } else if (d->checksum_type == TINF_CHKSUM_CRC && available >= 8) {
+            uint32_t crc = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | ((uint32_t)trailer[3] << 24);
+            if (crc != ~d->checksum) {
+                mp_raise_type_arg(&mp_type_ValueError, MP_OBJ_NEW_SMALL_INT(TINF_CHKSUM_ERROR));
+            }
+            // Skip the uncompressed size too.
+            d->source += 8;
+            self->stage = STAGE_DONE;
+        } else if (d->checksum_type == TINF_CHKSUM_NONE) {
+            self->stage = STAGE_DONE;
+        }
+    }
+
+    *consumed = d->source - in;
+    if (self->stage == STAGE_DONE) {
+        return STATUS_EOF;
+    }
+    return status;
+}
+
+// Decompresses the held back input followed by `data`. The output goes to
+// `buf` or, when `vstr` is given, is appended to it, growing it geometrically
+// up to `max_len` bytes (0 for no limit).
+static size_t decompress_input(zlib_decompress_obj_t *self, const uint8_t *data, size_t len, vstr_t *vstr, uint8_t *buf, size_t max_len) {
+    const uint8_t *in = data;
+    size_t in_len = len;
+    uint8_t *merged = NULL;
+    size_t merged_len = 0;
+    if (self->pending_len > 0 && len > 0) {
+        merged_len = self->pending_len + len;
+        merged = m_new(uint8_t, merged_len);
+        memcpy(merged, self->pending, self->pending_len);
+        memcpy(merged + self->pending_len, data, len);
+        in = merged;
+        in_len = merged_len;
+    } else if (self->pending_len > 0) {
+        in = self->pending;
+        in_len = self->pending_len;
+    }
+
+    size_t total = 0;
+    int status;
+    while (true) {
+        uint8_t *out;
+        size_t out_len;
+        if (vstr != NULL) {
+            size_t limit = max_len == 0 ? SIZE_MAX : max_len;
+            if (vstr->alloc == vstr->len && vstr->len < limit) {
+                vstr_hint_size(vstr, MIN(MAX(vstr->alloc, (size_t)CHUNK_SIZE), limit - vstr->len));
+            }
+            out = (uint8_t *)vstr->buf + vstr->len;
+            out_len = MIN(vstr->alloc, limit) - vstr->len;
+        } else {
+            out = buf + total;
+            out_len = max_len - total;
+        }
+        size_t consumed;
+        size_t written;
+        status = decompress_chunks(self, in, in_len, out, out_len, &consumed, &written);
+        in += consumed;
+        in_len -= consumed;
+        total += written;
+        if (vstr == NULL) {
+            break;
+        }
+        vstr->len += written;
+        if (status != STATUS_OUTPUT_FULL || (max_len != 0 && vstr->len >= max_len)) {
+            break;
+        }
+    }
+
+    self->unconsumed_tail = mp_const_empty_bytes;
+    if (status == STATUS_EOF) {
+        if (in_len > 0) {
+            mp_obj_t rest = mp_obj_new_bytes(in, in_len);
+            self->unused_data = mp_binary_op(MP_BINARY_OP_ADD, self->unused_data, rest);
+        }
+        in_len = 0;
+    } else if (status == STATUS_OUTPUT_FULL) {
+        self->unconsumed_tail = mp_obj_new_bytes(in, in_len);
+        in_len = 0;
+    }
+    // Whatever is left ended part way through a chunk. It's at most what one
+    // chunk needs so keep a copy for next time.
+    if (in_len > self->pending_alloc) {
+        self->pending = m_renew(uint8_t, self->pending, self->pending_alloc, in_len);
+        self->pending_alloc = in_len;
+    }
+    memmove(self->pending, in, in_len);
+    self->pending_len = in_len;
+
+    if (merged != NULL) {
+        m_del(uint8_t, merged, merged_len);
+    }
+    return total;
+}
+
+mp_obj_t common_hal_zlib_decompress_decompress(zlib_decompress_obj_t *self, const uint8_t *data, size_t len, size_t max_length) {
+    vstr_t vstr;
+    // Compressed data usually expands a few times over.
+    size_t initial = MAX(len * 4, (size_t)CHUNK_SIZE);
+    if (max_length != 0) {
+        initial = MIN(initial, max_length);
+    }
+    vstr_init(&vstr, initial);
+    decompress_input(self, data, len, &vstr, NULL, max_length);
+    return mp_obj_new_bytes_from_vstr(&vstr);
+}
+
+size_t common_hal_zlib_decompress_decompress_into(zlib_decompress_obj_t *self, const uint8_t *data, size_t len, uint8_t *buf, size_t buf_len) {
+    return decompress_input(self, data, len, NULL, buf, buf_len);
+}
+
+bool common_hal_zlib_decompress_get_eof(zlib_decompress_obj_t *self) {
+    return self->stage == STAGE_DONE;
+}
+
+mp_obj_t common_hal_zlib_decompress_get_unused_data(zlib_decompress_obj_t *self) {
+    return self->unused_data;
+}
+
+mp_obj_t common_hal_zlib_decompress_get_unconsumed_tail(zlib_decompress_obj_t *self) {
+    return self->unconsumed_tail;
+}
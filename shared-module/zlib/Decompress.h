@@ -0,0 +1,30 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+#define UZLIB_CONF_PARANOID_CHECKS (1)
+#include "lib/uzlib/tinf.h"
+
+typedef struct {
+    mp_obj_base_t base;
+    TINF_DATA decomp;
+    // Decoder state from before the chunk being decompressed, restored when
+    // the input runs out part way through it.
+    TINF_DATA saved;
+    uint8_t *window;
+    size_t window_len;
+    // Input that ended part way through a chunk, used before the next data.
+    uint8_t *pending;
+    size_t pending_len;
+    size_t pending_alloc;
+    mp_obj_t unused_data;
+    mp_obj_t unconsumed_tail;
+    int8_t wbits;
+    uint8_t stage;
+} zlib_decompress_obj_t;
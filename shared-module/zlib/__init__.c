@@ -28,7 +28,7 @@
 #define DEBUG_printf(...) (void)0
 #endif
 
-mp_obj_t common_hal_zlib_decompress(mp_obj_t data, mp_int_t wbits) {
+mp_obj_t common_hal_zlib_decompress(mp_obj_t data, mp_int_t wbits, mp_int_t bufsize) {
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(data, &bufinfo, MP_BUFFER_READ);
 
@@ -36,12 +36,32 @@ mp_obj_t common_hal_zlib_decompress(mp_obj_t data, mp_int_t wbits) {
     memset(decomp, 0, sizeof(*decomp));
     DEBUG_printf("sizeof(TINF_DATA)=" UINT_FMT "\n", sizeof(*decomp));
     uzlib_uncompress_init(decomp, NULL, 0);
-    mp_uint_t dest_buf_size = (bufinfo.len + 15) & ~15;
-    byte *dest_buf = m_new(byte, dest_buf_size);
+
+    // Start with the caller's guess or, for gzip, the size stored in the
+    // trailer. One extra byte lets the decoder reach the end of the stream
+    // without first growing the buffer. The trailer size is only a hint: it
+    // is the size modulo 2**32 and may be wrong in corrupt data, so don't
+    // insist on getting it.
+    byte *dest_buf = NULL;
+    mp_uint_t dest_buf_size = 0;
+    if (bufsize > 0) {
+        dest_buf_size = bufsize + 1;
+    } else if (wbits >= 16 && bufinfo.len >= 18) {
+        const byte *isize = (const byte *)bufinfo.buf + bufinfo.len - 4;
+        dest_buf_size = (isize[0] | (isize[1] << 8) | (isize[2] << 16) | ((uint32_t)isize[3] << 24)) + 1;
+    }
+    if (dest_buf_size > 0) {
+        dest_buf = m_new_maybe(byte, dest_buf_size);
+    }
+    if (dest_buf == NULL) {
+        // Compressed data usually expands a few times over.
+        dest_buf_size = MAX((bufinfo.len * 2 + 15) & ~15, 256);
+        dest_buf = m_new(byte, dest_buf_size);
+    }
 
     decomp->dest = dest_buf;
     decomp->dest_limit = dest_buf + dest_buf_size;
-    DEBUG_printf("zlib: Initial out buffer: " UINT_FMT " bytes\n", decomp->destSize);
+    DEBUG_printf("zlib: Initial out buffer: " UINT_FMT " bytes\n", dest_buf_size);
     decomp->source = bufinfo.buf;
     decomp->source_limit = (unsigned char *)bufinfo.buf + bufinfo.len;
     int st;
@@ -66,11 +86,14 @@ mp_obj_t common_hal_zlib_decompress(mp_obj_t data, mp_int_t wbits) {
         if (st == TINF_DONE) {
             break;
         }
+        // Grow by half again so that the total copying stays linear in the
+        // output size.
         size_t offset = decomp->dest - dest_buf;
-        dest_buf = m_renew(byte, dest_buf, dest_buf_size, dest_buf_size + 256);
-        dest_buf_size += 256;
+        mp_uint_t new_size = dest_buf_size + MAX(dest_buf_size / 2, 256);
+        dest_buf = m_renew(byte, dest_buf, dest_buf_size, new_size);
+        dest_buf_size = new_size;
         decomp->dest = dest_buf + offset;
-        decomp->dest_limit = dest_buf + offset + 256;
+        decomp->dest_limit = dest_buf + dest_buf_size;
     }
 
     mp_uint_t final_sz = decomp->dest - dest_buf;
@@ -7,6 +7,9 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
+
+#include "py/mpconfig.h"
 
 /** Background callbacks are a linked list of tasks to call in the background.
  *
@@ -27,6 +30,13 @@
  *
  * background_callback_add can be called from interrupt context.
  *
+ * Callbacks are run in order of their `priority`, highest first, and in the
+ * order they were added within a priority. Set it before adding the callback.
+ * A zero-initialized callback has BACKGROUND_CALLBACK_PRIORITY_DEFAULT. Each
+ * priority's queue is taken once per background_callback_run_all(), so
+ * callbacks added to a priority that has already been run wait for the next
+ * call, like before.
+ *
  * If your work isn't triggered by an event, then it may be better implemented
  * using ticks, which runs tasks every millisecond or so. Ticks are enabled with
  * supervisor_enable_tick() and disabled with supervisor_disable_tick(). When
@@ -34,11 +44,29 @@
  * which includes port_background_tick(), every millisecond.
  */
 typedef void (*background_callback_fun)(void *data);
+
+typedef enum {
+    BACKGROUND_CALLBACK_PRIORITY_WEB = -2,
+    BACKGROUND_CALLBACK_PRIORITY_DISPLAY = -1,
+    BACKGROUND_CALLBACK_PRIORITY_DEFAULT = 0,
+    BACKGROUND_CALLBACK_PRIORITY_USB = 1,
+    BACKGROUND_CALLBACK_PRIORITY_AUDIO = 2,
+} background_callback_priority_t;
+
+#define BACKGROUND_CALLBACK_PRIORITY_LOWEST (BACKGROUND_CALLBACK_PRIORITY_WEB)
+#define BACKGROUND_CALLBACK_PRIORITY_HIGHEST (BACKGROUND_CALLBACK_PRIORITY_AUDIO)
+#define BACKGROUND_CALLBACK_PRIORITY_COUNT (BACKGROUND_CALLBACK_PRIORITY_HIGHEST - BACKGROUND_CALLBACK_PRIORITY_LOWEST + 1)
+
 typedef struct background_callback {
     background_callback_fun fun;
     void *data;
     struct background_callback *next;
     struct background_callback *prev;
+    int8_t priority;
+    #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+    // When the callback was added, in 1/32768ths of a second.
+    uint32_t queued_at;
+    #endif
 } background_callback_t;
 
 /* Add a background callback for which 'fun' and 'data' were previously set */
@@ -75,3 +103,28 @@ void background_callback_allow(void);
  * Background callbacks may stop objects from being collected
  */
 void background_callback_gc_collect(void);
+
+#if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+/* Statistics are kept for at most this many functions. */
+#define BACKGROUND_CALLBACK_STATS_COUNT (16)
+
+/* Timing of the callbacks run with each function. Times are in 1/32768ths of
+ * a second, the resolution of port_get_raw_ticks(). A run that takes longer
+ * than its priority's budget is counted as an overrun.
+ */
+typedef struct {
+    background_callback_fun fun;
+    uint32_t count;
+    uint32_t overruns;
+    uint32_t max_run;
+    uint32_t max_latency;
+    uint64_t total_run;
+    uint64_t total_latency;
+    int8_t priority;
+} background_callback_stats_t;
+
+/* Copy the statistics for up to `len` functions into `stats` and return how
+ * many there are. */
+size_t background_callback_get_stats(background_callback_stats_t *stats, size_t len);
+void background_callback_reset_stats(void);
+#endif
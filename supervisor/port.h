@@ -105,6 +105,13 @@ void port_post_boot_py(bool heap_valid);
 // A default weak implementation is provided that does nothing.
 void port_boot_info(void);
 
+// Some ports can scan keypads from a hardware timer interrupt more often than
+// the 1/1024 second tick. Start calling keypad_tick() every interval_us
+// microseconds and return true, or return false to leave scanning to the tick.
+// A default weak implementation is provided that returns false.
+bool port_keypad_timer_start(uint32_t interval_us);
+void port_keypad_timer_stop(void);
+
 // Some ports want to mark additional pointers as gc roots.
 // A default weak implementation is provided that does nothing.
 void port_gc_collect(void);
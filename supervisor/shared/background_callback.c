@@ -12,9 +12,17 @@
 #include "supervisor/linker.h"
 #include "supervisor/port.h"
 #include "supervisor/shared/tick.h"
+#if !defined(CALLBACK_CRITICAL_BEGIN) || !defined(CALLBACK_CRITICAL_END)
 #include "shared-bindings/microcontroller/__init__.h"
+#endif
+
+// One queue per priority, highest priority first.
+static volatile background_callback_t *volatile callback_head[BACKGROUND_CALLBACK_PRIORITY_COUNT];
+static volatile background_callback_t *volatile callback_tail[BACKGROUND_CALLBACK_PRIORITY_COUNT];
 
-static volatile background_callback_t *volatile callback_head, *volatile callback_tail;
+static inline size_t queue_index(const background_callback_t *cb) {
+    return BACKGROUND_CALLBACK_PRIORITY_HIGHEST - cb->priority;
+}
 
 #ifndef CALLBACK_CRITICAL_BEGIN
 #define CALLBACK_CRITICAL_BEGIN (common_hal_mcu_disable_interrupts())
@@ -26,21 +34,82 @@ static volatile background_callback_t *volatile callback_head, *volatile callbac
 MP_WEAK void PLACE_IN_ITCM(port_wake_main_task)(void) {
 }
 
+#if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+// Run time budgets, highest priority first, in 1/32768ths of a second.
+static const uint16_t budget[BACKGROUND_CALLBACK_PRIORITY_COUNT] = {
+    33, // audio, 1ms
+    66, // USB, 2ms
+    164, // default, 5ms
+    655, // display, 20ms
+    655, // web, 20ms
+};
+
+static background_callback_stats_t stats[BACKGROUND_CALLBACK_STATS_COUNT];
+
+static uint32_t PLACE_IN_ITCM(stats_now)(void) {
+    uint8_t subticks;
+    uint64_t ticks = port_get_raw_ticks(&subticks);
+    return (uint32_t)(ticks * 32 + subticks);
+}
+
+static void record_stats(background_callback_fun fun, size_t index, uint32_t queued_at, uint32_t start, uint32_t end) {
+    background_callback_stats_t *entry = NULL;
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_STATS_COUNT; i++) {
+        if (stats[i].fun == fun || stats[i].fun == NULL) {
+            entry = &stats[i];
+            break;
+        }
+    }
+    if (entry == NULL) {
+        return;
+    }
+    entry->fun = fun;
+    entry->priority = BACKGROUND_CALLBACK_PRIORITY_HIGHEST - index;
+    uint32_t run = end - start;
+    uint32_t latency = start - queued_at;
+    entry->count++;
+    entry->total_run += run;
+    entry->total_latency += latency;
+    entry->max_run = MAX(entry->max_run, run);
+    entry->max_latency = MAX(entry->max_latency, latency);
+    if (run > budget[index]) {
+        entry->overruns++;
+    }
+}
+
+size_t background_callback_get_stats(background_callback_stats_t *out, size_t len) {
+    size_t count = 0;
+    while (count < BACKGROUND_CALLBACK_STATS_COUNT && stats[count].fun != NULL) {
+        count++;
+    }
+    memcpy(out, stats, MIN(count, len) * sizeof(stats[0]));
+    return count;
+}
+
+void background_callback_reset_stats(void) {
+    memset(stats, 0, sizeof(stats));
+}
+#endif
+
 void PLACE_IN_ITCM(background_callback_add_core)(background_callback_t * cb) {
+    size_t index = queue_index(cb);
     CALLBACK_CRITICAL_BEGIN;
-    if (cb->prev || callback_head == cb) {
+    if (cb->prev || callback_head[index] == cb) {
         CALLBACK_CRITICAL_END;
         return;
     }
+    #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+    cb->queued_at = stats_now();
+    #endif
     cb->next = 0;
-    cb->prev = (background_callback_t *)callback_tail;
-    if (callback_tail) {
-        callback_tail->next = cb;
+    cb->prev = (background_callback_t *)callback_tail[index];
+    if (callback_tail[index]) {
+        callback_tail[index]->next = cb;
     }
-    if (!callback_head) {
-        callback_head = cb;
+    if (!callback_head[index]) {
+        callback_head[index] = cb;
     }
-    callback_tail = cb;
+    callback_tail[index] = cb;
     CALLBACK_CRITICAL_END;
 
     port_wake_main_task();
@@ -53,12 +122,17 @@ void PLACE_IN_ITCM(background_callback_add)(background_callback_t * cb, backgrou
 }
 
 inline bool background_callback_pending(void) {
-    return callback_head != NULL;
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        if (callback_head[i] != NULL) {
+            return true;
+        }
+    }
+    return false;
 }
 
 static int background_prevention_count;
 
-void PLACE_IN_ITCM(background_callback_run_all)() {
+void PLACE_IN_ITCM(background_callback_run_all)(void) {
     port_background_task();
     if (!background_callback_pending()) {
         return;
@@ -69,33 +143,47 @@ void PLACE_IN_ITCM(background_callback_run_all)() {
         return;
     }
     ++background_prevention_count;
-    background_callback_t *cb = (background_callback_t *)callback_head;
-    callback_head = NULL;
-    callback_tail = NULL;
-    while (cb) {
-        background_callback_t *next = cb->next;
-        cb->next = cb->prev = NULL;
-        background_callback_fun fun = cb->fun;
-        void *data = cb->data;
-        CALLBACK_CRITICAL_END;
-        // Leave the critical section in order to run the callback function
-        if (fun) {
-            fun(data);
+    // Each queue is taken just once so that a callback that adds itself again
+    // waits for the next call. Lower priority queues are taken after the higher
+    // ones have run, so they pick up what those added.
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        background_callback_t *cb = (background_callback_t *)callback_head[i];
+        callback_head[i] = NULL;
+        callback_tail[i] = NULL;
+        while (cb) {
+            background_callback_t *next = cb->next;
+            cb->next = cb->prev = NULL;
+            background_callback_fun fun = cb->fun;
+            void *data = cb->data;
+            #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+            uint32_t queued_at = cb->queued_at;
+            #endif
+            CALLBACK_CRITICAL_END;
+            // Leave the critical section in order to run the callback function
+            if (fun) {
+                #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+                uint32_t start = stats_now();
+                fun(data);
+                record_stats(fun, i, queued_at, start, stats_now());
+                #else
+                fun(data);
+                #endif
+            }
+            CALLBACK_CRITICAL_BEGIN;
+            cb = next;
         }
-        CALLBACK_CRITICAL_BEGIN;
-        cb = next;
     }
     --background_prevention_count;
     CALLBACK_CRITICAL_END;
 }
 
-void background_callback_prevent() {
+void background_callback_prevent(void) {
     CALLBACK_CRITICAL_BEGIN;
     ++background_prevention_count;
     CALLBACK_CRITICAL_END;
 }
 
-void background_callback_allow() {
+void background_callback_allow(void) {
     CALLBACK_CRITICAL_BEGIN;
     --background_prevention_count;
     CALLBACK_CRITICAL_END;
@@ -103,12 +191,11 @@ void background_callback_allow() {
 
 
 // Filter out queued callbacks if they are allocated on the heap.
-void background_callback_reset() {
+static void reset_queue(size_t index) {
     background_callback_t *new_head = NULL;
     background_callback_t **previous_next = &new_head;
     background_callback_t *new_tail = NULL;
-    CALLBACK_CRITICAL_BEGIN;
-    background_callback_t *cb = (background_callback_t *)callback_head;
+    background_callback_t *cb = (background_callback_t *)callback_head[index];
     while (cb) {
         background_callback_t *next = cb->next;
         cb->next = NULL;
@@ -129,8 +216,15 @@ void background_callback_reset() {
         }
         cb = next;
     }
-    callback_head = new_head;
-    callback_tail = new_tail;
+    callback_head[index] = new_head;
+    callback_tail[index] = new_tail;
+}
+
+void background_callback_reset(void) {
+    CALLBACK_CRITICAL_BEGIN;
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        reset_queue(i);
+    }
     background_prevention_count = 0;
     CALLBACK_CRITICAL_END;
 }
@@ -150,9 +244,11 @@ void background_callback_gc_collect(void) {
     // It's necessary to traverse the whole list here, as the callbacks
     // themselves can be in non-gc memory, and some of the cb->data
     // objects themselves might be in non-gc memory.
-    background_callback_t *cb = (background_callback_t *)callback_head;
-    while (cb) {
-        gc_collect_ptr(cb->data);
-        cb = cb->next;
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        background_callback_t *cb = (background_callback_t *)callback_head[i];
+        while (cb) {
+            gc_collect_ptr(cb->data);
+            cb = cb->next;
+        }
     }
 }
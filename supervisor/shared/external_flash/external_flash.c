@@ -12,6 +12,7 @@
 #include "supervisor/port.h"
 #include "supervisor/spi_flash_api.h"
 #include "supervisor/shared/external_flash/common_commands.h"
+#include "supervisor/shared/external_flash/sector_cache.h"
 #include "extmod/vfs.h"
 #include "extmod/vfs_fat.h"
 #include "py/misc.h"
@@ -22,7 +23,8 @@
 
 #define NO_SECTOR_LOADED 0xFFFFFFFF
 
-// The currently cached sector in the cache, ram or flash based.
+// The sector currently cached in the scratch sector of the flash. Only used
+// when there isn't enough RAM for sector_cache.
 static uint32_t current_sector;
 
 static const external_flash_device possible_devices[] = {EXTERNAL_FLASH_DEVICES};
@@ -31,15 +33,13 @@ static const external_flash_device possible_devices[] = {EXTERNAL_FLASH_DEVICES}
 static const external_flash_device *flash_device = NULL;
 
 // Track which blocks (up to 32) in the current sector currently live in the
-// cache.
+// scratch sector.
 static uint32_t dirty_mask;
 
-// Table of pointers to each cached block. Should be zero'd after allocation.
 #define BLOCKS_PER_SECTOR (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE)
-#define PAGES_PER_BLOCK (FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE)
-#define FLASH_CACHE_TABLE_NUM_ENTRIES (BLOCKS_PER_SECTOR * PAGES_PER_BLOCK)
-#define FLASH_CACHE_TABLE_SIZE (FLASH_CACHE_TABLE_NUM_ENTRIES * sizeof (uint8_t *))
-static uint8_t **flash_cache_table = NULL;
+
+// Sectors cached in RAM.
+static flash_sector_cache_t sector_cache;
 
 // Wait until both the write enable and write in progress bits have cleared.
 static bool wait_for_flash_ready(void) {
@@ -135,7 +135,7 @@ static bool page_erased(uint32_t sector_address) {
     uint8_t full_buffer[FILESYSTEM_BLOCK_SIZE];
     if (read_flash(sector_address, full_buffer, FILESYSTEM_BLOCK_SIZE)) {
         for (uint16_t i = 0; i < FILESYSTEM_BLOCK_SIZE; i++) {
-            if (short_buffer[i] != 0xff) {
+            if (full_buffer[i] != 0xff) {
                 return false;
             }
         }
@@ -180,6 +180,13 @@ static bool copy_block(uint32_t src_address, uint32_t dest_address) {
     return true;
 }
 
+static const flash_sector_cache_ops_t sector_cache_ops = {
+    .read = read_flash,
+    .program = write_flash,
+    .erase_sector = erase_sector,
+    .block_erased = page_erased,
+};
+
 #define READ_JEDEC_ID_RETRY_COUNT (100)
 
 // If this fails, flash_device will remain NULL.
@@ -279,7 +286,7 @@ void supervisor_flash_init(void) {
 
     current_sector = NO_SECTOR_LOADED;
     dirty_mask = 0;
-    flash_cache_table = NULL;
+    flash_sector_cache_init(&sector_cache, &sector_cache_ops);
 }
 
 // The size of each individual block.
@@ -329,123 +336,20 @@ static bool flush_scratch_flash(void) {
     return true;
 }
 
-// Free all entries in the partially or completely filled flash_cache_table, and then free the table itself.
-static void release_ram_cache(void) {
-    if (flash_cache_table == NULL) {
-        return;
-    }
-
-    for (size_t i = 0; i < FLASH_CACHE_TABLE_NUM_ENTRIES; i++) {
-        // Table may not be completely full. Stop at first NULL entry.
-        if (flash_cache_table[i] == NULL) {
-            break;
-        }
-        port_free(flash_cache_table[i]);
-    }
-    port_free(flash_cache_table);
-    flash_cache_table = NULL;
-}
-
-// Attempts to allocate a new set of page buffers for caching a full sector in
-// ram. Each page is allocated separately so that the GC doesn't need to provide
-// one huge block. We can free it as we write if we want to also.
-static bool allocate_ram_cache(void) {
-    flash_cache_table = port_malloc(FLASH_CACHE_TABLE_SIZE, false);
-    if (flash_cache_table == NULL) {
-        // Not enough space even for the cache table.
-        return false;
-    }
-
-    // Clear all the entries so it's easy to find the last entry.
-    memset(flash_cache_table, 0, FLASH_CACHE_TABLE_SIZE);
-
-    bool success = true;
-    for (size_t i = 0; i < BLOCKS_PER_SECTOR && success; i++) {
-        for (size_t j = 0; j < PAGES_PER_BLOCK && success; j++) {
-            uint8_t *page_cache = port_malloc(SPI_FLASH_PAGE_SIZE, false);
-            if (page_cache == NULL) {
-                success = false;
-                break;
-            }
-            flash_cache_table[i * PAGES_PER_BLOCK + j] = page_cache;
-        }
-    }
-
-    // We couldn't allocate enough so give back what we got.
-    if (!success) {
-        release_ram_cache();
-    }
-    return success;
-}
-
-// Flush the cached sector from ram onto the flash. We'll free the cache unless
-// keep_cache is true.
-static bool flush_ram_cache(bool keep_cache) {
-    if (flash_cache_table == NULL) {
-        // Nothing to flush because there is no cache.
-        return true;
-    }
-
-    if (current_sector == NO_SECTOR_LOADED) {
-        if (!keep_cache) {
-            release_ram_cache();
-        }
-        return true;
-    }
-    // First, copy out any blocks that we haven't touched from the sector
-    // we've cached. If we don't do this we'll erase the data during the sector
-    // erase below.
-    bool copy_to_ram_ok = true;
-    for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
-            for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
-                copy_to_ram_ok = read_flash(
-                    current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[i * PAGES_PER_BLOCK + j],
-                    SPI_FLASH_PAGE_SIZE);
-                if (!copy_to_ram_ok) {
-                    break;
-                }
-            }
-        }
-        if (!copy_to_ram_ok) {
-            break;
-        }
-    }
-
-    if (!copy_to_ram_ok) {
-        return false;
-    }
-    // Second, erase the current sector.
-    erase_sector(current_sector);
-    // Lastly, write all the data in ram that we've cached.
-    for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
-        for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
-            write_flash(current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                flash_cache_table[i * PAGES_PER_BLOCK + j],
-                SPI_FLASH_PAGE_SIZE);
-        }
-    }
-    // We're done with the cache for now so give it back.
-    if (!keep_cache) {
-        release_ram_cache();
-    }
-    return true;
-}
-
 // Delegates to the correct flash flush method depending on the existing cache.
 // TODO Don't blink the status indicator if we don't actually do any writing (hard to tell right now).
 static void spi_flash_flush_keep_cache(bool keep_cache) {
     #ifdef MICROPY_HW_LED_MSC
     port_pin_set_output_level(MICROPY_HW_LED_MSC, true);
     #endif
-    // If we've cached to the flash itself flush from there.
-    if (flash_cache_table == NULL) {
-        flush_scratch_flash();
+    // Only one of these has anything to flush at a time.
+    flush_scratch_flash();
+    current_sector = NO_SECTOR_LOADED;
+    if (keep_cache) {
+        flash_sector_cache_flush(&sector_cache);
     } else {
-        flush_ram_cache(keep_cache);
+        flash_sector_cache_release(&sector_cache);
     }
-    current_sector = NO_SECTOR_LOADED;
     #ifdef MICROPY_HW_LED_MSC
     port_pin_set_output_level(MICROPY_HW_LED_MSC, false);
     #endif
@@ -479,19 +383,13 @@ static bool external_flash_read_block(uint8_t *dest, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
     uint32_t mask = 1 << (block_index);
-    // We're reading from the currently cached sector.
+    // We're reading from the sector cached in the scratch sector.
     if (current_sector == this_sector && (mask & dirty_mask) > 0) {
-        if (flash_cache_table != NULL) {
-            for (int i = 0; i < PAGES_PER_BLOCK; i++) {
-                memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[block_index * PAGES_PER_BLOCK + i],
-                    SPI_FLASH_PAGE_SIZE);
-            }
-            return true;
-        } else {
-            uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
-            return read_flash(scratch_address, dest, FILESYSTEM_BLOCK_SIZE);
-        }
+        uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
+        return read_flash(scratch_address, dest, FILESYSTEM_BLOCK_SIZE);
+    }
+    if (flash_sector_cache_read_block(&sector_cache, address, dest)) {
+        return true;
     }
     return read_flash(address, dest, FILESYSTEM_BLOCK_SIZE);
 }
@@ -505,12 +403,16 @@ static bool external_flash_write_block(const uint8_t *data, uint32_t block) {
     }
     // Wait for any previous writes to finish.
     wait_for_flash_ready();
+    // Prefer caching in RAM, which can hold several sectors at once.
+    if (current_sector == NO_SECTOR_LOADED && flash_sector_cache_allocate(&sector_cache)) {
+        return flash_sector_cache_write_block(&sector_cache, address, data);
+    }
     // Mask out the lower bits that designate the address within the sector.
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
     uint32_t mask = 1 << (block_index);
-    // Flush the cache if we're moving onto a sector or we're writing the
-    // same block again.
+    // Flush the scratch sector if we're moving onto a sector or we're writing
+    // the same block again.
     if (current_sector != this_sector || (mask & dirty_mask) > 0) {
         // Check to see if we'd write to an erased page. In that case we
         // can write directly.
@@ -520,26 +422,18 @@ static bool external_flash_write_block(const uint8_t *data, uint32_t block) {
         if (current_sector != NO_SECTOR_LOADED) {
             supervisor_flash_flush();
         }
-        if (flash_cache_table == NULL && !allocate_ram_cache()) {
-            erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
-            wait_for_flash_ready();
+        // RAM may have been freed up since the scratch sector was started.
+        if (flash_sector_cache_allocate(&sector_cache)) {
+            return flash_sector_cache_write_block(&sector_cache, address, data);
         }
+        erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
+        wait_for_flash_ready();
         current_sector = this_sector;
         dirty_mask = 0;
     }
     dirty_mask |= mask;
-    // Copy the block to the appropriate cache.
-    if (flash_cache_table != NULL) {
-        for (int i = 0; i < PAGES_PER_BLOCK; i++) {
-            memcpy(flash_cache_table[block_index * PAGES_PER_BLOCK + i],
-                data + i * SPI_FLASH_PAGE_SIZE,
-                SPI_FLASH_PAGE_SIZE);
-        }
-        return true;
-    } else {
-        uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
-        return write_flash(scratch_address, data, FILESYSTEM_BLOCK_SIZE);
-    }
+    uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
+    return write_flash(scratch_address, data, FILESYSTEM_BLOCK_SIZE);
 }
 
 mp_uint_t supervisor_flash_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
@@ -20,6 +20,16 @@
 #define SPI_FLASH_SYSTICK_MASK    (0x1ff) // 512ms
 #define SPI_FLASH_IDLE_TICK(tick) (((tick) & SPI_FLASH_SYSTICK_MASK) == 2)
 
+// How many erase sectors to cache in RAM before writing them back. Each one
+// costs SPI_FLASH_ERASE_SIZE bytes, allocated as it is needed.
+#ifndef CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS
+#if CIRCUITPY_FULL_BUILD
+#define CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS (4)
+#else
+#define CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS (1)
+#endif
+#endif
+
 #ifndef SPI_FLASH_MAX_BAUDRATE
 #define SPI_FLASH_MAX_BAUDRATE 8000000
 #endif
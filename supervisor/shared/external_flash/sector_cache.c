@@ -0,0 +1,189 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "supervisor/shared/external_flash/sector_cache.h"
+#include "supervisor/port_heap.h"
+
+#define SECTOR_OF(address) ((address) & ~(SPI_FLASH_ERASE_SIZE - 1))
+#define BLOCK_INDEX_OF(address) (((address) % SPI_FLASH_ERASE_SIZE) / FILESYSTEM_BLOCK_SIZE)
+
+void flash_sector_cache_init(flash_sector_cache_t *cache, const flash_sector_cache_ops_t *ops) {
+    memset(cache, 0, sizeof(*cache));
+    cache->ops = ops;
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        cache->ways[i].sector = FLASH_SECTOR_CACHE_NO_SECTOR;
+    }
+}
+
+static void free_way(flash_sector_cache_way_t *way) {
+    for (size_t i = 0; i < FLASH_SECTOR_CACHE_PAGES_PER_SECTOR; i++) {
+        // Pages are allocated in order so stop at the first missing one.
+        if (way->pages[i] == NULL) {
+            break;
+        }
+        port_free(way->pages[i]);
+        way->pages[i] = NULL;
+    }
+    way->sector = FLASH_SECTOR_CACHE_NO_SECTOR;
+    way->dirty_mask = 0;
+}
+
+static bool allocate_way(flash_sector_cache_way_t *way) {
+    for (size_t i = 0; i < FLASH_SECTOR_CACHE_PAGES_PER_SECTOR; i++) {
+        way->pages[i] = port_malloc(SPI_FLASH_PAGE_SIZE, false);
+        if (way->pages[i] == NULL) {
+            // We couldn't allocate enough so give back what we got.
+            free_way(way);
+            return false;
+        }
+    }
+    return true;
+}
+
+static inline bool way_allocated(const flash_sector_cache_way_t *way) {
+    return way->pages[0] != NULL;
+}
+
+static flash_sector_cache_way_t *find_way(flash_sector_cache_t *cache, uint32_t sector) {
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        if (cache->ways[i].sector == sector) {
+            return &cache->ways[i];
+        }
+    }
+    return NULL;
+}
+
+// Read the blocks we haven't written from the flash, erase the sector once
+// and program the whole thing back. If that fails the way keeps the sector,
+// with every block now in RAM, so that a later flush can try again.
+static bool flush_way(flash_sector_cache_t *cache, flash_sector_cache_way_t *way) {
+    if (way->sector == FLASH_SECTOR_CACHE_NO_SECTOR) {
+        return true;
+    }
+    const flash_sector_cache_ops_t *ops = cache->ops;
+    for (size_t i = 0; i < FLASH_SECTOR_CACHE_BLOCKS_PER_SECTOR; i++) {
+        if ((way->dirty_mask & (1 << i)) != 0) {
+            continue;
+        }
+        for (size_t j = 0; j < FLASH_SECTOR_CACHE_PAGES_PER_BLOCK; j++) {
+            size_t page = i * FLASH_SECTOR_CACHE_PAGES_PER_BLOCK + j;
+            if (!ops->read(way->sector + page * SPI_FLASH_PAGE_SIZE, way->pages[page], SPI_FLASH_PAGE_SIZE)) {
+                // Don't erase the sector if we couldn't save what's in it.
+                return false;
+            }
+        }
+        way->dirty_mask |= 1 << i;
+    }
+    if (!ops->erase_sector(way->sector)) {
+        return false;
+    }
+    bool ok = true;
+    for (size_t page = 0; page < FLASH_SECTOR_CACHE_PAGES_PER_SECTOR; page++) {
+        ok = ops->program(way->sector + page * SPI_FLASH_PAGE_SIZE, way->pages[page], SPI_FLASH_PAGE_SIZE) && ok;
+    }
+    if (!ok) {
+        return false;
+    }
+    way->sector = FLASH_SECTOR_CACHE_NO_SECTOR;
+    way->dirty_mask = 0;
+    return true;
+}
+
+// Pick a way for a newly cached sector: an empty allocated way, then a newly
+// allocated way, then the least recently used way, which is written back.
+// Returns NULL if there is no way or the least recently used one can't be
+// written back.
+static flash_sector_cache_way_t *claim_way(flash_sector_cache_t *cache) {
+    flash_sector_cache_way_t *unallocated = NULL;
+    flash_sector_cache_way_t *lru = NULL;
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        flash_sector_cache_way_t *way = &cache->ways[i];
+        if (!way_allocated(way)) {
+            if (unallocated == NULL) {
+                unallocated = way;
+            }
+        } else if (way->sector == FLASH_SECTOR_CACHE_NO_SECTOR) {
+            return way;
+        } else if (lru == NULL || way->last_used < lru->last_used) {
+            lru = way;
+        }
+    }
+    if (unallocated != NULL && allocate_way(unallocated)) {
+        return unallocated;
+    }
+    if (lru == NULL || !flush_way(cache, lru)) {
+        return NULL;
+    }
+    return lru;
+}
+
+bool flash_sector_cache_allocate(flash_sector_cache_t *cache) {
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        if (way_allocated(&cache->ways[i])) {
+            return true;
+        }
+    }
+    return allocate_way(&cache->ways[0]);
+}
+
+bool flash_sector_cache_read_block(flash_sector_cache_t *cache, uint32_t address, uint8_t *dest) {
+    flash_sector_cache_way_t *way = find_way(cache, SECTOR_OF(address));
+    size_t block_index = BLOCK_INDEX_OF(address);
+    if (way == NULL || (way->dirty_mask & (1 << block_index)) == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < FLASH_SECTOR_CACHE_PAGES_PER_BLOCK; i++) {
+        memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
+            way->pages[block_index * FLASH_SECTOR_CACHE_PAGES_PER_BLOCK + i],
+            SPI_FLASH_PAGE_SIZE);
+    }
+    return true;
+}
+
+bool flash_sector_cache_write_block(flash_sector_cache_t *cache, uint32_t address, const uint8_t *data) {
+    uint32_t sector = SECTOR_OF(address);
+    size_t block_index = BLOCK_INDEX_OF(address);
+    flash_sector_cache_way_t *way = find_way(cache, sector);
+    if (way == NULL) {
+        // Writing to an erased block of an uncached sector doesn't need an
+        // erase, so skip the cache.
+        if (cache->ops->block_erased(address)) {
+            return cache->ops->program(address, data, FILESYSTEM_BLOCK_SIZE);
+        }
+        way = claim_way(cache);
+        if (way == NULL) {
+            return false;
+        }
+        way->sector = sector;
+        way->dirty_mask = 0;
+    }
+    way->dirty_mask |= 1 << block_index;
+    way->last_used = ++cache->use_count;
+    for (size_t i = 0; i < FLASH_SECTOR_CACHE_PAGES_PER_BLOCK; i++) {
+        memcpy(way->pages[block_index * FLASH_SECTOR_CACHE_PAGES_PER_BLOCK + i],
+            data + i * SPI_FLASH_PAGE_SIZE,
+            SPI_FLASH_PAGE_SIZE);
+    }
+    return true;
+}
+
+bool flash_sector_cache_flush(flash_sector_cache_t *cache) {
+    bool ok = true;
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        ok = flush_way(cache, &cache->ways[i]) && ok;
+    }
+    return ok;
+}
+
+bool flash_sector_cache_release(flash_sector_cache_t *cache) {
+    bool ok = flash_sector_cache_flush(cache);
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        free_way(&cache->ways[i]);
+    }
+    return ok;
+}
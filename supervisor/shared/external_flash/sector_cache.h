@@ -0,0 +1,68 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "supervisor/shared/external_flash/external_flash.h"
+
+// A write-back cache of whole erase sectors of NOR flash, held in RAM. Blocks
+// written to a cached sector only reach the flash when the sector is evicted
+// (least recently used first) or flushed, so repeated writes to the same few
+// sectors, such as FAT updates interleaved with data clusters, cost one erase
+// each instead of one per write.
+
+#define FLASH_SECTOR_CACHE_NO_SECTOR 0xFFFFFFFF
+#define FLASH_SECTOR_CACHE_BLOCKS_PER_SECTOR (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE)
+#define FLASH_SECTOR_CACHE_PAGES_PER_BLOCK (FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE)
+#define FLASH_SECTOR_CACHE_PAGES_PER_SECTOR (SPI_FLASH_ERASE_SIZE / SPI_FLASH_PAGE_SIZE)
+
+// Access to the underlying flash. Addresses are byte offsets into the flash.
+typedef struct {
+    bool (*read)(uint32_t address, uint8_t *data, uint32_t data_length);
+    // Program an already erased region.
+    bool (*program)(uint32_t address, const uint8_t *data, uint32_t data_length);
+    bool (*erase_sector)(uint32_t sector_address);
+    // True if the block at address can be programmed without an erase.
+    bool (*block_erased)(uint32_t address);
+} flash_sector_cache_ops_t;
+
+typedef struct {
+    uint32_t sector;
+    // One bit per block of the sector that has been written into pages.
+    uint32_t dirty_mask;
+    uint32_t last_used;
+    // Each page is allocated separately so the heap doesn't need to provide
+    // one large block. NULL if this way isn't allocated.
+    uint8_t *pages[FLASH_SECTOR_CACHE_PAGES_PER_SECTOR];
+} flash_sector_cache_way_t;
+
+typedef struct {
+    const flash_sector_cache_ops_t *ops;
+    uint32_t use_count;
+    flash_sector_cache_way_t ways[CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS];
+} flash_sector_cache_t;
+
+void flash_sector_cache_init(flash_sector_cache_t *cache, const flash_sector_cache_ops_t *ops);
+
+// Make sure at least one sector can be cached. Returns false if there isn't
+// enough RAM, in which case the cache can't be written to.
+bool flash_sector_cache_allocate(flash_sector_cache_t *cache);
+
+// Copies the block at address into dest and returns true if it is cached.
+// Otherwise the caller must read it from the flash.
+bool flash_sector_cache_read_block(flash_sector_cache_t *cache, uint32_t address, uint8_t *dest);
+
+// Must only be called after flash_sector_cache_allocate() has succeeded.
+bool flash_sector_cache_write_block(flash_sector_cache_t *cache, uint32_t address, const uint8_t *data);
+
+// Write all dirty sectors back to the flash, keeping the RAM for reuse.
+bool flash_sector_cache_flush(flash_sector_cache_t *cache);
+
+// Flush and then free all RAM.
+bool flash_sector_cache_release(flash_sector_cache_t *cache);
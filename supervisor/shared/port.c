@@ -26,6 +26,13 @@ MP_WEAK void port_yield(void) {
 MP_WEAK void port_boot_info(void) {
 }
 
+MP_WEAK bool port_keypad_timer_start(uint32_t interval_us) {
+    return false;
+}
+
+MP_WEAK void port_keypad_timer_stop(void) {
+}
+
 MP_WEAK void port_heap_init(void) {
     uint32_t *heap_bottom = port_heap_get_bottom();
     uint32_t *heap_top = port_heap_get_top();
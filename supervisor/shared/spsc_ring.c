@@ -0,0 +1,48 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "supervisor/shared/spsc_ring.h"
+
+uint32_t spsc_ring_write(spsc_ring_t *ring, const void *data, uint32_t len) {
+    const uint8_t *in = data;
+    uint32_t written = 0;
+    // At most two spans: up to the end of the storage and then from the start.
+    for (int i = 0; i < 2 && written < len; i++) {
+        uint8_t *span;
+        uint32_t count = spsc_ring_write_span(ring, &span);
+        if (count == 0) {
+            break;
+        }
+        if (count > len - written) {
+            count = len - written;
+        }
+        memcpy(span, in + written, count);
+        spsc_ring_commit_write(ring, count);
+        written += count;
+    }
+    return written;
+}
+
+uint32_t spsc_ring_read(spsc_ring_t *ring, void *data, uint32_t len) {
+    uint8_t *out = data;
+    uint32_t read = 0;
+    for (int i = 0; i < 2 && read < len; i++) {
+        const uint8_t *span;
+        uint32_t count = spsc_ring_read_span(ring, &span);
+        if (count == 0) {
+            break;
+        }
+        if (count > len - read) {
+            count = len - read;
+        }
+        memcpy(out + read, span, count);
+        spsc_ring_commit_read(ring, count);
+        read += count;
+    }
+    return read;
+}
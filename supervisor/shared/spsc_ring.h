@@ -0,0 +1,118 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2025 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Single-producer, single-consumer byte ring that needs no locks.
+ *
+ * One side (typically a background callback) may only call the producer
+ * functions and the other side (typically an interrupt handler) may only call
+ * the consumer functions. Each index is only ever written by its owner, so
+ * neither side needs to disable interrupts.
+ *
+ * The capacity must be a power of two. The indices run freely and wrap at
+ * 2**32, which lets the ring hold exactly `capacity` bytes.
+ *
+ * The span functions give direct access to the storage so data can be
+ * rendered into or played out of the ring without an extra copy. A span
+ * never crosses the end of the storage, so a second call may be needed after
+ * committing the first.
+ */
+typedef struct {
+    uint8_t *buf;
+    uint32_t mask;
+    uint32_t write_index; // Only written by the producer.
+    uint32_t read_index; // Only written by the consumer.
+} spsc_ring_t;
+
+/**
+ * Sets up the ring to use the given storage. Returns false if capacity isn't
+ * a non-zero power of two.
+ */
+static inline bool spsc_ring_init(spsc_ring_t *ring, uint8_t *buf, uint32_t capacity) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return false;
+    }
+    ring->buf = buf;
+    ring->mask = capacity - 1;
+    ring->write_index = 0;
+    ring->read_index = 0;
+    return true;
+}
+
+static inline uint32_t spsc_ring_capacity(const spsc_ring_t *ring) {
+    return ring->mask + 1;
+}
+
+// The producer publishes data with a release store and the consumer observes
+// it with an acquire load (and vice versa for freed space) so that the data
+// accesses can't be reordered around the index updates.
+
+/** Number of bytes the consumer may read. Safe to call from either side. */
+static inline uint32_t spsc_ring_num_filled(const spsc_ring_t *ring) {
+    uint32_t write_index = __atomic_load_n(&ring->write_index, __ATOMIC_ACQUIRE);
+    uint32_t read_index = __atomic_load_n(&ring->read_index, __ATOMIC_ACQUIRE);
+    return write_index - read_index;
+}
+
+/** Number of bytes the producer may write. Safe to call from either side. */
+static inline uint32_t spsc_ring_num_empty(const spsc_ring_t *ring) {
+    return spsc_ring_capacity(ring) - spsc_ring_num_filled(ring);
+}
+
+/**
+ * Producer: sets `*span` to the next free storage and returns how many
+ * contiguous bytes may be written there.
+ */
+static inline uint32_t spsc_ring_write_span(spsc_ring_t *ring, uint8_t **span) {
+    uint32_t write_index = ring->write_index;
+    uint32_t read_index = __atomic_load_n(&ring->read_index, __ATOMIC_ACQUIRE);
+    uint32_t offset = write_index & ring->mask;
+    uint32_t empty = spsc_ring_capacity(ring) - (write_index - read_index);
+    uint32_t to_end = spsc_ring_capacity(ring) - offset;
+    *span = ring->buf + offset;
+    return empty < to_end ? empty : to_end;
+}
+
+/** Producer: makes `count` bytes written into the span visible to the consumer. */
+static inline void spsc_ring_commit_write(spsc_ring_t *ring, uint32_t count) {
+    __atomic_store_n(&ring->write_index, ring->write_index + count, __ATOMIC_RELEASE);
+}
+
+/**
+ * Consumer: sets `*span` to the oldest data and returns how many contiguous
+ * bytes may be read there.
+ */
+static inline uint32_t spsc_ring_read_span(spsc_ring_t *ring, const uint8_t **span) {
+    uint32_t read_index = ring->read_index;
+    uint32_t write_index = __atomic_load_n(&ring->write_index, __ATOMIC_ACQUIRE);
+    uint32_t offset = read_index & ring->mask;
+    uint32_t filled = write_index - read_index;
+    uint32_t to_end = spsc_ring_capacity(ring) - offset;
+    *span = ring->buf + offset;
+    return filled < to_end ? filled : to_end;
+}
+
+/** Consumer: hands `count` bytes of the span back to the producer. */
+static inline void spsc_ring_commit_read(spsc_ring_t *ring, uint32_t count) {
+    __atomic_store_n(&ring->read_index, ring->read_index + count, __ATOMIC_RELEASE);
+}
+
+/** Consumer: drops everything currently in the ring. */
+static inline void spsc_ring_clear(spsc_ring_t *ring) {
+    __atomic_store_n(&ring->read_index, __atomic_load_n(&ring->write_index, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+}
+
+/** Producer: copies up to `len` bytes in and returns how many fit. */
+uint32_t spsc_ring_write(spsc_ring_t *ring, const void *data, uint32_t len);
+
+/** Consumer: copies up to `len` bytes out and returns how many were available. */
+uint32_t spsc_ring_read(spsc_ring_t *ring, void *data, uint32_t len);
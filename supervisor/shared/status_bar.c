@@ -29,7 +29,7 @@
 #include "supervisor/usb.h"
 #endif
 
-static background_callback_t status_bar_background_cb;
+static background_callback_t status_bar_background_cb = { .priority = BACKGROUND_CALLBACK_PRIORITY_DISPLAY };
 
 static bool _forced_dirty = false;
 static bool _suspended = false;
@@ -8,6 +8,7 @@
 
 #include "shared/runtime/interrupt_char.h"
 #include "py/mphal.h"
+#include "py/gc.h"
 #include "py/mpstate.h"
 #include "py/runtime.h"
 #include "supervisor/filesystem.h"
@@ -38,7 +39,7 @@
 
 static volatile uint64_t PLACE_IN_DTCM_BSS(background_ticks);
 
-static background_callback_t tick_callback;
+static background_callback_t tick_callback = { .priority = BACKGROUND_CALLBACK_PRIORITY_DISPLAY };
 
 static volatile uint64_t last_finished_tick = 0;
 
@@ -59,6 +60,10 @@ static void supervisor_background_tick(void *unused) {
 
     filesystem_background();
 
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_collect_step();
+    #endif
+
     port_background_tick();
 
     assert_heap_ok();
@@ -96,6 +101,16 @@ uint32_t supervisor_ticks_ms32() {
     return supervisor_ticks_ms64();
 }
 
+#ifndef mp_hal_ticks_us
+// Only as fine as a subtick, about 30 microseconds.
+mp_uint_t mp_hal_ticks_us(void) {
+    uint8_t subticks;
+    uint64_t result = port_get_raw_ticks(&subticks);
+    result = (result * 32 + subticks) * 1000000 / 32768;
+    return result;
+}
+#endif
+
 void mp_hal_delay_ms(mp_uint_t delay_ms) {
     uint64_t start_tick = port_get_raw_ticks(NULL);
     // Adjust the delay to ticks vs ms.
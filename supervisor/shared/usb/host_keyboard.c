@@ -143,7 +143,7 @@ static size_t buf_size = 0;
 enum { initial_repeat_time = 500, default_repeat_time = 50 };
 static uint64_t repeat_deadline;
 static void repeat_f(void *unused);
-background_callback_t repeat_cb = {repeat_f, NULL, NULL, NULL};
+background_callback_t repeat_cb = {repeat_f, NULL, NULL, NULL, BACKGROUND_CALLBACK_PRIORITY_USB};
 
 static void set_repeat_deadline(uint64_t new_deadline) {
     repeat_deadline = new_deadline;
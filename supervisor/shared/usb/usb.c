@@ -207,7 +207,7 @@ uint32_t tusb_time_millis_api(void) {
     return supervisor_ticks_ms32();
 }
 
-static background_callback_t usb_callback;
+static background_callback_t usb_callback = { .priority = BACKGROUND_CALLBACK_PRIORITY_USB };
 static void usb_background_do(void *unused) {
     usb_background();
 }
@@ -21,7 +21,10 @@
 #include "supervisor/fatfs.h"
 #include "supervisor/filesystem.h"
 #include "supervisor/port.h"
+#include "supervisor/port_heap.h"
+#include "supervisor/workflow.h"
 #include "supervisor/shared/reload.h"
+#include "supervisor/shared/tick.h"
 #include "supervisor/shared/web_workflow/web_workflow.h"
 #include "supervisor/shared/web_workflow/websocket.h"
 #include "supervisor/shared/workflow.h"
@@ -56,7 +59,10 @@ enum request_state {
     STATE_VERSION,
     STATE_HEADER_KEY,
     STATE_HEADER_VALUE,
-    STATE_BODY
+    STATE_BODY,
+    // The reply streams a file over more than one background tick.
+    STATE_SEND_FILE,
+    STATE_RECEIVE_FILE
 };
 
 typedef struct {
@@ -68,6 +74,8 @@ typedef struct {
     char header_value[256];
     char origin[64];        // We store the origin so we can reply back with it.
     char host[64];          // We store the host to check against origin.
+    char range[32];         // Parsed once the file size is known.
+    char if_none_match[32];
     size_t content_length;
     size_t offset;
     uint64_t timestamp_ms;
@@ -78,12 +86,61 @@ typedef struct {
     bool expect;
     bool json;
     bool websocket;
-    bool new_socket;
+    bool keep_alive;
+    bool body_read;
     uint32_t websocket_version;
     // RFC6455 for websockets says this header should be 24 base64 characters long.
     char websocket_key[24 + 1];
 } _request;
 
+// File transfers move whole sectors at a time whenever they can so that FATFS
+// reads and writes them directly to and from the transfer buffer instead of
+// going through its one sector window.
+#ifndef CIRCUITPY_WEB_WORKFLOW_TRANSFER_BUFFER_SIZE
+#define CIRCUITPY_WEB_WORKFLOW_TRANSFER_BUFFER_SIZE (8 * 1024)
+#endif
+
+#if CIRCUITPY_WEB_WORKFLOW_TRANSFER_BUFFER_SIZE % (2 * FF_MAX_SS) != 0
+#error "CIRCUITPY_WEB_WORKFLOW_TRANSFER_BUFFER_SIZE must be a multiple of two sectors"
+#endif
+
+// Used when the port heap can't spare a transfer buffer.
+#define TRANSFER_FALLBACK_SIZE (256)
+
+// A file being streamed in or out by one connection.
+typedef struct {
+    FIL file;
+    fs_user_mount_t *fs_mount;
+    uint8_t *buffer;
+    size_t buffer_len;
+    size_t filled[2];       // Bytes waiting in each half of the buffer when sending.
+    size_t sending;         // Half of the buffer being sent.
+    size_t offset;          // Bytes sent from the current half, or buffered when receiving.
+    uint32_t remaining;     // Bytes still to read from the file or the socket.
+    DWORD fattime;
+    bool new_file;
+    uint8_t fallback[TRANSFER_FALLBACK_SIZE];
+} _transfer;
+
+typedef struct {
+    socketpool_socket_obj_t socket;
+    _request request;
+    _transfer transfer;
+    uint64_t last_request_ms;
+} _connection;
+
+// Each client gets its own connection so that a slow browser tab or a
+// stalled upload doesn't hold up everyone else.
+#ifndef CIRCUITPY_WEB_WORKFLOW_CONNECTIONS
+#define CIRCUITPY_WEB_WORKFLOW_CONNECTIONS (3)
+#endif
+
+// Bytes a connection may move in one background tick before the next one gets
+// a turn.
+#ifndef CIRCUITPY_WEB_WORKFLOW_TICK_BUDGET
+#define CIRCUITPY_WEB_WORKFLOW_TICK_BUDGET (CIRCUITPY_WEB_WORKFLOW_TRANSFER_BUFFER_SIZE)
+#endif
+
 static wifi_radio_error_t _wifi_status = WIFI_RADIO_ERROR_NONE;
 
 #if CIRCUITPY_STATUS_BAR
@@ -101,9 +158,14 @@ static mp_int_t web_api_port = 80;
 
 static socketpool_socketpool_obj_t pool;
 static socketpool_socket_obj_t listening;
-static socketpool_socket_obj_t active;
+// Holds a new client while an idle connection is closed to make room for it.
+static socketpool_socket_obj_t incoming;
 
-static _request active_request;
+static _connection connections[CIRCUITPY_WEB_WORKFLOW_CONNECTIONS];
+// Connection to process first in the next background tick.
+static size_t next_connection = 0;
+// Set when a reply needs an autoreload that has to wait for other requests.
+static bool _reload_pending = false;
 
 static char _api_password[64];
 static char web_instance_name[50];
@@ -236,6 +298,8 @@ void supervisor_web_workflow_status(void) {
 }
 #endif
 
+static void _close_connection(_connection *connection);
+
 bool supervisor_start_web_workflow(void) {
     #if CIRCUITPY_WEB_WORKFLOW && CIRCUITPY_WIFI && CIRCUITPY_OS_GETENV
 
@@ -310,7 +374,10 @@ bool supervisor_start_web_workflow(void) {
         common_hal_socketpool_socketpool_construct(&pool, &common_hal_wifi_radio_obj);
 
         socketpool_socket_reset(&listening);
-        socketpool_socket_reset(&active);
+        socketpool_socket_reset(&incoming);
+        for (size_t i = 0; i < CIRCUITPY_WEB_WORKFLOW_CONNECTIONS; i++) {
+            socketpool_socket_reset(&connections[i].socket);
+        }
 
         websocket_init();
     }
@@ -318,9 +385,11 @@ bool supervisor_start_web_workflow(void) {
     initialized = pool.base.type == &socketpool_socketpool_type;
 
     if (initialized) {
-        if (!common_hal_socketpool_socket_get_closed(&active)) {
-            common_hal_socketpool_socket_close(&active);
+        for (size_t i = 0; i < CIRCUITPY_WEB_WORKFLOW_CONNECTIONS; i++) {
+            _close_connection(&connections[i]);
         }
+        // The new VM run picks up any changes anyway.
+        _reload_pending = false;
 
         #if CIRCUITPY_MDNS
         // Try to start MDNS if the user deinited it.
@@ -346,7 +415,7 @@ bool supervisor_start_web_workflow(void) {
             common_hal_socketpool_socket_settimeout(&listening, 0);
             // Bind to any ip. (Not checking for failures)
             common_hal_socketpool_socket_bind(&listening, "", 0, web_api_port);
-            common_hal_socketpool_socket_listen(&listening, 1);
+            common_hal_socketpool_socket_listen(&listening, CIRCUITPY_WEB_WORKFLOW_CONNECTIONS);
         }
         // Wake polling thread (maybe)
         socketpool_socket_poll_resume();
@@ -544,7 +613,7 @@ static void _reply_access_control(socketpool_socket_obj_t *socket, _request *req
         "HTTP/1.1 204 No Content\r\n",
         "Content-Length: 0\r\n",
         "Access-Control-Expose-Headers: Access-Control-Allow-Methods\r\n",
-        "Access-Control-Allow-Headers: X-Timestamp, X-Destination, Content-Type, Authorization\r\n",
+        "Access-Control-Allow-Headers: X-Timestamp, X-Destination, Content-Type, Authorization, Range, If-None-Match\r\n",
         "Access-Control-Allow-Methods:GET, OPTIONS, PUT, DELETE, MOVE", NULL);
     _send_str(socket, "\r\n");
     _cors_header(socket, request);
@@ -627,6 +696,7 @@ static void _reply_server_error(socketpool_socket_obj_t *socket, _request *reque
 
 #if CIRCUITPY_MDNS
 static void _reply_redirect(socketpool_socket_obj_t *socket, _request *request, const char *path) {
+    request->keep_alive = false;
     int nodelay = 1;
     common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
     const char *hostname = common_hal_mdns_server_get_hostname(&mdns);
@@ -736,12 +806,160 @@ static void _reply_directory_json(socketpool_socket_obj_t *socket, _request *req
     _send_chunk(socket, "");
 }
 
-static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request, const char *filename, FIL *active_file) {
-    uint32_t total_length = f_size(active_file);
+static void _transfer_begin(_transfer *transfer, fs_user_mount_t *fs_mount, uint32_t length) {
+    transfer->fs_mount = fs_mount;
+    transfer->buffer = port_malloc(CIRCUITPY_WEB_WORKFLOW_TRANSFER_BUFFER_SIZE, false);
+    transfer->buffer_len = CIRCUITPY_WEB_WORKFLOW_TRANSFER_BUFFER_SIZE;
+    if (transfer->buffer == NULL) {
+        transfer->buffer = transfer->fallback;
+        transfer->buffer_len = sizeof(transfer->fallback);
+    }
+    transfer->filled[0] = 0;
+    transfer->filled[1] = 0;
+    transfer->sending = 0;
+    transfer->offset = 0;
+    transfer->remaining = length;
+}
+
+static void _transfer_end(_transfer *transfer) {
+    if (transfer->buffer != transfer->fallback) {
+        port_free(transfer->buffer);
+    }
+    transfer->buffer = NULL;
+}
+
+// Transfers outlive the background tick they start in so the file system
+// they use may have been unmounted in the meantime.
+static bool _transfer_mounted(_transfer *transfer) {
+    if (transfer->fs_mount == filesystem_circuitpy()) {
+        return true;
+    }
+    for (mp_vfs_mount_t *vfs = MP_STATE_VM(vfs_mount_table); vfs != NULL; vfs = vfs->next) {
+        if (MP_OBJ_TO_PTR(vfs->obj) == transfer->fs_mount) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static size_t _sector_size(FIL *file) {
+    #if FF_MAX_SS != FF_MIN_SS
+    return file->obj.fs->ssize;
+    #else
+    (void)file;
+    return FF_MAX_SS;
+    #endif
+}
+
+// Handles a single `bytes=first-last`, `bytes=first-` or `bytes=-suffix` range.
+// Returns false when the whole file should be sent instead, which is also what
+// is done for multiple ranges. Sets `satisfiable` to false when the range
+// doesn't overlap the file at all.
+static bool _parse_range(const char *range, uint32_t size, uint32_t *first, uint32_t *last, bool *satisfiable) {
+    const char *prefix = "bytes=";
+    if (strncmp(range, prefix, strlen(prefix)) != 0 || strchr(range, ',') != NULL) {
+        return false;
+    }
+    const char *p = range + strlen(prefix);
+    char *end;
+    *satisfiable = true;
+    if (*p == '-') {
+        p++;
+        if (!unichar_isdigit(*p)) {
+            return false;
+        }
+        uint32_t suffix = strtoul(p, &end, 10);
+        if (*end != '\0') {
+            return false;
+        }
+        if (suffix == 0 || size == 0) {
+            *satisfiable = false;
+            return true;
+        }
+        *first = suffix < size ? size - suffix : 0;
+        *last = size - 1;
+        return true;
+    }
+    if (!unichar_isdigit(*p)) {
+        return false;
+    }
+    *first = strtoul(p, &end, 10);
+    if (*end != '-') {
+        return false;
+    }
+    p = end + 1;
+    *last = UINT32_MAX;
+    if (*p != '\0') {
+        if (!unichar_isdigit(*p)) {
+            return false;
+        }
+        *last = strtoul(p, &end, 10);
+        if (*end != '\0' || *last < *first) {
+            return false;
+        }
+    }
+    if (*first >= size) {
+        *satisfiable = false;
+        return true;
+    }
+    *last = MIN(*last, size - 1);
+    return true;
+}
+
+static void _reply_not_modified(socketpool_socket_obj_t *socket, _request *request, const char *etag) {
+    _send_strs(socket,
+        "HTTP/1.1 304 Not Modified\r\n",
+        "ETag: ", etag, "\r\n", NULL);
+    _cors_header(socket, request);
+    _send_final_str(socket, "\r\n");
+}
+
+static void _reply_range_not_satisfiable(socketpool_socket_obj_t *socket, _request *request, uint32_t size) {
+    _send_strs(socket,
+        "HTTP/1.1 416 Range Not Satisfiable\r\n",
+        "Content-Length: 0\r\n", NULL);
+    mp_print_t _socket_print = {socket, _print_raw};
+    mp_printf(&_socket_print, "Content-Range: bytes */%u\r\n", (uint)size);
+    _cors_header(socket, request);
+    _send_final_str(socket, "\r\n");
+}
+
+// Sends the headers and starts streaming the already open transfer file. The
+// file is closed by the caller unless the state moves on to STATE_SEND_FILE.
+static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request, const char *filename, FILINFO *file_info, fs_user_mount_t *fs_mount, _transfer *transfer) {
+    uint32_t total_length = f_size(&transfer->file);
+
+    // The size and modification time are enough to tell versions of a file apart.
+    char etag[24];
+    snprintf(etag, sizeof(etag), "\"%lx-%x%04x\"", (unsigned long)total_length, file_info->fdate, file_info->ftime);
+    if (request->if_none_match[0] != '\0' &&
+        (strcmp(request->if_none_match, "*") == 0 || strstr(request->if_none_match, etag) != NULL)) {
+        _reply_not_modified(socket, request, etag);
+        return;
+    }
+
+    uint32_t first = 0;
+    uint32_t last = total_length - 1;
+    bool satisfiable = true;
+    bool partial = request->range[0] != '\0' &&
+        _parse_range(request->range, total_length, &first, &last, &satisfiable);
+    if (!satisfiable) {
+        _reply_range_not_satisfiable(socket, request, total_length);
+        return;
+    }
+    uint32_t content_length = partial ? last - first + 1 : total_length;
 
-    _send_str(socket, "HTTP/1.1 200 OK\r\n");
     mp_print_t _socket_print = {socket, _print_raw};
-    mp_printf(&_socket_print, "Content-Length: %d\r\n", total_length);
+    if (partial) {
+        _send_str(socket, "HTTP/1.1 206 Partial Content\r\n");
+        mp_printf(&_socket_print, "Content-Range: bytes %u-%u/%u\r\n", (uint)first, (uint)last, (uint)total_length);
+    } else {
+        _send_str(socket, "HTTP/1.1 200 OK\r\n");
+    }
+    mp_printf(&_socket_print, "Content-Length: %u\r\n", (uint)content_length);
+    _send_strs(socket,
+        "Accept-Ranges: bytes\r\n",
+        "ETag: ", etag, "\r\n", NULL);
     // TODO: Make this a table to save space.
     if (_endswith(filename, ".txt") || _endswith(filename, ".py") || _endswith(filename, ".toml")) {
         _send_strs(socket, "Content-Type:", "text/plain", ";charset=UTF-8\r\n", NULL);
@@ -757,42 +975,19 @@ static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request,
     _cors_header(socket, request);
     _send_str(socket, "\r\n");
 
-    uint32_t total_read = 0;
-    int nodelay_ok = -1;
-    while (total_read < total_length) {
-        uint8_t data_buffer[64];
-        size_t quantity_read;
-        f_read(active_file, data_buffer, 64, &quantity_read);
-        total_read += quantity_read;
-        // When getting near the end of the file, disable Nagle's combining algorithm so that
-        // data is sent immediately.
-        if (total_length - total_read < 64) {
-            int nodelay = 1;
-            // Returns 0 when it works.
-            nodelay_ok = common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
-        }
-        uint32_t send_offset = 0;
-        while (send_offset < quantity_read) {
-            int sent = socketpool_socket_send(socket, data_buffer + send_offset, quantity_read - send_offset);
-            if (sent < 0) {
-                if (sent == -MP_EAGAIN) {
-                    sent = 0;
-                } else {
-                    break;
-                }
-            }
-            send_offset += sent;
-        }
-    }
-    if (total_read < total_length) {
+    if (partial && f_lseek(&transfer->file, first) != FR_OK) {
         socketpool_socket_close(socket);
+        return;
     }
 
-    // Re-enable Nagle's algorithm when done sending.
-    if (nodelay_ok == 0) {
-        int nodelay = 0;
-        nodelay_ok = common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
-    }
+    // The data is sent in large pieces so Nagle's algorithm only ever holds
+    // back the final segment. Disable it for the whole body instead of
+    // toggling it per piece. _send_file_step re-enables it at the end.
+    int nodelay = 1;
+    common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+    _transfer_begin(transfer, fs_mount, content_length);
+    request->state = STATE_SEND_FILE;
 }
 
 static void _reply_with_devices_json(socketpool_socket_obj_t *socket, _request *request) {
@@ -956,35 +1151,39 @@ static void _discard_incoming(socketpool_socket_obj_t *socket, size_t amount) {
     }
 }
 
-static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *request, fs_user_mount_t *fs_mount, const TCHAR *path) {
-    FIL active_file;
+// Opens the file for writing and moves on to STATE_RECEIVE_FILE when the body
+// can be stored. Otherwise replies with the error straight away.
+static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *request, fs_user_mount_t *fs_mount, const TCHAR *path, _transfer *transfer) {
+    FIL *active_file = &transfer->file;
 
     if (!filesystem_lock(fs_mount)) {
         _discard_incoming(socket, request->content_length);
+        request->body_read = true;
         _reply_conflict(socket, request);
         return;
     }
+    DWORD fattime = 0;
     if (request->timestamp_ms > 0) {
-        DWORD fattime;
         truncate_time(request->timestamp_ms * 1000000, &fattime);
         override_fattime(fattime);
     }
 
     FATFS *fs = &fs_mount->fatfs;
-    FRESULT result = f_open(fs, &active_file, path, FA_WRITE);
+    FRESULT result = f_open(fs, active_file, path, FA_WRITE);
     bool new_file = false;
     size_t old_length = 0;
     if (result == FR_NO_FILE) {
         new_file = true;
-        result = f_open(fs, &active_file, path, FA_WRITE | FA_OPEN_ALWAYS);
+        result = f_open(fs, active_file, path, FA_WRITE | FA_OPEN_ALWAYS);
     } else {
-        old_length = f_size(&active_file);
+        old_length = f_size(active_file);
     }
 
     if (result == FR_NO_PATH) {
         override_fattime(0);
         filesystem_unlock(fs_mount);
         _discard_incoming(socket, request->content_length);
+        request->body_read = true;
         _reply_missing(socket, request);
         return;
     }
@@ -992,19 +1191,20 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
         override_fattime(0);
         filesystem_unlock(fs_mount);
         _discard_incoming(socket, request->content_length);
+        request->body_read = true;
         _reply_server_error(socket, request);
         return;
     }
 
     // Change the file size to start.
-    f_lseek(&active_file, request->content_length);
-    if (f_tell(&active_file) < request->content_length) {
+    f_lseek(active_file, request->content_length);
+    if (f_tell(active_file) < request->content_length) {
         if (!new_file) {
             // Truncate the file back to the old length.
-            f_lseek(&active_file, old_length);
-            f_truncate(&active_file);
+            f_lseek(active_file, old_length);
+            f_truncate(active_file);
         }
-        f_close(&active_file);
+        f_close(active_file);
 
         if (new_file) {
             f_unlink(fs, path);
@@ -1016,49 +1216,22 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
             _reply_expectation_failed(socket, request);
         } else {
             _discard_incoming(socket, request->content_length);
+            request->body_read = true;
             _reply_payload_too_large(socket, request);
         }
         return;
     } else if (request->expect) {
         _reply_continue(socket, request);
     }
-    f_truncate(&active_file);
-    f_rewind(&active_file);
-
-    size_t total_read = 0;
-    bool error = false;
-    while (total_read < request->content_length && !error) {
-        uint8_t bytes[64];
-        size_t read_len = MIN(sizeof(bytes), request->content_length - total_read);
-        int len = socketpool_socket_recv_into(socket, bytes, read_len);
-        if (len < 0) {
-            if (len == -MP_EAGAIN) {
-                continue;
-            }
-            error = true;
-            break;
-        }
-        total_read += len;
-        UINT actual;
-        f_write(&active_file, bytes, len, &actual);
-        if (actual < (UINT)len) {
-            error = true;
-            break;
-        }
-    }
-
-    f_close(&active_file);
-    filesystem_unlock(fs_mount);
-
+    f_truncate(active_file);
+    f_rewind(active_file);
     override_fattime(0);
-    if (error) {
-        _discard_incoming(socket, request->content_length - total_read);
-        _reply_server_error(socket, request);
-    } else if (new_file) {
-        _reply_created(socket, request);
-    } else {
-        _reply_no_content(socket, request);
-    }
+
+    // The body is stored by _receive_file_step as it arrives.
+    _transfer_begin(transfer, fs_mount, request->content_length);
+    transfer->fattime = fattime;
+    transfer->new_file = new_file;
+    request->state = STATE_RECEIVE_FILE;
 }
 
 #define STATIC_FILE(filename) extern uint32_t filename##_length; extern uint8_t filename[]; extern const char *filename##_content_type;
@@ -1146,7 +1319,7 @@ static void _decode_percents(char *str) {
     }
 }
 
-static bool _reply(socketpool_socket_obj_t *socket, _request *request) {
+static bool _reply(socketpool_socket_obj_t *socket, _request *request, _transfer *transfer) {
     if (request->redirect) {
         #if CIRCUITPY_MDNS
         if (!common_hal_mdns_server_deinited(&mdns)) {
@@ -1300,18 +1473,22 @@ static bool _reply(socketpool_socket_obj_t *socket, _request *request) {
                 }
             } else { // Dealing with a file.
                 if (strcasecmp(request->method, "GET") == 0) {
-                    FIL active_file;
-                    FRESULT result = f_open(fs, &active_file, path, FA_READ);
+                    FILINFO file_info;
+                    FRESULT result = f_stat(fs, path, &file_info);
+                    if (result == FR_OK) {
+                        result = f_open(fs, &transfer->file, path, FA_READ);
+                    }
 
                     if (result != FR_OK) {
                         _reply_missing(socket, request);
                     } else {
-                        _reply_with_file(socket, request, path, &active_file);
+                        _reply_with_file(socket, request, path, &file_info, fs_mount, transfer);
+                        if (request->state != STATE_SEND_FILE) {
+                            f_close(&transfer->file);
+                        }
                     }
-
-                    f_close(&active_file);
                 } else if (strcasecmp(request->method, "PUT") == 0) {
-                    _write_file_and_reply(socket, request, fs_mount, path);
+                    _write_file_and_reply(socket, request, fs_mount, path, transfer);
                     return true;
                 }
             }
@@ -1388,40 +1565,239 @@ static void _reset_request(_request *request) {
     request->state = STATE_METHOD;
     request->origin[0] = '\0';
     request->host[0] = '\0';
+    request->range[0] = '\0';
+    request->if_none_match[0] = '\0';
     request->content_length = 0;
     request->offset = 0;
     request->timestamp_ms = 0;
     request->redirect = false;
     request->done = false;
     request->in_progress = false;
-    request->new_socket = false;
     request->authenticated = false;
     request->expect = false;
     request->json = false;
     request->websocket = false;
+    request->keep_alive = true;
+    request->body_read = false;
+}
+
+// Autoreload stays suspended while any connection is in the middle of a
+// request. A reload asked for in the meantime waits until they're all done.
+static void _resume_autoreload(bool reload) {
+    _reload_pending = _reload_pending || reload;
+    for (size_t i = 0; i < CIRCUITPY_WEB_WORKFLOW_CONNECTIONS; i++) {
+        if (connections[i].request.in_progress) {
+            return;
+        }
+    }
+    autoreload_resume(AUTORELOAD_SUSPEND_WEB);
+    if (_reload_pending) {
+        _reload_pending = false;
+        autoreload_trigger();
+    }
+}
+
+static void _close_connection(_connection *connection) {
+    _request *request = &connection->request;
+    _transfer *transfer = &connection->transfer;
+    if (request->state == STATE_SEND_FILE || request->state == STATE_RECEIVE_FILE) {
+        if (_transfer_mounted(transfer)) {
+            f_close(&transfer->file);
+            if (request->state == STATE_RECEIVE_FILE) {
+                filesystem_unlock(transfer->fs_mount);
+            }
+        }
+        _transfer_end(transfer);
+    }
+    bool in_progress = request->in_progress;
+    _reset_request(request);
+    if (!common_hal_socketpool_socket_get_closed(&connection->socket)) {
+        common_hal_socketpool_socket_close(&connection->socket);
+    }
+    if (in_progress) {
+        _resume_autoreload(false);
+    }
+}
+
+// Gets the connection ready for the next request. It's closed instead when the
+// client asked for that or when part of the request body is still unread.
+static void _finish_request(_connection *connection, bool reload) {
+    _request *request = &connection->request;
+    bool keep_alive = request->keep_alive &&
+        (request->content_length == 0 || request->body_read) &&
+        common_hal_socketpool_socket_get_connected(&connection->socket);
+    _reset_request(request);
+    if (!keep_alive && !common_hal_socketpool_socket_get_closed(&connection->socket)) {
+        common_hal_socketpool_socket_close(&connection->socket);
+    }
+    connection->last_request_ms = supervisor_ticks_ms64();
+    _resume_autoreload(reload);
+}
+
+// Sends up to `budget` bytes of the file. The buffer is split in two halves so
+// that the next part of the file is read while the network is still busy
+// sending the previous one. Returns true while there is more to send.
+static bool _send_file_step(_connection *connection, size_t budget) {
+    socketpool_socket_obj_t *socket = &connection->socket;
+    _transfer *transfer = &connection->transfer;
+    size_t half = transfer->buffer_len / 2;
+    bool ok = _transfer_mounted(transfer);
+    size_t sector_size = ok ? _sector_size(&transfer->file) : FF_MIN_SS;
+    size_t sent_total = 0;
+    while (ok && sent_total < budget) {
+        // Fill any free half, starting with the one to send next. Only the
+        // first read may start mid-sector (for a Range request). After it, all
+        // reads are whole sectors.
+        for (size_t i = 0; i < 2 && transfer->remaining > 0; i++) {
+            size_t h = transfer->sending ^ i;
+            if (transfer->filled[h] != 0) {
+                continue;
+            }
+            size_t read_len = half;
+            if (half >= sector_size) {
+                read_len -= f_tell(&transfer->file) % sector_size;
+            }
+            read_len = MIN(read_len, transfer->remaining);
+            UINT quantity_read;
+            if (f_read(&transfer->file, transfer->buffer + h * half, read_len, &quantity_read) != FR_OK ||
+                quantity_read == 0) {
+                ok = false;
+                break;
+            }
+            transfer->filled[h] = quantity_read;
+            transfer->remaining -= quantity_read;
+        }
+        size_t filled = transfer->filled[transfer->sending];
+        if (!ok || filled == 0) {
+            break;
+        }
+
+        const uint8_t *data = transfer->buffer + transfer->sending * half + transfer->offset;
+        int sent = socketpool_socket_send(socket, data, filled - transfer->offset);
+        if (sent == -MP_EAGAIN || sent == 0) {
+            // The network is still busy so come back next tick.
+            return true;
+        }
+        if (sent < 0) {
+            ok = false;
+            break;
+        }
+        sent_total += sent;
+        transfer->offset += sent;
+        if (transfer->offset == filled) {
+            transfer->filled[transfer->sending] = 0;
+            transfer->offset = 0;
+            transfer->sending ^= 1;
+        }
+    }
+    if (ok && (transfer->remaining > 0 || transfer->filled[transfer->sending] != 0)) {
+        return true;
+    }
+
+    if (!ok) {
+        _close_connection(connection);
+        return false;
+    }
+    f_close(&transfer->file);
+    _transfer_end(transfer);
+    // Re-enable Nagle's algorithm when done sending.
+    int nodelay = 0;
+    common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
+    _finish_request(connection, false);
+    return false;
+}
+
+// Stores up to `budget` bytes of the request body. A whole buffer is collected
+// before writing so that, writing from the start of the file, every write but
+// the last covers whole sectors. Returns true when more is ready to be read.
+static bool _receive_file_step(_connection *connection, size_t budget) {
+    socketpool_socket_obj_t *socket = &connection->socket;
+    _request *request = &connection->request;
+    _transfer *transfer = &connection->transfer;
+    if (!_transfer_mounted(transfer)) {
+        _close_connection(connection);
+        return false;
+    }
+    size_t received = 0;
+    bool error = false;
+    while (transfer->remaining > 0 && received < budget) {
+        size_t read_len = MIN(transfer->buffer_len - transfer->offset, transfer->remaining);
+        int len = socketpool_socket_recv_into(socket, transfer->buffer + transfer->offset, read_len);
+        if (len == -MP_EAGAIN || len == 0) {
+            // Wait for more data to arrive.
+            return false;
+        }
+        if (len < 0) {
+            error = true;
+            break;
+        }
+        received += len;
+        transfer->remaining -= len;
+        transfer->offset += len;
+        if (transfer->offset == transfer->buffer_len || transfer->remaining == 0) {
+            UINT actual;
+            override_fattime(transfer->fattime);
+            f_write(&transfer->file, transfer->buffer, transfer->offset, &actual);
+            override_fattime(0);
+            if (actual < (UINT)transfer->offset) {
+                error = true;
+                break;
+            }
+            transfer->offset = 0;
+        }
+    }
+    if (!error && transfer->remaining > 0) {
+        return true;
+    }
+
+    override_fattime(transfer->fattime);
+    f_close(&transfer->file);
+    override_fattime(0);
+    filesystem_unlock(transfer->fs_mount);
+    _transfer_end(transfer);
+
+    if (error) {
+        _discard_incoming(socket, transfer->remaining);
+        _reply_server_error(socket, request);
+    } else if (transfer->new_file) {
+        _reply_created(socket, request);
+    } else {
+        _reply_no_content(socket, request);
+    }
+    request->body_read = true;
+    _finish_request(connection, true);
+    return false;
 }
 
-static void _process_request(socketpool_socket_obj_t *socket, _request *request) {
+// Parses up to `budget` bytes of the request and replies once the headers are
+// complete. Returns true when the budget ran out before the request did.
+static bool _process_request(_connection *connection, size_t budget) {
+    socketpool_socket_obj_t *socket = &connection->socket;
+    _request *request = &connection->request;
     bool more = true;
     bool error = false;
+    size_t received = 0;
     uint8_t c;
     // This code assumes header lines are terminated with \r\n
     while (more && !error) {
+        if (received == budget) {
+            return true;
+        }
 
         int len = socketpool_socket_recv_into(socket, &c, 1);
         if (len != 1) {
             more = false;
             if (len == 0 || len == -MP_ENOTCONN) {
                 // Disconnect - clear 'in-progress'
-                _reset_request(request);
-                common_hal_socketpool_socket_close(socket);
+                _close_connection(connection);
+                return false;
             }
             break;
         }
+        received++;
         if (!request->in_progress) {
             autoreload_suspend(AUTORELOAD_SUSPEND_WEB);
             request->in_progress = true;
-            request->new_socket = false;
         }
         switch (request->state) {
             case STATE_METHOD: {
@@ -1518,6 +1894,16 @@ static void _process_request(socketpool_socket_obj_t *socket, _request *request)
                         strcpy(request->websocket_key, request->header_value);
                     } else if (strcasecmp(request->header_key, "X-Destination") == 0) {
                         strcpy(request->destination, request->header_value);
+                    } else if (strcasecmp(request->header_key, "Range") == 0) {
+                        // Ignore ranges that don't fit rather than serve a truncated one.
+                        if (strlen(request->header_value) < sizeof(request->range)) {
+                            strcpy(request->range, request->header_value);
+                        }
+                    } else if (strcasecmp(request->header_key, "Connection") == 0) {
+                        request->keep_alive = strcasecmp(request->header_value, "close") != 0;
+                    } else if (strcasecmp(request->header_key, "If-None-Match") == 0) {
+                        strncpy(request->if_none_match, request->header_value, sizeof(request->if_none_match) - 1);
+                        request->if_none_match[sizeof(request->if_none_match) - 1] = '\0';
                     }
                 } else if (request->offset > sizeof(request->header_value) - 1) {
                     // Skip methods that are too long.
@@ -1531,6 +1917,10 @@ static void _process_request(socketpool_socket_obj_t *socket, _request *request)
                 request->done = true;
                 more = false;
                 break;
+            case STATE_SEND_FILE:
+            case STATE_RECEIVE_FILE:
+                // Handled by _process_connection.
+                break;
         }
     }
     if (error) {
@@ -1540,17 +1930,84 @@ static void _process_request(socketpool_socket_obj_t *socket, _request *request)
         common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
         socketpool_socket_send(socket, (const uint8_t *)error_response, strlen(error_response));
         request->done = true;
+        request->keep_alive = false;
     }
     if (!request->done) {
-        return;
+        return false;
     }
-    bool reload = _reply(socket, request);
-    _reset_request(request);
-    common_hal_socketpool_socket_close(socket);
-    autoreload_resume(AUTORELOAD_SUSPEND_WEB);
-    if (reload) {
-        autoreload_trigger();
+    bool reload = _reply(socket, request, &connection->transfer);
+    if (request->state == STATE_SEND_FILE || request->state == STATE_RECEIVE_FILE) {
+        // The body is streamed over the next ticks.
+        return true;
+    }
+    _finish_request(connection, reload);
+    return false;
+}
+
+static bool _process_connection(_connection *connection) {
+    socketpool_socket_obj_t *socket = &connection->socket;
+    if (common_hal_socketpool_socket_get_closed(socket)) {
+        return false;
+    }
+    if (!common_hal_socketpool_socket_get_connected(socket)) {
+        _close_connection(connection);
+        return false;
+    }
+    switch (connection->request.state) {
+        case STATE_SEND_FILE:
+            return _send_file_step(connection, CIRCUITPY_WEB_WORKFLOW_TICK_BUDGET);
+        case STATE_RECEIVE_FILE:
+            return _receive_file_step(connection, CIRCUITPY_WEB_WORKFLOW_TICK_BUDGET);
+        default:
+            return _process_request(connection, CIRCUITPY_WEB_WORKFLOW_TICK_BUDGET);
+    }
+}
+
+// Accepts waiting clients into free connections. When there are none, the
+// connection that has been idle the longest makes room, so idle keep-alive
+// connections can't lock new clients out.
+static bool _accept_connections(void) {
+    bool accepted = false;
+    for (size_t i = 0; i < CIRCUITPY_WEB_WORKFLOW_CONNECTIONS; i++) {
+        if (common_hal_socketpool_socket_get_closed(&listening)) {
+            break;
+        }
+        _connection *free_connection = NULL;
+        _connection *idle_connection = NULL;
+        for (size_t j = 0; j < CIRCUITPY_WEB_WORKFLOW_CONNECTIONS; j++) {
+            _connection *connection = &connections[j];
+            if (common_hal_socketpool_socket_get_closed(&connection->socket)) {
+                free_connection = connection;
+                break;
+            }
+            if (!connection->request.in_progress &&
+                (idle_connection == NULL || connection->last_request_ms < idle_connection->last_request_ms)) {
+                idle_connection = connection;
+            }
+        }
+        if (free_connection == NULL && idle_connection == NULL) {
+            break;
+        }
+        socketpool_socket_obj_t *socket = free_connection != NULL ? &free_connection->socket : &incoming;
+        int newsoc = socketpool_socket_accept(&listening, NULL, socket);
+        if (newsoc == -EBADF) {
+            common_hal_socketpool_socket_close(&listening);
+            break;
+        }
+        if (newsoc <= 0) {
+            break;
+        }
+        if (free_connection == NULL) {
+            _close_connection(idle_connection);
+            socketpool_socket_move(&incoming, &idle_connection->socket);
+            free_connection = idle_connection;
+        }
+        common_hal_socketpool_socket_settimeout(&free_connection->socket, 0);
+        _reset_request(&free_connection->request);
+        free_connection->last_request_ms = supervisor_ticks_ms64();
+        accepted = true;
     }
+    return accepted;
 }
 
 static bool supervisor_filesystem_access_could_block(void) {
@@ -1575,50 +2032,31 @@ static bool supervisor_filesystem_access_could_block(void) {
 }
 
 void supervisor_web_workflow_background(void *data) {
+    bool more = false;
     // If "/sd" is mounted AND shared with a display, access could block.
     // We don't have a good way to defer a filesystem action way down inside _process_request
     // when this happens, so just postpone if there's a chance of blocking. (#8980)
-    while (!supervisor_filesystem_access_could_block()) {
-        // If we have a request in progress, continue working on it. Do this first
-        // so that we can accept another socket after finishing this request.
-        if (common_hal_socketpool_socket_get_connected(&active)) {
-            _process_request(&active, &active_request);
-            if (active_request.in_progress) {
-                break;
-            }
-        } else {
-            // Close the active socket if necessary
-            if (!common_hal_socketpool_socket_get_closed(&active)) {
-                common_hal_socketpool_socket_close(&active);
-            }
-        }
-        // Otherwise, see if we have another socket to accept.
-        if ((!common_hal_socketpool_socket_get_connected(&active) ||
-             (!active_request.in_progress && !active_request.new_socket)) &&
-            !common_hal_socketpool_socket_get_closed(&listening)) {
-            if (!common_hal_socketpool_socket_get_closed(&active)) {
-                common_hal_socketpool_socket_close(&active);
-            }
-            int newsoc = socketpool_socket_accept(&listening, NULL, &active);
-            if (newsoc == -EBADF) {
-                common_hal_socketpool_socket_close(&listening);
-                break;
-            }
-            if (newsoc > 0) {
-                common_hal_socketpool_socket_settimeout(&active, 0);
-                _reset_request(&active_request);
-                // Mark new sockets, otherwise we may accept another before the first
-                // could start its request.
-                active_request.new_socket = true;
-                continue;
-            }
-            break;
+    if (!supervisor_filesystem_access_could_block()) {
+        // Each connection gets a bounded turn, starting with a different one
+        // every tick, so that no client can starve the others.
+        for (size_t i = 0; i < CIRCUITPY_WEB_WORKFLOW_CONNECTIONS; i++) {
+            size_t index = (next_connection + i) % CIRCUITPY_WEB_WORKFLOW_CONNECTIONS;
+            more = _process_connection(&connections[index]) || more;
         }
+        next_connection = (next_connection + 1) % CIRCUITPY_WEB_WORKFLOW_CONNECTIONS;
+
+        more = _accept_connections() || more;
     }
 
     // Let the websocket code run.
     websocket_background();
 
+    // Come back soon for work that doesn't wait on incoming data, such as
+    // sending a file.
+    if (more) {
+        supervisor_workflow_request_background();
+    }
+
     // Resume polling
     socketpool_socket_poll_resume();
 
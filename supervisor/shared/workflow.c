@@ -108,6 +108,7 @@ void supervisor_workflow_start(void) {
         // Enable background callbacks if web_workflow startup successful
         memset(&workflow_background_cb, 0, sizeof(workflow_background_cb));
         workflow_background_cb.fun = supervisor_web_workflow_background;
+        workflow_background_cb.priority = BACKGROUND_CALLBACK_PRIORITY_WEB;
     }
     #endif
 
@@ -13,6 +13,7 @@ SRC_SUPERVISOR = \
 	supervisor/shared/reload.c \
 	supervisor/shared/safe_mode.c \
 	supervisor/shared/serial.c \
+	supervisor/shared/spsc_ring.c \
 	supervisor/shared/stack.c \
 	supervisor/shared/status_leds.c \
 	supervisor/shared/tick.c \
@@ -80,7 +81,8 @@ ifeq ($(INTERNAL_FLASH_FILESYSTEM),1)
 else
   CFLAGS += -DEXTERNAL_FLASH_DEVICES=$(EXTERNAL_FLASH_DEVICES) \
 
-  SRC_SUPERVISOR += supervisor/shared/external_flash/external_flash.c
+  SRC_SUPERVISOR += supervisor/shared/external_flash/external_flash.c \
+    supervisor/shared/external_flash/sector_cache.c
   ifeq ($(SPI_FLASH_FILESYSTEM),1)
     SRC_SUPERVISOR += supervisor/shared/external_flash/spi_flash.c
   endif
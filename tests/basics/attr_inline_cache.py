@@ -0,0 +1,169 @@
+# test that call sites which cache attribute and global lookups still see
+# changes to the objects they were cached from
+
+
+class A:
+    x = 1
+
+    def f(self):
+        return "A.f"
+
+
+class B:
+    def __init__(self):
+        self.y = 2
+        self.x = 3
+
+    def f(self):
+        return "B.f"
+
+
+def get_x(o):
+    return o.x
+
+
+def call_f(o):
+    return o.f()
+
+
+# same call sites used with different types
+for o in (A(), B(), A, B()):
+    print(get_x(o))
+for o in (A(), B(), A(), B()):
+    print(call_f(o))
+
+# an instance member shadows a method found in the class before
+a = A()
+print(call_f(a))
+a.f = lambda: "member"
+print(call_f(a))
+del a.f
+print(call_f(a))
+
+# class attribute changes are seen through instances and the class
+print(get_x(A()), get_x(A))
+A.x = 10
+print(get_x(A()), get_x(A))
+A.x = lambda self: "bound"
+print(get_x(A())())
+del A.x
+try:
+    get_x(A())
+except AttributeError:
+    print("AttributeError")
+
+# member maps that grow move the cached slot
+b = B()
+print(get_x(b))
+for i in range(20):
+    setattr(b, "z%d" % i, i)
+print(get_x(b))
+del b.x
+try:
+    get_x(b)
+except AttributeError:
+    print("AttributeError")
+
+
+# globals that are rebound, deleted or shadow a builtin
+g = 1
+
+
+def get_g():
+    return g
+
+
+def get_len():
+    return len
+
+
+print(get_g())
+g = 2
+print(get_g())
+del g
+try:
+    get_g()
+except NameError:
+    print("NameError")
+g = 3
+print(get_g())
+
+print(get_len() is len)
+len = "global"
+print(get_len())
+del len
+print(get_len()("abc"))
+
+# module attributes, and a class at the same call site
+import sys
+
+
+def get_byteorder(m):
+    return m.byteorder
+
+
+class FakeModule:
+    byteorder = "class"
+
+
+print(get_byteorder(sys) == sys.byteorder)
+print(get_byteorder(sys) == sys.byteorder)
+print(get_byteorder(FakeModule))
+
+# a member added before the class gets an attribute of the same name still
+# hides it, as does one stored with object.__setattr__
+class C:
+    pass
+
+
+def call_g(o):
+    return o.g()
+
+
+c1 = C()
+c2 = C()
+c1.g = lambda: "member"
+C.g = lambda self: "class"
+print(call_g(c2), call_g(c1), call_g(c2), call_g(c1))
+
+
+class D:
+    def g(self):
+        return "D.g"
+
+
+d = D()
+print(call_g(d))
+object.__setattr__(d, "g", lambda: "member")
+print(call_g(d))
+
+
+# more call sites in one function than its table starts with, so sites share
+# slots of the table, used with the types swapped around between runs
+class P:
+    def __init__(self):
+        self.v = "P.v"
+
+    def m(self):
+        return "P.m"
+
+
+class Q:
+    v = "Q.v"
+
+    def m(self):
+        return "Q.m"
+
+
+def many(a, b, m):
+    return [
+        a.v, b.v, a.m(), b.m(), m.byteorder, a.v, b.v, a.m(), b.m(), m.byteorder,
+        a.v, b.v, a.m(), b.m(), m.byteorder, a.v, b.v, a.m(), b.m(), m.byteorder,
+        a.v, b.v, a.m(), b.m(), m.byteorder, a.v, b.v, a.m(), b.m(), m.byteorder,
+        a.v, b.v, a.m(), b.m(), m.byteorder, a.v, b.v, a.m(), b.m(), m.byteorder,
+    ]
+
+
+for a, b, m in ((P(), Q(), sys), (Q(), P(), sys), (P(), Q(), FakeModule), (Q(), Q(), sys)):
+    for _ in range(2):
+        print(many(a, b, m) == [a.v, b.v, a.m(), b.m(), m.byteorder] * 8)
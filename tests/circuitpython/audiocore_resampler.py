@@ -0,0 +1,58 @@
+import array
+import audiocore
+
+
+def play(sample):
+    audiocore.reset_buffer(sample)
+    while True:
+        result, buf = audiocore.get_buffer(sample)
+        print(result, list(buf))
+        if result != 1:
+            break
+
+
+ramp = audiocore.RawSample(array.array("h", range(0, 8000, 1000)), sample_rate=8000)
+
+print("upsample")
+up = audiocore.Resampler(ramp, sample_rate=16000, buffer_size=16)
+print(up.sample is ramp, up.sample_rate, up.bits_per_sample, up.channel_count)
+print(audiocore.get_structure(up))
+play(up)
+
+print("downsample")
+play(audiocore.Resampler(ramp, sample_rate=4000))
+
+print("same rate")
+play(audiocore.Resampler(ramp, sample_rate=8000))
+
+print("mono to stereo")
+play(audiocore.Resampler(ramp, sample_rate=12000, channel_count=2))
+
+print("stereo to mono")
+stereo = audiocore.RawSample(
+    array.array("h", [100, 300, -200, -400, 1000, 0]), sample_rate=8000, channel_count=2
+)
+play(audiocore.Resampler(stereo, sample_rate=8000, channel_count=1))
+
+print("unsigned 8 bit")
+unsigned = audiocore.RawSample(array.array("B", [0, 128, 255]), sample_rate=8000)
+play(audiocore.Resampler(unsigned, sample_rate=16000))
+
+print("replay after rate change")
+up.sample_rate = 8000
+play(up)
+
+print("errors")
+try:
+    audiocore.Resampler(ramp, sample_rate=0)
+except ValueError as e:
+    print("ValueError", e)
+try:
+    audiocore.Resampler(ramp, sample_rate=8000, channel_count=3)
+except ValueError as e:
+    print("ValueError", e)
+up.deinit()
+try:
+    up.sample
+except ValueError as e:
+    print("ValueError", e)
@@ -0,0 +1,117 @@
+import array
+import audiocore
+import os
+import struct
+
+
+# Only keeps blocks that aren't all zero, so that the volume can be big enough
+# to have clusters of several sectors.
+class SparseBlockDevice:
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.blocks = blocks
+        self.data = {}
+        self.reads = None
+
+    def readblocks(self, n, buf):
+        count = len(buf) // self.SEC_SIZE
+        if self.reads is not None:
+            self.reads.append(count)
+        for i in range(count):
+            block = self.data.get(n + i, bytes(self.SEC_SIZE))
+            buf[i * self.SEC_SIZE : (i + 1) * self.SEC_SIZE] = block
+        return 0
+
+    def writeblocks(self, n, buf):
+        for i in range(len(buf) // self.SEC_SIZE):
+            block = bytes(buf[i * self.SEC_SIZE : (i + 1) * self.SEC_SIZE])
+            if any(block):
+                self.data[n + i] = block
+            else:
+                self.data.pop(n + i, None)
+        return 0
+
+    def ioctl(self, op, arg):
+        if op == 4:  # MP_BLOCKDEV_IOCTL_BLOCK_COUNT
+            return self.blocks
+        if op == 5:  # MP_BLOCKDEV_IOCTL_BLOCK_SIZE
+            return self.SEC_SIZE
+
+
+bdev = SparseBlockDevice(16384)
+os.VfsFat.mkfs(bdev)
+os.mount(os.VfsFat(bdev), "/ramdisk")
+
+
+def write_wave(name, data, bits_per_sample, channel_count=1, sample_rate=8000):
+    block_align = channel_count * bits_per_sample // 8
+    with open(name, "wb") as f:
+        f.write(b"RIFF")
+        f.write(struct.pack("<I", 36 + len(data)))
+        f.write(b"WAVEfmt ")
+        f.write(
+            struct.pack(
+                "<IHHIIHH",
+                16,
+                1,
+                channel_count,
+                sample_rate,
+                sample_rate * block_align,
+                block_align,
+                bits_per_sample,
+            )
+        )
+        f.write(b"data")
+        f.write(struct.pack("<I", len(data)))
+        f.write(data)
+
+
+def play(sample):
+    audiocore.reset_buffer(sample)
+    data = bytearray()
+    lengths = []
+    while True:
+        result, buf = audiocore.get_buffer(sample)
+        if buf is None:
+            break
+        data.extend(buf)
+        lengths.append(len(buf) * buf.itemsize)
+        if result != 1:
+            break
+    print(result, lengths)
+    return data
+
+
+ramp = bytes(array.array("h", range(-30000, 30000, 20)))
+write_wave("/ramdisk/ramp.wav", ramp, 16)
+for read_ahead in (0, 2, 8):
+    print("read_ahead", read_ahead)
+    w = audiocore.WaveFile("/ramdisk/ramp.wav", read_ahead=read_ahead)
+    bdev.reads = []
+    print(play(w) == ramp)
+    print("most sectors read at once", max(bdev.reads))
+    bdev.reads = None
+    print("loop", play(w) == ramp, w.underruns)
+    w.deinit()
+
+print("user buffer")
+w = audiocore.WaveFile("/ramdisk/ramp.wav", bytearray(400), read_ahead=3)
+print(play(w) == ramp)
+
+print("8 bit padding")
+write_wave("/ramdisk/odd.wav", bytes(range(255)), 8)
+w = audiocore.WaveFile("/ramdisk/odd.wav", read_ahead=1)
+print(list(play(w)[-4:]))
+
+print("errors")
+try:
+    audiocore.WaveFile("/ramdisk/ramp.wav", read_ahead=9)
+except ValueError as e:
+    print("ValueError", e)
+try:
+    audiocore.WaveFile("/ramdisk/ramp.wav", bytearray(8), read_ahead=1)
+except ValueError as e:
+    print("ValueError", e)
+
+os.umount("/ramdisk")
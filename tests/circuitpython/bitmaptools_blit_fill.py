@@ -0,0 +1,107 @@
+import bitmaptools
+import displayio
+
+# Compares fill_region and blit with the same operations done one pixel at a time. Widths and offsets
+# are odd so that rows start and end part way into bytes and words at every depth.
+# Bitmaps made from Python hold up to 16 bits per value.
+DEPTHS = (1, 2, 4, 8, 16)
+
+
+def bitmap(width, height, bits, seed):
+    b = displayio.Bitmap(width, height, 1 << bits)
+    for i in range(width * height):
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+        b[i] = (seed >> 7) & ((1 << bits) - 1)
+    return b
+
+
+def values(b):
+    return [[b[x, y] for x in range(b.width)] for y in range(b.height)]
+
+
+def fill_model(rows, x1, y1, x2, y2, value):
+    for y in range(max(0, y1), min(len(rows), y2)):
+        for x in range(max(0, x1), min(len(rows[0]), x2)):
+            rows[y][x] = value
+
+
+def blit_model(dest, source, x, y, x1, y1, x2, y2, skip_source_index=None, skip_dest_index=None):
+    copied = [row[x1:x2] for row in source[y1:y2]]
+    for j, row in enumerate(copied):
+        for i, v in enumerate(row):
+            dx, dy = x + i, y + j
+            if dx >= len(dest[0]) or dy >= len(dest):
+                continue
+            if v == skip_source_index or dest[dy][dx] == skip_dest_index:
+                continue
+            dest[dy][dx] = v
+
+
+def check(name, b, expected):
+    got = values(b)
+    if got == expected:
+        print(name, "ok")
+    else:
+        print(name, "FAIL")
+        print(" got", got)
+        print(" expected", expected)
+
+
+for bits in DEPTHS:
+    top = (1 << bits) - 1
+    for x1, x2 in ((0, 37), (1, 36), (3, 4), (5, 29), (31, 33), (7, 7)):
+        b = bitmap(37, 3, bits, bits + x1)
+        expected = values(b)
+        bitmaptools.fill_region(b, x1, 1, x2, 3, top)
+        fill_model(expected, x1, 1, x2, 3, top)
+        check("fill %d bits x %d-%d" % (bits, x1, x2), b, expected)
+
+for bits in DEPTHS:
+    top = (1 << bits) - 1
+    for x, x1, x2 in ((0, 0, 37), (1, 0, 36), (3, 5, 30), (8, 1, 37), (31, 2, 20), (36, 3, 4)):
+        source = bitmap(37, 4, bits, 2 * bits + x)
+        dest = bitmap(37, 4, bits, 3 * bits + x1)
+        expected = values(dest)
+        bitmaptools.blit(dest, source, x, 1, x1=x1, y1=1, x2=x2, y2=4)
+        blit_model(expected, values(source), x, 1, x1, 1, x2, 4)
+        check("blit %d bits x %d from %d-%d" % (bits, x, x1, x2), dest, expected)
+
+        # Every value of the source that equals the skip index stays as it was.
+        dest = bitmap(37, 4, bits, 3 * bits + x1)
+        expected = values(dest)
+        bitmaptools.blit(dest, source, x, 0, x1=x1, y1=0, x2=x2, y2=4, skip_source_index=top)
+        blit_model(expected, values(source), x, 0, x1, 0, x2, 4, skip_source_index=top)
+        check("blit %d bits skip source %d" % (bits, top), dest, expected)
+
+        dest = bitmap(37, 4, bits, 3 * bits + x1)
+        expected = values(dest)
+        bitmaptools.blit(dest, source, x, 0, x1=x1, y1=0, x2=x2, y2=4, skip_dest_index=0)
+        blit_model(expected, values(source), x, 0, x1, 0, x2, 4, skip_dest_index=0)
+        check("blit %d bits skip dest 0" % bits, dest, expected)
+
+# Into a deeper bitmap, which copies values one at a time.
+for bits in (1, 2, 4, 8):
+    source = bitmap(21, 2, bits, bits)
+    dest = bitmap(21, 2, 16, bits)
+    expected = values(dest)
+    bitmaptools.blit(dest, source, 3, 0, x1=1, y1=0, x2=21, y2=2)
+    blit_model(expected, values(source), 3, 0, 1, 0, 21, 2)
+    check("blit %d bits into 16 bits" % bits, dest, expected)
+
+# Within one bitmap, where source and destination overlap in either direction.
+for bits in (1, 4, 8, 16):
+    for x, y, x1, y1 in ((3, 1, 0, 0), (0, 0, 3, 1), (5, 0, 0, 0), (0, 2, 0, 0), (0, 0, 0, 2)):
+        b = bitmap(23, 5, bits, bits + x)
+        expected = values(b)
+        source = values(b)
+        bitmaptools.blit(b, b, x, y, x1=x1, y1=y1, x2=x1 + 17, y2=y1 + 3)
+        blit_model(expected, source, x, y, x1, y1, x1 + 17, y1 + 3)
+        check("overlapping %d bits to %d,%d from %d,%d" % (bits, x, y, x1, y1), b, expected)
+
+# Skipping the index that every pixel of the source has copies nothing.
+b = bitmap(9, 2, 4, 1)
+expected = values(b)
+source = displayio.Bitmap(9, 2, 16)
+source.fill(5)
+bitmaptools.blit(b, source, 0, 0, skip_source_index=5)
+check("skip everything", b, expected)
@@ -0,0 +1,120 @@
+import displayio
+
+# Bitmaps and TileGrids keep several dirty areas so that far apart changes don't redraw everything
+# between them.
+WIDTH = 16
+HEIGHT = 8
+
+palette = displayio.Palette(4)
+palette[0] = 0x000000
+palette[1] = 0x555555
+palette[2] = 0xAAAAAA
+palette[3] = 0xFFFFFF
+
+
+def refresh(group, fb, rotation=0):
+    return displayio._refresh(group, fb, WIDTH, HEIGHT, rotation, 8)
+
+
+def scene(bitmap, rotation=0, **kwargs):
+    group = displayio.Group()
+    group.append(displayio.TileGrid(bitmap, pixel_shader=palette, **kwargs))
+    fb = bytearray(WIDTH * HEIGHT)
+    refresh(group, fb, rotation)
+    return group, fb
+
+
+# Draws the bitmap again from scratch to check the framebuffer kept up to date by partial refreshes.
+def matches_full_refresh(bitmap, fb, rotation=0, **kwargs):
+    group = displayio.Group()
+    group.append(displayio.TileGrid(bitmap, pixel_shader=palette, **kwargs))
+    expected = bytearray(WIDTH * HEIGHT)
+    refresh(group, expected, rotation)
+    return fb == expected
+
+
+def areas(group, fb, rotation=0):
+    return sorted(refresh(group, fb, rotation))
+
+
+bitmap = displayio.Bitmap(WIDTH, HEIGHT, 4)
+group, fb = scene(bitmap)
+print("nothing changed", areas(group, fb))
+
+bitmap[0, 0] = 1
+bitmap[15, 7] = 2
+print("opposite corners", areas(group, fb))
+
+bitmap[3, 3] = 3
+bitmap[4, 3] = 3
+bitmap[4, 4] = 3
+print("neighbors", areas(group, fb))
+
+bitmap[1, 1] = 1
+bitmap[5, 5] = 1
+print("far apart", areas(group, fb))
+
+for x, y in ((0, 0), (5, 0), (10, 0), (15, 0), (0, 7)):
+    bitmap[x, y] = 3
+print("more areas than kept", len(areas(group, fb)) <= 4)
+bitmap.fill(0)
+print("fill", areas(group, fb))
+print("matches full refresh", matches_full_refresh(bitmap, fb))
+
+# Partial changes on a rotated display.
+for rotation in (90, 270):
+    bitmap = displayio.Bitmap(HEIGHT, WIDTH, 4)
+    group, fb = scene(bitmap, rotation)
+    bitmap[0, 0] = 1
+    bitmap[7, 15] = 2
+    bitmap[2, 9] = 3
+    print("rotation", rotation, areas(group, fb, rotation))
+    print("matches full refresh", matches_full_refresh(bitmap, fb, rotation))
+
+# A scaled, offset TileGrid showing the whole bitmap as one tile.
+bitmap = displayio.Bitmap(4, 2, 4)
+group = displayio.Group(scale=2, x=3)
+tilegrid = displayio.TileGrid(bitmap, pixel_shader=palette, x=1)
+group.append(tilegrid)
+fb = bytearray(WIDTH * HEIGHT)
+refresh(group, fb)
+bitmap[0, 0] = 2
+bitmap[3, 1] = 3
+print("scaled", areas(group, fb))
+
+# Tile changes of a TileGrid with several tiles.
+tiles = displayio.Bitmap(8, 2, 4)
+for i in range(16):
+    tiles[i] = i // 2 % 4
+tilegrid = displayio.TileGrid(tiles, pixel_shader=palette, width=8, height=4, tile_width=2, tile_height=2)
+group = displayio.Group()
+group.append(tilegrid)
+fb = bytearray(WIDTH * HEIGHT)
+refresh(group, fb)
+tilegrid[0, 0] = 1
+tilegrid[7, 3] = 2
+print("tiles in opposite corners", areas(group, fb))
+tilegrid[3, 1] = 3
+tilegrid[4, 1] = 3
+print("neighboring tiles", areas(group, fb))
+
+
+# A copy of the tilegrid drawn from scratch.
+def matches_copy(fb):
+    expected = displayio.Group()
+    copy = displayio.TileGrid(tiles, pixel_shader=palette, width=8, height=4, tile_width=2, tile_height=2)
+    for x in range(8):
+        for y in range(4):
+            copy[x, y] = tilegrid[x, y]
+    expected.append(copy)
+    expected_fb = bytearray(WIDTH * HEIGHT)
+    refresh(expected, expected_fb)
+    return fb == expected_fb
+
+
+print("matches full refresh", matches_copy(fb))
+
+# A change to the bitmap shared by every tile redraws each tile that shows it.
+tiles[0, 0] = 3
+print("shared bitmap", areas(group, fb))
+print("matches full refresh", matches_copy(fb))
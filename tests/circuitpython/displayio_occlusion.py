@@ -0,0 +1,107 @@
+import displayio
+
+# Layers hidden behind opaque TileGrids are skipped while refreshing. These check that a layer is
+# only skipped when nothing of it can be seen.
+WIDTH = 8
+HEIGHT = 4
+
+palette = displayio.Palette(4)
+palette[0] = 0x000000
+palette[1] = 0x555555
+palette[2] = 0xAAAAAA
+palette[3] = 0xFFFFFF
+
+
+def solid(width, height, value, shader=palette, **kwargs):
+    bitmap = displayio.Bitmap(width, height, 4)
+    bitmap.fill(value)
+    return displayio.TileGrid(bitmap, pixel_shader=shader, **kwargs)
+
+
+def show(group, fb):
+    areas = displayio._refresh(group, fb, WIDTH, HEIGHT, 0, 8)
+    print(areas)
+    for y in range(HEIGHT):
+        print("".join(".-+#"[v >> 6] for v in fb[y * WIDTH : (y + 1) * WIDTH]))
+
+
+def scene(*layers):
+    group = displayio.Group()
+    for layer in layers:
+        group.append(layer)
+    return group
+
+
+print("covered by an opaque layer")
+show(scene(solid(4, 2, 1, x=2, y=1), solid(6, 4, 2, x=1)), bytearray(WIDTH * HEIGHT))
+
+print("partly covered")
+show(scene(solid(4, 2, 1, x=2, y=1), solid(3, 4, 2)), bytearray(WIDTH * HEIGHT))
+
+print("covered by two layers that each cover part of it")
+show(scene(solid(4, 2, 1, x=2, y=1), solid(4, 4, 2), solid(4, 4, 3, x=4)), bytearray(WIDTH * HEIGHT))
+
+print("covered by a palette with a transparent color")
+clear = displayio.Palette(4)
+for i in range(4):
+    clear[i] = palette[i]
+clear.make_transparent(0)
+top = displayio.Bitmap(6, 4, 4)
+top.fill(2)
+top[3, 1] = 0
+show(scene(solid(4, 2, 1, x=2, y=1), displayio.TileGrid(top, pixel_shader=clear)), bytearray(WIDTH * HEIGHT))
+
+print("covered by a bitmap with values past the end of the palette")
+short = displayio.Palette(2)
+short[0] = 0xAAAAAA
+short[1] = 0xAAAAAA
+top = displayio.Bitmap(6, 4, 4)
+top[3, 1] = 3
+show(scene(solid(4, 2, 1, x=2, y=1), displayio.TileGrid(top, pixel_shader=short)), bytearray(WIDTH * HEIGHT))
+
+print("covered by a ColorConverter with a transparent color")
+converter = displayio.ColorConverter(input_colorspace=displayio.Colorspace.RGB565)
+converter.make_transparent(0)
+top = displayio.Bitmap(6, 4, 65536)
+top.fill(0xFFFF)
+top[3, 1] = 0
+show(scene(solid(4, 2, 1, x=2, y=1), displayio.TileGrid(top, pixel_shader=converter)), bytearray(WIDTH * HEIGHT))
+
+print("covered by a hidden layer")
+cover = solid(8, 4, 2)
+cover.hidden = True
+show(scene(solid(4, 2, 1, x=2, y=1), cover), bytearray(WIDTH * HEIGHT))
+
+print("covered by a layer in a hidden group")
+inner = displayio.Group()
+inner.append(solid(8, 4, 2))
+inner.hidden = True
+show(scene(solid(4, 2, 1, x=2, y=1), inner), bytearray(WIDTH * HEIGHT))
+
+print("a covered group")
+inner = displayio.Group(x=1)
+inner.append(solid(2, 2, 1, y=1))
+inner.append(solid(2, 2, 3, x=3, y=1))
+show(scene(inner, solid(8, 4, 2)), bytearray(WIDTH * HEIGHT))
+
+# Occlusion only lasts for one refresh. Moving the cover away shows what was behind it.
+print("uncovered later")
+fb = bytearray(WIDTH * HEIGHT)
+below = solid(4, 2, 1, x=2, y=1)
+cover = solid(6, 4, 2, x=1)
+group = scene(below, cover)
+show(group, fb)
+cover.x = 4
+show(group, fb)
+cover.hidden = True
+show(group, fb)
+
+# A change to a covered layer doesn't show.
+print("covered layer changes")
+fb = bytearray(WIDTH * HEIGHT)
+below_bitmap = displayio.Bitmap(4, 2, 4)
+below_bitmap.fill(1)
+group = scene(displayio.TileGrid(below_bitmap, pixel_shader=palette, x=2, y=1), solid(6, 4, 2, x=1))
+show(group, fb)
+below_bitmap[1, 1] = 3
+show(group, fb)
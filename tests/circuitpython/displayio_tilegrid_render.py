@@ -0,0 +1,130 @@
+import displayio
+
+# Pixels are drawn into a framebuffer the way a display with this native size would.
+WIDTH = 8
+HEIGHT = 6
+
+# Grays that stay distinct at every depth tested, so pictures can be compared across depths.
+palette = displayio.Palette(4)
+palette[0] = 0x000000
+palette[1] = 0x555555
+palette[2] = 0xAAAAAA
+palette[3] = 0xFFFFFF
+
+# An asymmetric 5x3 shape so that any rotation or flip shows.
+shape = displayio.Bitmap(5, 3, 4)
+for i, v in enumerate((3, 3, 3, 3, 1, 3, 0, 0, 2, 0, 3, 0, 0, 0, 0)):
+    shape[i] = v
+
+
+# Returns the gray level, 0 to 3, of a pixel.
+def level(fb, depth, x, y):
+    if depth == 16:
+        return (fb[2 * (y * WIDTH + x)] | fb[2 * (y * WIDTH + x) + 1] << 8) >> 9 & 0x3
+    if depth == 8:
+        return fb[y * WIDTH + x] >> 6
+    i = (y * WIDTH + x) * depth
+    v = (fb[i // 8] >> (i % 8)) & ((1 << depth) - 1)
+    return v * 3 if depth == 1 else v >> (depth - 2)
+
+
+def render(group, rotation=0, depth=8):
+    fb = bytearray(WIDTH * HEIGHT * 2)
+    displayio._refresh(group, fb, WIDTH, HEIGHT, rotation, depth)
+    return [[level(fb, depth, x, y) for x in range(WIDTH)] for y in range(HEIGHT)]
+
+
+def show(rows):
+    for row in rows:
+        print("".join(".-+#"[v] for v in row))
+
+
+def reversed_rows(rows):
+    return [list(reversed(row)) for row in reversed(rows)]
+
+
+def grid(x=0, y=0, **flips):
+    group = displayio.Group()
+    tilegrid = displayio.TileGrid(shape, pixel_shader=palette, x=x, y=y)
+    for name, value in flips.items():
+        setattr(tilegrid, name, value)
+    group.append(tilegrid)
+    return group
+
+
+# The display rotations. 180 is 0 turned around and 270 is 90 turned around.
+by_rotation = {}
+for rotation in (0, 90, 180, 270):
+    print("rotation", rotation)
+    by_rotation[rotation] = render(grid(x=1, y=1), rotation)
+    show(by_rotation[rotation])
+print("180 matches 0", by_rotation[180] == reversed_rows(by_rotation[0]))
+print("270 matches 90", by_rotation[270] == reversed_rows(by_rotation[90]))
+
+# The TileGrid's own flips and transpose, alone and on a rotated display.
+plain = render(grid(x=1, y=1))
+for kwargs in ({"flip_x": True}, {"flip_y": True}, {"transpose_xy": True}):
+    print(kwargs)
+    show(render(grid(x=1, y=1, **kwargs)))
+flip_x = render(grid(x=1, y=1, flip_x=True))
+print("flip_x mirrors rows", [row[1:6] for row in flip_x] == [list(reversed(row[1:6])) for row in plain])
+transposed = render(grid(transpose_xy=True))
+print(
+    "transpose_xy swaps x and y",
+    all(transposed[x][y] == render(grid())[y][x] for x in range(5) for y in range(3)),
+)
+for rotation in (90, 270):
+    print("transpose_xy, flip_x on rotation", rotation)
+    show(render(grid(x=1, y=1, transpose_xy=True, flip_x=True), rotation))
+
+# Each depth draws the same picture. One bit only keeps the lighter grays.
+expected = render(grid(x=2, y=2, flip_y=True), 90)
+for depth in (1, 2, 4, 16):
+    rows = render(grid(x=2, y=2, flip_y=True), 90, depth)
+    if depth == 1:
+        print("depth", depth, rows == [[3 if v >= 2 else 0 for v in row] for row in expected])
+    else:
+        print("depth", depth, rows == expected)
+print("depth 1")
+show(render(grid(x=2, y=2, flip_y=True), 90, 1))
+
+# Partially transparent tiles over a lower layer. Only the transparent pixels of each tile show the
+# background, and a tile that is entirely transparent shows it all.
+background = displayio.Bitmap(WIDTH, WIDTH, 4)
+background.fill(1)
+tiles = displayio.Bitmap(6, 2, 4)
+for i, v in enumerate((3, 0, 2, 0, 0, 0, 0, 3, 2, 2, 0, 0)):
+    tiles[i] = v
+top_palette = displayio.Palette(4)
+for i in range(4):
+    top_palette[i] = palette[i]
+top_palette.make_transparent(0)
+for rotation in (0, 90, 180, 270):
+    group = displayio.Group()
+    group.append(displayio.TileGrid(background, pixel_shader=palette))
+    top = displayio.TileGrid(
+        tiles, pixel_shader=top_palette, width=3, height=2, tile_width=2, tile_height=2, x=1, y=1
+    )
+    top[0, 0] = 0
+    top[1, 0] = 2
+    top[2, 0] = 1
+    top[0, 1] = 1
+    top[1, 1] = 0
+    top[2, 1] = 2
+    group.append(top)
+    print("transparent tiles, rotation", rotation)
+    show(render(group, rotation))
+
+# Opaque layers that each cover part of the display over one that they cover together. The bottom
+# layer must not show through anywhere, including where the upper layers meet.
+for rotation in (0, 90):
+    group = displayio.Group()
+    group.append(displayio.TileGrid(background, pixel_shader=palette))
+    left = displayio.Bitmap(3, WIDTH, 4)
+    left.fill(2)
+    right = displayio.Bitmap(WIDTH, WIDTH, 4)
+    right.fill(3)
+    group.append(displayio.TileGrid(right, pixel_shader=palette, x=3))
+    group.append(displayio.TileGrid(left, pixel_shader=palette))
+    print("opaque layers, rotation", rotation)
+    show(render(group, rotation))
@@ -0,0 +1,157 @@
+import io
+
+import displayio
+import gifio
+
+# Frames written by GifWriter are read back with a plain GIF decoder and compared with what was
+# written. L8 pixels are stored as their value shifted right by one, so frames here are made of
+# palette indices shifted left by one.
+
+
+def sub_blocks(data, pos):
+    out = bytearray()
+    while data[pos]:
+        out.extend(data[pos + 1 : pos + 1 + data[pos]])
+        pos += 1 + data[pos]
+    return out, pos + 1
+
+
+# Returns the pixels, the code widths that were read and how many times the table was cleared
+# after the first clear code.
+def lzw_decode(data, min_size):
+    clear = 1 << min_size
+    end = clear + 1
+    size = min_size + 1
+    table = []
+    out = bytearray()
+    widths = set()
+    clears = -1
+    prev = None
+    bit = 0
+    while True:
+        code = 0
+        for i in range(size):
+            code |= ((data[bit >> 3] >> (bit & 7)) & 1) << i
+            bit += 1
+        widths.add(size)
+        if code == clear:
+            table = [bytes([i]) for i in range(clear)] + [b"", b""]
+            size = min_size + 1
+            prev = None
+            clears += 1
+            continue
+        if code == end:
+            break
+        if prev is None:
+            entry = table[code]
+        else:
+            if code < len(table):
+                entry = table[code]
+            elif code == len(table):
+                entry = prev + prev[:1]
+            else:
+                raise ValueError("bad code %d" % code)
+            if len(table) < 4096:
+                table.append(prev + entry[:1])
+                if len(table) == 1 << size and size < 12:
+                    size += 1
+        out.extend(entry)
+        prev = entry
+    return out, widths, clears
+
+
+# Returns the size of the GIF and each of its frames as (delay, left, top, width, height, pixels,
+# code widths, clears).
+def decode(data):
+    assert data[:6] == b"GIF89a"
+    width = data[6] | data[7] << 8
+    height = data[8] | data[9] << 8
+    flags = data[10]
+    pos = 13
+    if flags & 0x80:
+        pos += 3 * (2 << (flags & 7))
+    frames = []
+    delay = 0
+    while True:
+        kind = data[pos]
+        pos += 1
+        if kind == 0x3B:
+            break
+        if kind == 0x21:
+            label = data[pos]
+            block, pos = sub_blocks(data, pos + 1)
+            if label == 0xF9:
+                delay = block[1] | block[2] << 8
+        elif kind == 0x2C:
+            left, top, w, h = (data[pos + 2 * i] | data[pos + 2 * i + 1] << 8 for i in range(4))
+            assert data[pos + 8] == 0
+            min_size = data[pos + 9]
+            block, pos = sub_blocks(data, pos + 10)
+            pixels, widths, clears = lzw_decode(block, min_size)
+            assert len(pixels) == w * h
+            frames.append((delay, left, top, w, h, pixels, widths, clears))
+            delay = 0
+        else:
+            raise ValueError("bad block %x" % kind)
+    return width, height, frames
+
+
+def write(width, height, frames, delay=0, **kwargs):
+    out = io.BytesIO()
+    with gifio.GifWriter(out, width, height, displayio.Colorspace.L8, **kwargs) as writer:
+        for frame in frames:
+            writer.add_frame(bytes(v << 1 for v in frame), delay)
+    return decode(out.getvalue())
+
+
+def random_pixels(count, seed):
+    pixels = bytearray(count)
+    for i in range(count):
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+        pixels[i] = (seed >> 9) & 0x7F
+    return pixels
+
+
+# A small frame only needs the first code widths.
+frame = bytes((x * y) & 0x7F for y in range(8) for x in range(16))
+width, height, frames = write(16, 8, [frame])
+_, left, top, w, h, pixels, widths, clears = frames[0]
+print("small", width, height, (left, top, w, h), pixels == frame, sorted(widths), clears)
+
+# A long run of one color builds ever longer strings.
+frame = bytes(5 for _ in range(256 * 64))
+_, _, _, _, _, pixels, widths, clears = write(256, 64, [frame])[2][0]
+print("one color", pixels == frame, sorted(widths), clears)
+
+# Noise adds a code for nearly every pixel, so codes grow to 12 bits and the table is cleared each
+# time its 4096 entries are used up.
+frame = random_pixels(96 * 64, 1)
+_, _, _, _, _, pixels, widths, clears = write(96, 64, [frame])[2][0]
+print("noise", pixels == frame, sorted(widths), clears)
+
+# Every frame is whole without delta.
+first = random_pixels(24 * 16, 2)
+second = bytearray(first)
+second[5 * 24 + 7] ^= 1
+frames = write(24, 16, [first, second, second], delay=0.07)[2]
+for delay, left, top, w, h, pixels, _, _ in frames:
+    print("frame", delay, (left, top, w, h))
+print("frames match", [f[5] for f in frames] == [first, second, second])
+
+# With delta, later frames only hold the area that changed, and a frame with no changes holds one
+# unchanged pixel. Drawing each over the last gives the frames that were written.
+third = bytearray(second)
+third[2 * 24 + 20] = 0
+third[9 * 24 + 3] = 1
+written = [first, second, third, third, first]
+frames = write(24, 16, written, delay=0.05, delta=True)[2]
+canvas = bytearray(24 * 16)
+for (delay, left, top, w, h, pixels, _, _), expected in zip(frames, written):
+    for y in range(h):
+        canvas[(top + y) * 24 + left : (top + y) * 24 + left + w] = pixels[y * w : (y + 1) * w]
+    print("delta", delay, (left, top, w, h), canvas == expected)
+
+# Noise in delta frames still clears the table.
+noise = random_pixels(96 * 64, 3)
+frames = write(96, 64, [bytes(96 * 64), noise], delta=True)[2]
+print("delta noise", frames[1][1:5], frames[1][5] == noise, frames[1][7] > 0)
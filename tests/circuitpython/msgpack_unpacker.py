@@ -0,0 +1,140 @@
+import array
+import io
+import struct
+
+import msgpack
+
+# Each object is fed to an Unpacker in pieces: its first bytes one at a time, so that headers are
+# split everywhere, then all but the last byte. Nothing comes out until the last byte arrives, and
+# the object then matches what msgpack.unpack gives.
+
+
+def hook(code, data):
+    return ("ext", code, len(data))
+
+
+def fed(data):
+    unpacker = msgpack.Unpacker(ext_hook=hook)
+    early = 0
+    pieces = [data[i : i + 1] for i in range(min(len(data) - 1, 12))]
+    pieces.append(data[len(pieces) : -1])
+    for piece in pieces:
+        unpacker.feed(piece)
+        early += len(list(unpacker))
+    unpacker.feed(data[-1:])
+    objects = list(unpacker)
+    return early == 0 and objects == [msgpack.unpack(io.BytesIO(data), ext_hook=hook)]
+
+
+def summary(obj):
+    if isinstance(obj, (str, bytes, list, dict)):
+        return "%s %d" % (type(obj).__name__, len(obj))
+    return repr(obj)
+
+
+def check(name, data):
+    obj = msgpack.unpack(io.BytesIO(data), ext_hook=hook)
+    print(name, "%02x" % data[0], summary(obj), fed(data))
+
+
+def header(code, size_bytes, n):
+    return bytes([code]) + n.to_bytes(size_bytes, "big")
+
+
+# Lengths on either side of each size boundary.
+for n in (0, 31):
+    check("fixstr", bytes([0xA0 | n]) + b"s" * n)
+for code, size_bytes, lengths in ((0xD9, 1, (32, 255)), (0xDA, 2, (256, 65535)), (0xDB, 4, (65536,))):
+    for n in lengths:
+        check("str", header(code, size_bytes, n) + b"s" * n)
+for code, size_bytes, lengths in ((0xC4, 1, (0, 255)), (0xC5, 2, (256, 65535)), (0xC6, 4, (65536,))):
+    for n in lengths:
+        check("bin", header(code, size_bytes, n) + b"b" * n)
+for n in (0, 15):
+    check("fixarray", bytes([0x90 | n]) + b"\x01" * n)
+# Long arrays and maps don't fit in the heap, so the wider headers hold shorter lengths.
+for code, size_bytes, n in ((0xDC, 2, 16), (0xDC, 2, 0x1FF), (0xDD, 4, 0x201)):
+    check("array", header(code, size_bytes, n) + b"\x01" * n)
+for n in (0, 15):
+    check("fixmap", bytes([0x80 | n]) + b"".join(bytes([0xA1, 0x41 + i, i]) for i in range(n)))
+for code, size_bytes, n in ((0xDE, 2, 16), (0xDE, 2, 0x102), (0xDF, 4, 0x103)):
+    check("map", header(code, size_bytes, n) + b"".join(struct.pack(">BH", 0xCD, i) + b"\xc0" for i in range(n)))
+for code, n in ((0xD4, 1), (0xD5, 2), (0xD6, 4), (0xD7, 8), (0xD8, 16)):
+    check("fixext", bytes([code, 5]) + b"e" * n)
+for code, size_bytes, n in ((0xC7, 1, 0), (0xC7, 1, 255), (0xC8, 2, 256), (0xC9, 4, 65536)):
+    check("ext", header(code, size_bytes, n) + b"\x06" + b"e" * n)
+for data in (b"\x00", b"\x7f", b"\xe0", b"\xff", b"\xc0", b"\xc2", b"\xc3"):
+    check("fixed", data)
+for fmt, code, values in (
+    (">B", 0xCC, (0, 255)),
+    (">H", 0xCD, (256, 65535)),
+    (">I", 0xCE, (65536, 0x3FFFFFFF)),
+    (">b", 0xD0, (-128, 127)),
+    (">h", 0xD1, (-32768, 32767)),
+    (">i", 0xD2, (-0x40000000, 0x3FFFFFFF)),
+):
+    for value in values:
+        check("int", bytes([code]) + struct.pack(fmt, value))
+check("float", b"\xca" + struct.pack(">f", 1.5))
+check("double", b"\xcb" + struct.pack(">d", -2.5))
+
+# Containers nested in containers.
+nested = b"\x92\x91\x81\xa1k\xdc\x00\x02\xc4\x01z\x90\xd4\x01\x00"
+check("nested", nested)
+
+# Several objects fed in pieces that split them anywhere.
+stream = b"".join((nested, b"\xa3abc", b"\xcd\x12\x34", nested, b"\x05"))
+for size in (1, 2, 3, 7, 100):
+    unpacker = msgpack.Unpacker(ext_hook=hook, buffer_size=4)
+    objects = []
+    for i in range(0, len(stream), size):
+        unpacker.feed(stream[i : i + size])
+        objects.extend(unpacker)
+    print("pieces of", size, len(objects), objects[1:3], objects[0] == objects[3])
+
+# A stream is read from as more data is needed.
+unpacker = msgpack.Unpacker(io.BytesIO(stream), ext_hook=hook, buffer_size=4)
+print("stream", [summary(obj) for obj in unpacker])
+try:
+    unpacker.unpack()
+except EOFError:
+    print("EOFError")
+
+# unpack_into doesn't return anything until the whole object is there.
+unpacker = msgpack.Unpacker()
+samples = array.array("h", [0] * 4)
+data = b"\x94\x01\xd1\x80\x00\xff\xcd\x7f\xff"
+for i in range(len(data)):
+    unpacker.feed(data[i : i + 1])
+    n = unpacker.unpack_into(samples)
+    if n is not None:
+        print("unpack_into after", i + 1, n, list(samples))
+
+# The reserved byte 0xc1 is invalid. The data up to it is dropped, at the top level or inside a
+# container, and the objects after it are unpacked.
+for bad in (b"\xc1", b"\x93\x01\xc1", b"\x81\xa1k\xc1"):
+    unpacker = msgpack.Unpacker()
+    unpacker.feed(bad + b"\x02\xa1x")
+    try:
+        unpacker.unpack()
+    except ValueError as e:
+        print("ValueError", e)
+    print("after", bad, list(unpacker))
+
+unpacker = msgpack.Unpacker()
+unpacker.feed(b"\x92\xc1\x03\x04")
+try:
+    unpacker.unpack_into(samples)
+except ValueError as e:
+    print("unpack_into ValueError", e)
+print("after", list(unpacker))
+
+# An object that unpack_into can't store stays for unpack.
+unpacker = msgpack.Unpacker()
+unpacker.feed(b"\x95\x01\x02\x03\x04\x05\xa2hi")
+for target in (samples, bytearray(1)):
+    try:
+        unpacker.unpack_into(target)
+    except ValueError as e:
+        print("ValueError", e)
+print("left", list(unpacker))
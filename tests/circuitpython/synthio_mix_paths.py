@@ -0,0 +1,58 @@
+import audiocore
+import synthio
+
+# Voices without ring modulation or a filter are mixed in pairs straight into the output, the rest
+# through a temporary buffer one at a time. A filter that passes samples through unchanged must
+# give the same output as no filter.
+envelope = synthio.Envelope(attack_time=0, decay_time=0, release_time=0, sustain_level=1)
+passthrough = synthio.Biquad(b0=1, b1=0, b2=0, a1=0, a2=0)
+
+
+def render(channel_count, filters, count=5, amplitude=1):
+    synth = synthio.Synthesizer(sample_rate=8000, channel_count=channel_count, envelope=envelope)
+    notes = []
+    for i, filter in enumerate(filters):
+        notes.append(
+            synthio.Note(
+                frequency=110 * (i + 2) + 7 * i,
+                panning=(i - 2) / 3,
+                amplitude=amplitude * (1 - i / 8),
+                filter=filter,
+            )
+        )
+    synth.press(notes)
+    samples = []
+    for _ in range(count):
+        samples.extend(audiocore.get_buffer(synth)[1])
+    return samples
+
+
+for channel_count in (1, 2):
+    for voices in (1, 2, 3, 5):
+        plain = render(channel_count, [None] * voices)
+        filtered = render(channel_count, [passthrough] * voices)
+        mixed = render(channel_count, [passthrough, None] * (voices // 2) + [None] * (voices % 2))
+        print(
+            "channels",
+            channel_count,
+            "voices",
+            voices,
+            plain == filtered,
+            plain == mixed,
+            max(plain) > 0,
+        )
+
+# A filter with gain makes samples bigger than 16 bits. Doubling the gain doubles the output, as
+# long as the mix stays below where it is softly clipped.
+for channel_count in (1, 2):
+    single = render(channel_count, [passthrough], count=1, amplitude=0.5)
+    double = render(
+        channel_count, [synthio.Biquad(b0=2, b1=0, b2=0, a1=0, a2=0)], count=1, amplitude=0.5
+    )
+    print(
+        "channels",
+        channel_count,
+        "gain 2 is twice gain 1",
+        all(abs(d - 2 * s) <= 1 for s, d in zip(single, double)),
+        max(double) > 4096,
+    )
@@ -0,0 +1,88 @@
+try:
+    import zlib
+
+    zlib.decompressobj
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+DATA = b"".join(b"line %d\n" % (i * i % 97) for i in range(400))
+
+# Produced by CPython's zlib.compress(DATA, 9)
+PACKED = b"x\xda\xed\x92;\x0e\x021\x0c\x05{N\xc1\x11H\xb2\xf9\xec\x81(\x90V\xdc\xbfD(3HIG\xef\xca\x8a\xe3\xcf\xb3=\xd7\xeb\xfd\xbc?n\xd7\xd7\xa4i\x8eiN\x9cm\xda\\\xa7-\xbc\x0f\xfe\x1b\xe1\x83\xecB8\xee\xa3O\xdb3~\xa2\x88n\xbcO\xab\x93\xde\x95\xc4\x7f\xc5\x7f\xda]\x91j\xf6\x1f\x7f%\x7f\xd0\x86\xf2\x195\x03\x7f%<\xd3f8\x94\xc3\x90\x97x\x0f\xda7eP\xa7\x90\x9f\xec\x87\x1aT\r\xcat\xcaw\xdfe\xb3[\x9cy\xd6ik\x17\xbb\xaaBU\xaaL\xdb\x14N\xe5\x94N\xed\x16\xdc\x8a[rkc\xdd\xa9;\xfe\xed<m7i\xeb\xcd\xbc\xa17\xf5\xc6\xde\xbcmL\xe4\x95\x18\t\x92\xa8\xb2\xf2&\x7f\xf2X6^\xe5\xf7\\\xe0&9\xc0\x0f\xf0\x03\xfc\x00?\xc0\x0f\xf0\x03\xfc\x00?\xc0\xff\x13\xfc\x0f\x12\xaco\x8c"
+RAW = PACKED[2:-4]
+GZIP = b"\x1f\x8b\x08\x00\x00\x00\x00\x00\x02\x03" + RAW + b"IZ>z?\x0c\x00\x00"
+
+
+def feed(d, packed, step):
+    out = b""
+    for i in range(0, len(packed), step):
+        out += d.decompress(packed[i : i + step])
+    return out
+
+
+# one shot, with and without size hints
+print(zlib.decompress(PACKED) == DATA)
+print(zlib.decompress(PACKED, 15, 10) == DATA)
+print(zlib.decompress(PACKED, 15, len(DATA)) == DATA)
+print(zlib.decompress(GZIP, 31) == DATA)
+print(zlib.decompress(RAW, -15) == DATA)
+
+# streamed in pieces of various sizes
+for wbits, packed in ((15, PACKED), (0, PACKED), (31, GZIP), (-15, RAW)):
+    for step in (1, 7, 64, len(packed)):
+        d = zlib.decompressobj(wbits)
+        out = feed(d, packed, step)
+        print(wbits, step, out == DATA, d.eof)
+
+# nothing is output until the data is complete enough
+d = zlib.decompressobj()
+print(d.decompress(PACKED[:1]), d.eof)
+print(d.decompress(PACKED[1:]) == DATA, d.eof)
+
+# data after the end of the stream
+d = zlib.decompressobj()
+print(feed(d, PACKED + b"extra", 3) == DATA, d.eof, d.unused_data)
+
+# output limited by max_length
+d = zlib.decompressobj()
+out = d.decompress(PACKED, 1000)
+print(len(out), len(d.unconsumed_tail) > 0)
+while d.unconsumed_tail:
+    out += d.decompress(d.unconsumed_tail, 1000)
+print(out == DATA, d.eof)
+d = zlib.decompressobj()
+out = d.decompress(PACKED, 100)
+out += d.flush()
+print(out == DATA, d.eof)
+
+# into a buffer smaller than the output
+d = zlib.decompressobj(31)
+buf = bytearray(100)
+out = b""
+pos = 0
+while not d.eof:
+    data = d.unconsumed_tail
+    if not data:
+        data = GZIP[pos : pos + 50]
+        pos += 50
+    n = d.decompress_into(buf, data)
+    out += buf[:n]
+print(out == DATA)
+
+# stored blocks
+block = DATA[:300]
+stored = b"\x01" + bytes((len(block) & 0xFF, len(block) >> 8, ~len(block) & 0xFF, (~len(block) >> 8) & 0xFF)) + block
+d = zlib.decompressobj(-15)
+print(feed(d, stored, 13) == block, d.eof)
+
+# corrupt data
+d = zlib.decompressobj()
+try:
+    d.decompress(PACKED[:-1] + b"\x00")
+except ValueError:
+    print("ValueError")
+try:
+    zlib.decompressobj(20)
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,24 @@
+# test arithmetic and comparisons mixing floats and small ints
+
+for a, b in ((1.5, 2), (3, 1.5), (-3, 0.25), (0.75, 0.5), (7, 7.0), (float("nan"), 1)):
+    print(a + b, a - b, a * b, a / b)
+    print(a < b, a > b, a <= b, a >= b, a == b, a != b)
+
+x = 10
+x += 0.5
+x -= 1
+x *= 2
+x /= 4
+print(x)
+
+for a, b in ((1.0, 0), (1, 0.0), (0.0, 0.0)):
+    try:
+        a / b
+    except ZeroDivisionError:
+        print("ZeroDivisionError")
+
+# results that leave the small int range
+big = 1 << 40
+for i in range(2):
+    big = big + big
+    print(big, big - (1 << 62), -big - big)
@@ -0,0 +1,28 @@
+# test that a call site that caches module attributes still falls back to
+# the module's __getattr__ for names that aren't in it
+
+this = __import__(__name__)
+
+
+def __getattr__(attr):
+    return "__getattr__ " + attr
+
+
+# do feature test (will also test functionality if the feature exists)
+if not hasattr(this, "does_not_exist"):
+    print("SKIP")
+    raise SystemExit
+
+
+def get_late(m):
+    return m.late
+
+
+print(get_late(this))
+late = "global"
+print(get_late(this))
+print(get_late(this))
+del late
+print(get_late(this))
+late = "again"
+print(get_late(this))
@@ -9,3 +9,12 @@ def run(f):
     f(ITERS)
     t = time.time() - t
     print(t)
+
+
+# Runs f like run does, but prints how many units of work were done per
+# second instead of how long it took, so bigger is faster.
+def run_rate(f, units):
+    t = time.time()
+    f(ITERS)
+    t = time.time() - t
+    print(units / t)
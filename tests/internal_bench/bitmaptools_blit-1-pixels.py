@@ -0,0 +1,14 @@
+import bench
+import displayio
+
+
+def test(num):
+    source = displayio.Bitmap(160, 120, 16)
+    bitmap = displayio.Bitmap(160, 120, 16)
+    for i in range(num // 200000):
+        for y in range(120):
+            for x in range(160):
+                bitmap[x, y] = source[x, y]
+
+
+bench.run(test)
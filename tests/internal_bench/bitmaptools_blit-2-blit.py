@@ -0,0 +1,13 @@
+import bench
+import bitmaptools
+import displayio
+
+
+def test(num):
+    source = displayio.Bitmap(160, 120, 16)
+    bitmap = displayio.Bitmap(160, 120, 16)
+    for i in range(num // 200000):
+        bitmaptools.blit(bitmap, source, 0, 0)
+
+
+bench.run(test)
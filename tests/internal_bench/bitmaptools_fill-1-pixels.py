@@ -0,0 +1,13 @@
+import bench
+import displayio
+
+
+def test(num):
+    bitmap = displayio.Bitmap(160, 120, 16)
+    for i in range(num // 200000):
+        for y in range(120):
+            for x in range(160):
+                bitmap[x, y] = i & 0xF
+
+
+bench.run(test)
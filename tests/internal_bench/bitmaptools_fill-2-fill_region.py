@@ -0,0 +1,12 @@
+import bench
+import bitmaptools
+import displayio
+
+
+def test(num):
+    bitmap = displayio.Bitmap(160, 120, 16)
+    for i in range(num // 200000):
+        bitmaptools.fill_region(bitmap, 0, 0, 160, 120, i & 0xF)
+
+
+bench.run(test)
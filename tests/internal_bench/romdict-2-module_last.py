@@ -0,0 +1,17 @@
+import bench
+import math
+
+# Attribute lookup on a large ROM module by name, bypassing per-call-site
+# caching. The first and last entries cost the same with a sorted index; a
+# linear search makes the last one the slowest.
+NAME = dir(math)[-1]
+
+
+def test(num):
+    i = 0
+    while i < num:
+        getattr(math, NAME)
+        i += 2
+
+
+bench.run(test)
@@ -0,0 +1,15 @@
+import bench
+import math
+
+NAMES = tuple(dir(math))
+
+
+def test(num):
+    i = 0
+    while i < num:
+        for n in NAMES:
+            getattr(math, n)
+        i += 2 * len(NAMES)
+
+
+bench.run(test)
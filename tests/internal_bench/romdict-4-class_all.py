@@ -0,0 +1,14 @@
+import bench
+
+NAMES = tuple(n for n in dir(str) if not n.startswith("__"))
+
+
+def test(num):
+    i = 0
+    while i < num:
+        for n in NAMES:
+            getattr(str, n)
+        i += 2 * len(NAMES)
+
+
+bench.run(test)
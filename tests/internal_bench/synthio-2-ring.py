@@ -0,0 +1,26 @@
+# Renders 12 voices of 48kHz stereo audio, 256 frames per buffer. Prints how
+# many voices could play at once for each percent of CPU time they take.
+import array
+import audiocore
+import bench
+import synthio
+
+VOICES = 12
+BUFFERS = bench.ITERS // 10000
+AUDIO_SECONDS = BUFFERS * 256 / 48000
+
+waveform = array.array("h", [i * 2048 - 32768 for i in range(32)])
+
+
+def test(num):
+    synth = synthio.Synthesizer(sample_rate=48000, channel_count=2, waveform=waveform)
+    notes = [
+        synthio.Note(frequency=110 * (i + 1), panning=i / 6 - 1, ring_frequency=330, ring_waveform=waveform)
+        for i in range(VOICES)
+    ]
+    synth.press(notes)
+    for i in range(num // 10000):
+        audiocore.get_buffer(synth)
+
+
+bench.run_rate(test, VOICES * AUDIO_SECONDS / 100)
@@ -0,0 +1,12 @@
+import bench
+
+
+def test(num):
+    l = [0]
+    i = 0
+    while i < num:
+        l.count(i)
+        i += 2
+
+
+bench.run(test)
@@ -0,0 +1,10 @@
+import bench
+
+
+def test(num):
+    i = 0
+    while i < bench.ITERS:
+        i += 1
+
+
+bench.run(test)
@@ -0,0 +1,46 @@
+# test that objects allocated while the heap is swept a slice at a time survive
+
+import gc
+
+try:
+    gc.stats()["sweep_slices"]
+except (AttributeError, KeyError):
+    print("SKIP")
+    raise SystemExit
+
+# Leave plenty of garbage behind so the sweep takes a few slices.
+garbage = [[i] * 8 for i in range(500)]
+garbage = None
+gc.collect()
+before = gc.stats()
+
+# Allocate while the sweep is still going, on both sides of it.
+keep = []
+for i in range(1000):
+    keep.append((i, [i, i + 1], str(i)))
+
+ok = True
+for i, v in enumerate(keep):
+    ok = ok and v[0] == i and v[1] == [i, i + 1] and v[2] == str(i)
+print(ok)
+
+# Growing and freeing lists while sweeping.
+lst = []
+for i in range(3000):
+    lst.append(i)
+    if i % 100 == 0:
+        gc.collect()
+print(len(lst), sum(lst))
+
+after = gc.stats()
+print(after["sweep_slices"] > before["sweep_slices"])
+print(after["sweep_budget"] > 0)
+print(after["max_slice_us"] >= 0)
+
+# mem_free() finishes the sweep, so it sees all the garbage freed.
+garbage = [[i] * 8 for i in range(500)]
+garbage = None
+gc.collect()
+free1 = gc.mem_free()
+gc.collect()
+print(abs(gc.mem_free() - free1) < 1024)
@@ -0,0 +1,52 @@
+# test that objects survive minor collections of the GC nursery
+
+import gc
+
+try:
+    gc.stats()["minor_collections"]
+except (AttributeError, KeyError):
+    print("SKIP")
+    raise SystemExit
+
+gc.collect()
+before = gc.stats()
+
+# A list too big for the nursery, filled with small objects that are made in
+# the nursery, so the only references to them come from outside it.
+keep = [None] * 100
+for i in range(len(keep)):
+    keep[i] = (i, str(i))
+
+# Lots of short-lived small objects.
+total = 0
+for i in range(20000):
+    t = (i, i + 1)
+    total += t[1] - t[0]
+    if i % 400 == 0:
+        keep[i // 400] = [i, {"n": i}]
+print(total)
+
+ok = True
+for i, v in enumerate(keep):
+    if i < 50:
+        ok = ok and v[0] == i * 400 and v[1]["n"] == i * 400
+    else:
+        ok = ok and v == (i, str(i))
+print(ok)
+
+# A chain of small objects that only lives in the nursery.
+head = None
+for i in range(1000):
+    head = (i, head)
+    [i] * 3
+n = 0
+while head is not None:
+    n += 1
+    head = head[1]
+print(n)
+
+after = gc.stats()
+print(after["collections"] > before["collections"])
+print(after["minor_collections"] > before["minor_collections"])
+print(sum(after["pause_histogram"]) == after["collections"])
+print(after["max_pause_us"] >= before["max_pause_us"])
@@ -0,0 +1,33 @@
+# This tests qstr_find_strn() speed when the string being searched for is not
+# found and many qstrs have been interned at runtime.
+
+
+class Names:
+    pass
+
+
+def intern(n):
+    obj = Names()
+    for i in range(n):
+        setattr(obj, "runtime_qstr_%d" % i, None)
+
+
+def test(r):
+    for _ in r:
+        str("a string that shouldn't be interned")
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (400, 100),
+    (1000, 10): (4000, 1000),
+    (5000, 10): (40000, 2000),
+}
+
+
+def bm_setup(params):
+    nloop, nqstr = params
+    intern(nqstr)
+    return lambda: test(range(nloop)), lambda: (nloop // 100, None)
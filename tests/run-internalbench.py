@@ -49,7 +49,7 @@ def run_tests(pyb, test_dict):
         for t in tests:
             if baseline is None:
                 baseline = t[1]
-            print("    %.3fs (%+06.2f%%) %s" % (t[1], (t[1] * 100 / baseline) - 100, t[0]))
+            print("    %.3f (%+06.2f%%) %s" % (t[1], (t[1] * 100 / baseline) - 100, t[0]))
 
     print("{} tests performed ({} individual testcases)".format(test_count, testcase_count))
 
@@ -135,6 +135,12 @@ def main():
     cmd_parser.add_argument(
         "-f", "--mpy-cross-flags", default="", help="flags to pass to mpy-cross"
     )
+    # CIRCUITPY-CHANGE: compile frozen modules to native code ahead of time
+    cmd_parser.add_argument(
+        "--native-arch",
+        default="",
+        help="compile frozen .py files to native code for this architecture where possible",
+    )
     cmd_parser.add_argument("-v", "--var", action="append", help="variables to substitute")
     cmd_parser.add_argument("--mpy-tool-flags", default="", help="flags to pass to mpy-tool")
     cmd_parser.add_argument("files", nargs="+", help="input manifest list")
@@ -173,6 +179,18 @@ def main():
             print('freeze error executing "{}": {}'.format(input_manifest, er.args[0]))
             sys.exit(1)
 
+    # CIRCUITPY-CHANGE: .mpy files compiled with other options are out of date
+    # however new they are, so the options are kept beside them.
+    options_file = "{}/frozen_mpy.options".format(args.build_dir)
+    options = "native-arch={}\nmpy-cross-flags={}\n".format(
+        args.native_arch, args.mpy_cross_flags
+    )
+    try:
+        with open(options_file) as f:
+            options_changed = f.read() != options
+    except OSError:
+        options_changed = True
+
     # Process the manifest
     str_paths = []
     mpy_files = []
@@ -189,24 +207,42 @@ def main():
         elif result.kind == manifestfile.KIND_FREEZE_AS_MPY:
             outfile = "{}/frozen_mpy/{}.mpy".format(args.build_dir, result.target_path[:-3])
             ts_outfile = get_timestamp(outfile, 0)
-            if result.timestamp >= ts_outfile:
+            if options_changed or result.timestamp >= ts_outfile:
                 print("MPY", result.target_path)
                 mkdir(outfile)
                 # Add __version__ to the end of the file before compiling.
                 with manifestfile.tagged_py_file(result.full_path, result.metadata) as tagged_path:
-                    try:
-                        mpy_cross.compile(
-                            tagged_path,
-                            dest=outfile,
-                            src_path=result.target_path,
-                            opt=result.opt,
-                            mpy_cross=MPY_CROSS,
-                            extra_args=args.mpy_cross_flags.split(),
-                        )
-                    except mpy_cross.CrossCompileError as ex:
-                        print("error compiling {}:".format(result.target_path))
-                        print(ex.args[0])
-                        raise SystemExit(1)
+                    # CIRCUITPY-CHANGE: try the native emitter first and fall back to
+                    # bytecode for modules that use something it can't compile.
+                    compiled = False
+                    if args.native_arch:
+                        try:
+                            mpy_cross.compile(
+                                tagged_path,
+                                dest=outfile,
+                                src_path=result.target_path,
+                                opt=result.opt,
+                                march=args.native_arch,
+                                mpy_cross=MPY_CROSS,
+                                extra_args=args.mpy_cross_flags.split() + ["-X", "emit=native"],
+                            )
+                            compiled = True
+                        except mpy_cross.CrossCompileError:
+                            print("MPY", result.target_path, "(bytecode)")
+                    if not compiled:
+                        try:
+                            mpy_cross.compile(
+                                tagged_path,
+                                dest=outfile,
+                                src_path=result.target_path,
+                                opt=result.opt,
+                                mpy_cross=MPY_CROSS,
+                                extra_args=args.mpy_cross_flags.split(),
+                            )
+                        except mpy_cross.CrossCompileError as ex:
+                            print("error compiling {}:".format(result.target_path))
+                            print(ex.args[0])
+                            raise SystemExit(1)
                 ts_outfile = get_timestamp(outfile)
             mpy_files.append(outfile)
         else:
@@ -215,6 +251,11 @@ def main():
             ts_outfile = result.timestamp
         ts_newest = max(ts_newest, ts_outfile)
 
+    if options_changed:
+        mkdir(options_file)
+        with open(options_file, "w") as f:
+            f.write(options)
+
     # Check if output file needs generating
     if ts_newest < get_timestamp(args.output, 0):
         # No files are newer than output file so it does not need updating